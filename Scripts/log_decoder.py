@@ -0,0 +1,361 @@
+#!/usr/bin/env python3
+"""Decode binary log records (Logger::Format::BINARY) back into text.
+
+Format strings and tags that live in flash are sent as addresses and are
+resolved from the firmware ELF; everything else is carried inline. Bytes
+that are not part of a valid record (e.g. printf output on the same UART)
+are passed through unchanged.
+
+Structured data records are shown as well: task telemetry snapshots are
+printed as a table, scheduler trace dumps are summarised (convert them
+with trace_to_chrome.py).
+
+Record layout: see Source/Adapter/Logger/LogBinary.h.
+
+Usage:
+    log_decoder.py firmware.elf capture.bin
+    log_decoder.py firmware.elf /dev/ttyUSB0 --baud 921600
+    cat capture.bin | log_decoder.py firmware.elf -
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SYNC = 0xA5
+LEVEL_MASK = 0x07
+FLAG_DATA = 0x08
+FLAG_TRUNCATED = 0x10
+FLAG_BLOB = 0x20
+FLAG_FMT_INLINE = 0x40
+FLAG_TAG_INLINE = 0x80
+
+# structured data record types (LogDataType in LogBinary.h)
+DATA_TELEMETRY = 0x01
+DATA_TELEMETRY_TASK = 0x02
+DATA_TRACE_BEGIN = 0x10
+DATA_TRACE_END = 0x13
+
+TASK_STATES = ["Running", "Ready", "Blocked", "Suspended", "Deleted", "Invalid"]
+ALARMS = ["STACK", "CPU", "HEAP", "OVERFLOW"]
+
+LEVELS = ["RAW", "TRACE", "DEBUG", "INFO", "WARN", "ERROR"]
+COLORS = ["\033[35m", "\033[90m", "\033[36m", "\033[32m", "\033[33m", "\033[31m"]
+COLOR_RESET = "\033[0m"
+
+CONVERSION = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<prec>\*|\d*))?"
+    r"(?P<length>hh|h|ll|l|z|j|t|L)?(?P<conv>[diuoxXcpfFeEgGaAsn%])"
+)
+
+
+class ElfStrings:
+    """Read NUL-terminated strings from the allocated sections of an ELF."""
+
+    SHF_ALLOC = 0x2
+    SHT_NOBITS = 8
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError("%s is not an ELF file" % path)
+
+        is64 = self.data[4] == 2
+        endian = "<" if self.data[5] == 1 else ">"
+        if is64:
+            shoff, = struct.unpack_from(endian + "Q", self.data, 0x28)
+            shentsize, shnum = struct.unpack_from(endian + "HH", self.data, 0x3A)
+            fmt = endian + "IIQQQQ"
+        else:
+            shoff, = struct.unpack_from(endian + "I", self.data, 0x20)
+            shentsize, shnum = struct.unpack_from(endian + "HH", self.data, 0x2E)
+            fmt = endian + "IIIIII"
+
+        self.sections = []
+        for i in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from(
+                fmt, self.data, shoff + i * shentsize)
+            if flags & self.SHF_ALLOC and sh_type != self.SHT_NOBITS and size:
+                self.sections.append((addr, size, offset))
+        self.cache = {}
+
+    def string(self, addr):
+        if addr in self.cache:
+            return self.cache[addr]
+        text = None
+        for base, size, offset in self.sections:
+            if base <= addr < base + size:
+                start = offset + addr - base
+                end = self.data.find(b"\0", start, offset + size)
+                if end < 0:
+                    end = offset + size
+                text = self.data[start:end].decode("utf-8", "replace")
+                break
+        if text is None:
+            text = "<0x%08x>" % addr
+        self.cache[addr] = text
+        return text
+
+
+class Reader:
+    def __init__(self, payload):
+        self.buf = payload
+        self.pos = 0
+
+    def remaining(self):
+        return len(self.buf) - self.pos
+
+    def byte(self):
+        if self.pos >= len(self.buf):
+            raise EOFError
+        b = self.buf[self.pos]
+        self.pos += 1
+        return b
+
+    def bytes(self, n):
+        if self.remaining() < n:
+            raise EOFError
+        b = self.buf[self.pos:self.pos + n]
+        self.pos += n
+        return b
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            b = self.byte()
+            value |= (b & 0x7F) << shift
+            if not b & 0x80:
+                return value
+            shift += 7
+
+    def zigzag(self):
+        v = self.varint()
+        return (v >> 1) ^ -(v & 1)
+
+    def u32(self):
+        return struct.unpack("<I", self.bytes(4))[0]
+
+    def double(self):
+        return struct.unpack("<d", self.bytes(8))[0]
+
+    def string(self):
+        return self.bytes(self.varint()).decode("utf-8", "replace")
+
+
+def crc8(data):
+    crc = 0
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def format_args(fmt, r):
+    """Expand a C format string, pulling arguments from the record."""
+    out = []
+    last = 0
+    for m in CONVERSION.finditer(fmt):
+        out.append(fmt[last:m.start()])
+        last = m.end()
+        conv = m.group("conv")
+        if conv == "%":
+            out.append("%")
+            continue
+        try:
+            flags = m.group("flags")
+            width = m.group("width") or ""
+            prec = m.group("prec")
+            if width == "*":
+                width = str(r.zigzag())
+            if prec == "*":
+                prec = str(r.zigzag())
+            spec = "%" + flags + width + ("." + prec if prec is not None else "")
+
+            if conv in "di":
+                out.append((spec + "d") % r.zigzag())
+            elif conv == "u":
+                out.append((spec + "d") % r.varint())
+            elif conv in "oxX":
+                out.append((spec + conv) % r.varint())
+            elif conv == "c":
+                out.append((spec + "c") % (r.varint() & 0xFF))
+            elif conv == "p":
+                out.append("0x%x" % r.varint())
+            elif conv in "fFeEgG":
+                out.append((spec + conv) % r.double())
+            elif conv in "aA":
+                v = r.double().hex()
+                out.append(v.upper() if conv == "A" else v)
+            elif conv == "s":
+                out.append((spec + "s") % r.string())
+            elif conv == "n":
+                pass
+        except EOFError:
+            out.append("<?>")
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+class Decoder:
+    def __init__(self, elf, color=False):
+        self.elf = elf
+        self.color = color
+        self.pending = bytearray()
+        self.text = bytearray()
+        self.task_names = {}
+
+    def feed(self, data, eof=False):
+        """Consume raw bytes, return decoded lines."""
+        self.pending += data
+        lines = []
+        buf = self.pending
+        i = 0
+        while i < len(buf):
+            if buf[i] != SYNC:
+                self.text.append(buf[i])
+                i += 1
+                continue
+            length = buf[i + 1] if i + 1 < len(buf) else 0
+            if i + 3 + length > len(buf):
+                if not eof:
+                    break
+                # stream ended inside a frame: the sync byte was just data
+                self.text.append(buf[i])
+                i += 1
+                continue
+            frame = bytes(buf[i + 1:i + 2 + length])
+            if crc8(frame) != buf[i + 2 + length]:
+                self.text.append(buf[i])
+                i += 1
+                continue
+            self.flush_text(lines)
+            line = self.decode_record(frame[1:])
+            if line is not None:
+                lines.append(line)
+            i += 3 + length
+        del buf[:i]
+        self.flush_text(lines, complete_only=not eof)
+        return lines
+
+    def flush_text(self, lines, complete_only=False):
+        while self.text:
+            nl = self.text.find(b"\n")
+            if nl < 0:
+                if complete_only:
+                    return
+                nl = len(self.text) - 1
+            line = self.text[:nl + 1].decode("utf-8", "replace").rstrip("\r\n")
+            del self.text[:nl + 1]
+            if line:
+                lines.append(line)
+
+    def decode_data(self, kind, data):
+        """Format a structured data record; None for records not shown."""
+        if kind == DATA_TELEMETRY_TASK and len(data) >= 2:
+            number, = struct.unpack_from("<H", data)
+            self.task_names[number] = data[2:].decode("utf-8", "replace")
+            return None
+        if kind == DATA_TELEMETRY and len(data) >= 16:
+            interval, heap, heap_min, load, alarms, count = struct.unpack_from(
+                "<IIIHBB", data)
+            active = [n for i, n in enumerate(ALARMS) if alarms & (1 << i)]
+            out = ["telemetry %d ms: load %d.%02d%%, heap %d free / %d min%s" % (
+                interval // 1000, load // 100, load % 100, heap, heap_min,
+                ", ALARM " + ",".join(active) if active else "")]
+            for i in range(count):
+                if 16 + (i + 1) * 8 > len(data):
+                    break
+                number, prio, state, cpu, stack = struct.unpack_from(
+                    "<HBBHH", data, 16 + i * 8)
+                name = self.task_names.get(number, "#%d" % number)
+                state = TASK_STATES[state] if state < len(TASK_STATES) else state
+                out.append("    %-16s %3d.%02d%%  stack %5d  prio %2d  %s" % (
+                    name, cpu // 100, cpu % 100, stack, prio, state))
+            return "\n".join(out)
+        if kind == DATA_TRACE_BEGIN and len(data) >= 14:
+            _, _, clock, count, lost = struct.unpack_from("<BBIII", data)
+            return "trace dump: %d events at %d Hz, %d lost" % (count, clock, lost)
+        if kind == DATA_TRACE_END:
+            return "trace dump end (convert with trace_to_chrome.py)"
+        if kind >= DATA_TRACE_BEGIN:
+            return None
+        return "data type 0x%02x: %s" % (kind, data.hex())
+
+    def ref(self, r, inline):
+        return r.string() if inline else self.elf.string(r.u32())
+
+    def decode_record(self, payload):
+        r = Reader(payload)
+        try:
+            flags = r.byte()
+            level = flags & LEVEL_MASK
+            if flags & FLAG_DATA:
+                kind = r.byte()
+                ts = r.varint()
+                tag = "Trace" if kind >= DATA_TRACE_BEGIN else "Telemetry"
+                msg = self.decode_data(kind, r.bytes(r.remaining()))
+                if msg is None:
+                    return None
+            elif flags & FLAG_BLOB:
+                tag = ""
+                ts = r.varint()
+                blob = r.bytes(r.varint())
+                msg = " ".join("%02X" % b for b in blob)
+            else:
+                tag = self.ref(r, flags & FLAG_TAG_INLINE)
+                ts = r.varint()
+                fmt = self.ref(r, flags & FLAG_FMT_INLINE)
+                msg = format_args(fmt, r)
+            if flags & FLAG_TRUNCATED:
+                msg += " <truncated>"
+        except EOFError:
+            return "<malformed record: %s>" % payload.hex()
+
+        name = LEVELS[level] if level < len(LEVELS) else str(level)
+        line = "[%d.%03d] [%s] [%s] %s" % (
+            ts // 1000000, (ts % 1000000) // 1000, name, tag, msg)
+        if self.color and level < len(COLORS):
+            line = COLORS[level] + line + COLOR_RESET
+        return line
+
+
+def open_input(path, baud):
+    if path == "-":
+        return sys.stdin.buffer
+    if baud:
+        import serial  # pyserial, only needed for live capture
+        return serial.Serial(path, baud, timeout=0.1)
+    return open(path, "rb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("elf", help="firmware ELF the log was produced by")
+    parser.add_argument("input", help="capture file, serial device, or - for stdin")
+    parser.add_argument("--baud", type=int, help="open input as a serial port")
+    parser.add_argument("--color", action="store_true", help="ANSI colors per level")
+    args = parser.parse_args()
+
+    decoder = Decoder(ElfStrings(args.elf), args.color)
+    stream = open_input(args.input, args.baud)
+    try:
+        while True:
+            data = stream.read(4096) if args.baud is None else stream.read(256)
+            if not data:
+                if args.baud is None:
+                    break
+                continue
+            for line in decoder.feed(data):
+                print(line, flush=True)
+    except KeyboardInterrupt:
+        pass
+    for line in decoder.feed(b"", eof=True):
+        print(line)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,297 @@
+#!/usr/bin/env python3
+"""Convert a scheduler trace dump (Trace::dump) to Chrome trace JSON.
+
+The dump travels as structured data records in the log stream, so the
+input is a raw capture of the log UART or UDP port; text lines and other
+records around it are ignored. Open the output in https://ui.perfetto.dev
+or chrome://tracing.
+
+Each task gets a track with its run slices; the "CPU" track shows which
+task (or interrupt) owned the core. Slices carry the ready-to-run
+latency of the task (time from becoming ready to being switched in), and
+a per-task latency summary is printed to stderr.
+
+Event layout: see Source/Adapter/Trace/Trace.h.
+
+Usage:
+    trace_to_chrome.py capture.bin -o trace.json
+    nc -ul 514 > capture.bin    # or: cat /dev/ttyUSB0 > capture.bin
+"""
+
+import argparse
+import json
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from log_decoder import FLAG_DATA, SYNC, Reader, crc8  # noqa: E402
+
+DATA_TRACE_BEGIN = 0x10
+DATA_TRACE_TASK = 0x11
+DATA_TRACE_EVENTS = 0x12
+DATA_TRACE_END = 0x13
+
+EVT_SWITCHED_IN = 1
+EVT_SWITCHED_OUT = 2
+EVT_READY = 3
+EVT_CREATE = 4
+EVT_DELETE = 5
+EVT_QUEUE_SEND = 6
+EVT_QUEUE_RECEIVE = 7
+EVT_QUEUE_BLOCK = 8
+EVT_ISR_ENTER = 9
+EVT_ISR_EXIT = 10
+EVT_MARK = 11
+
+QUEUE_EVENTS = {
+    EVT_QUEUE_SEND: "send",
+    EVT_QUEUE_RECEIVE: "receive",
+    EVT_QUEUE_BLOCK: "block",
+}
+QUEUE_KINDS = ["queue", "mutex", "counting semaphore", "binary semaphore",
+               "recursive mutex", "queue set"]
+
+PID = 1
+CPU_TID = 0
+ISR_TID_BASE = 10000
+
+
+def data_records(buf):
+    """Yield (type, data) for every valid structured data record."""
+    i = 0
+    while i + 3 <= len(buf):
+        if buf[i] != SYNC:
+            i += 1
+            continue
+        length = buf[i + 1]
+        end = i + 3 + length
+        if end > len(buf) or crc8(buf[i + 1:i + 2 + length]) != buf[end - 1]:
+            i += 1
+            continue
+        payload = buf[i + 2:end - 1]
+        i = end
+        if not payload or not payload[0] & FLAG_DATA:
+            continue
+        r = Reader(payload)
+        try:
+            r.byte()
+            kind = r.byte()
+            r.varint()  # record timestamp, not used
+        except EOFError:
+            continue
+        yield kind, bytes(payload[r.pos:])
+
+
+class Dump:
+    def __init__(self, header):
+        _, self.event_size, self.clock, self.count, self.lost = \
+            struct.unpack_from("<BBIII", header)
+        self.names = {}
+        self.events = {}
+        self.complete = False
+
+    def ordered(self):
+        return [self.events[i] for i in sorted(self.events)]
+
+
+def read_dumps(buf):
+    dumps = []
+    dump = None
+    for kind, data in data_records(buf):
+        if kind == DATA_TRACE_BEGIN and len(data) >= 14:
+            dump = Dump(data)
+            dumps.append(dump)
+        elif dump is None:
+            continue
+        elif kind == DATA_TRACE_TASK and len(data) >= 2:
+            number, = struct.unpack_from("<H", data)
+            dump.names[number] = data[2:].decode("utf-8", "replace")
+        elif kind == DATA_TRACE_EVENTS and len(data) >= 4:
+            first, = struct.unpack_from("<I", data)
+            size = dump.event_size
+            for k in range((len(data) - 4) // size):
+                dump.events[first + k] = struct.unpack_from(
+                    "<IBBH", data, 4 + k * size)
+        elif kind == DATA_TRACE_END:
+            dump.complete = True
+            dump = None
+    return dumps
+
+
+def isr_name(number):
+    if number == 15:
+        return "SysTick"
+    if number >= 16:
+        return "IRQ %d" % (number - 16)
+    return "Exception %d" % number
+
+
+class Converter:
+    def __init__(self, dump):
+        self.dump = dump
+        self.out = []
+        self.tracks = {}
+        self.running = None      # (task, start)
+        self.ready = {}          # task -> time it became ready
+        self.isr_stack = []      # [(number, start)]
+        self.latency = {}        # task -> [us]
+
+    def task_name(self, task):
+        return self.dump.names.get(task, "task %d" % task)
+
+    def track(self, tid, name):
+        if tid not in self.tracks:
+            self.tracks[tid] = name
+            self.out.append({"ph": "M", "pid": PID, "tid": tid,
+                             "name": "thread_name", "args": {"name": name}})
+            self.out.append({"ph": "M", "pid": PID, "tid": tid,
+                             "name": "thread_sort_index",
+                             "args": {"sort_index": tid}})
+
+    def slice(self, tid, name, start, end, args=None):
+        event = {"ph": "X", "pid": PID, "tid": tid, "name": name,
+                 "ts": start, "dur": max(end - start, 0)}
+        if args:
+            event["args"] = args
+        self.out.append(event)
+
+    def instant(self, tid, name, ts, args=None, scope="t"):
+        event = {"ph": "i", "pid": PID, "tid": tid, "name": name, "ts": ts,
+                 "s": scope}
+        if args:
+            event["args"] = args
+        self.out.append(event)
+
+    def context_tid(self):
+        if self.isr_stack:
+            return ISR_TID_BASE + self.isr_stack[-1][0]
+        if self.running:
+            return self.running[0] + 1
+        return CPU_TID
+
+    def close_running(self, now):
+        task, start, args = self.running
+        name = self.task_name(task)
+        self.slice(task + 1, name, start, now, args)
+        self.slice(CPU_TID, name, start, now)
+        self.running = None
+
+    def convert(self):
+        events = self.dump.ordered()
+        if not events:
+            return []
+        self.out.append({"ph": "M", "pid": PID, "name": "process_name",
+                         "args": {"name": "FreeRTOS"}})
+        self.track(CPU_TID, "CPU")
+
+        scale = 1e6 / self.dump.clock
+        base = events[0][0]
+        ticks = 0
+        prev = base
+        now = 0.0
+        for raw, kind, info, ident in events:
+            # timestamps are 32-bit counters; unwrap assuming gaps < one period
+            ticks += (raw - prev) & 0xFFFFFFFF
+            prev = raw
+            now = ticks * scale
+            self.event(now, kind, info, ident)
+
+        if self.running:
+            self.close_running(now)
+        while self.isr_stack:
+            number, start = self.isr_stack.pop()
+            self.slice(ISR_TID_BASE + number, isr_name(number), start, now)
+        return self.out
+
+    def event(self, now, kind, info, ident):
+        if kind == EVT_SWITCHED_IN:
+            if self.running:
+                self.close_running(now)
+            self.track(ident + 1, self.task_name(ident))
+            args = None
+            if ident in self.ready:
+                latency = now - self.ready.pop(ident)
+                self.latency.setdefault(ident, []).append(latency)
+                args = {"ready_latency_us": round(latency, 3)}
+            self.running = (ident, now, args)
+        elif kind == EVT_SWITCHED_OUT:
+            if self.running and self.running[0] == ident:
+                self.close_running(now)
+        elif kind == EVT_READY:
+            # a running task that yields is re-readied; keep the first time
+            if not (self.running and self.running[0] == ident):
+                self.ready.setdefault(ident, now)
+        elif kind == EVT_CREATE:
+            self.track(ident + 1, self.task_name(ident))
+            self.instant(ident + 1, "create", now)
+        elif kind == EVT_DELETE:
+            self.instant(ident + 1, "delete", now)
+            self.ready.pop(ident, None)
+        elif kind in QUEUE_EVENTS:
+            kind_name = QUEUE_KINDS[info] if info < len(QUEUE_KINDS) else "queue"
+            addr = 0x20000000 | (ident << 2)
+            self.instant(self.context_tid(), "%s %s" % (
+                QUEUE_EVENTS[kind], kind_name), now,
+                {"object": "0x%08x" % addr})
+        elif kind == EVT_ISR_ENTER:
+            self.track(ISR_TID_BASE + ident, isr_name(ident))
+            self.isr_stack.append((ident, now))
+        elif kind == EVT_ISR_EXIT:
+            if self.isr_stack and self.isr_stack[-1][0] == ident:
+                number, start = self.isr_stack.pop()
+                self.slice(ISR_TID_BASE + number, isr_name(number), start, now)
+                self.slice(CPU_TID, isr_name(number), start, now)
+        elif kind == EVT_MARK:
+            self.instant(self.context_tid(), "mark %d" % ident, now,
+                         scope="g")
+
+    def summary(self):
+        lines = ["%-16s %8s %10s %10s" % ("task", "runs", "avg us", "max us")]
+        for task, values in sorted(self.latency.items()):
+            lines.append("%-16s %8d %10.1f %10.1f" % (
+                self.task_name(task), len(values),
+                sum(values) / len(values), max(values)))
+        return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("input", help="raw log capture, or - for stdin")
+    parser.add_argument("-o", "--output", default="-",
+                        help="JSON output file (default stdout)")
+    parser.add_argument("--index", type=int, default=-1,
+                        help="which dump to convert when the capture has "
+                             "several (default: last)")
+    args = parser.parse_args()
+
+    if args.input == "-":
+        buf = sys.stdin.buffer.read()
+    else:
+        with open(args.input, "rb") as f:
+            buf = f.read()
+
+    dumps = read_dumps(buf)
+    if not dumps:
+        sys.exit("no trace dump found in %s" % args.input)
+    dump = dumps[args.index]
+    if not dump.complete:
+        print("warning: dump is incomplete", file=sys.stderr)
+    if len(dump.events) < dump.count:
+        print("warning: %d of %d events missing" % (
+            dump.count - len(dump.events), dump.count), file=sys.stderr)
+
+    converter = Converter(dump)
+    trace = {"traceEvents": converter.convert(), "displayTimeUnit": "ns"}
+    if args.output == "-":
+        json.dump(trace, sys.stdout)
+    else:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+    print("%d events, %d lost before the dump window" % (
+        len(dump.events), dump.lost), file=sys.stderr)
+    print(converter.summary(), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,221 @@
+#ifndef BIT_MATRIX_64_H
+#define BIT_MATRIX_64_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Adapter {
+
+// 导通状态枚举
+enum class ContinuityState : uint8_t {
+    DISCONNECTED = 0,    // 断开
+    CONNECTED = 1        // 导通
+};
+
+/**
+ * @brief 按位压缩的定长导通矩阵
+ *
+ * 每个周期占用一个 uint64_t，最多 64 周期 x 64 引脚，共 512 字节，
+ * 全部静态分配，采集过程中不产生任何堆操作。
+ *
+ * 位布局：引脚 p 存放在该周期字的第 (63 - p) 位（MSB 对应引脚 0），
+ * 这样一行右移 (64 - cols) 位即为 getDataVector() 所需的大端位流片段。
+ */
+class BitMatrix64 {
+   public:
+    static constexpr uint8_t MAX_ROWS = 64;
+    static constexpr uint8_t MAX_COLS = 64;
+
+    // 单个周期（行）的只读视图，零拷贝
+    class RowView {
+       public:
+        RowView(uint64_t word, uint8_t cols) : word_(word), cols_(cols) {}
+
+        size_t size() const { return cols_; }
+        bool empty() const { return cols_ == 0; }
+        uint64_t word() const { return word_; }
+
+        ContinuityState operator[](size_t pin) const {
+            return ((word_ >> (63 - pin)) & 1ULL) ? ContinuityState::CONNECTED
+                                                  : ContinuityState::DISCONNECTED;
+        }
+
+       private:
+        uint64_t word_;
+        uint8_t cols_;
+    };
+
+    // 单个引脚（列）跨所有周期的只读视图，零拷贝
+    class ColumnView {
+       public:
+        ColumnView(const BitMatrix64* matrix, uint8_t pin, uint8_t rows)
+            : matrix_(matrix), pin_(pin), rows_(rows) {}
+
+        size_t size() const { return rows_; }
+        bool empty() const { return rows_ == 0; }
+
+        ContinuityState operator[](size_t cycle) const {
+            return matrix_->get(static_cast<uint8_t>(cycle), pin_);
+        }
+
+       private:
+        const BitMatrix64* matrix_;
+        uint8_t pin_;
+        uint8_t rows_;
+    };
+
+    BitMatrix64() { reset(0, 0); }
+
+    // 重新设置矩阵尺寸并清零
+    void reset(uint8_t rows, uint8_t cols) {
+        rows_ = rows > MAX_ROWS ? MAX_ROWS : rows;
+        cols_ = cols > MAX_COLS ? MAX_COLS : cols;
+        colMask_ = cols_ == 0 ? 0 : (~0ULL << (64 - cols_));
+        clear();
+    }
+
+    // 清零数据，保留尺寸
+    void clear() { data_.fill(0); }
+
+    uint8_t rows() const { return rows_; }
+    uint8_t cols() const { return cols_; }
+    size_t size() const { return rows_; }
+    bool empty() const { return rows_ == 0; }
+
+    // 引脚 p 在行字中的位掩码
+    static constexpr uint64_t pinMask(uint8_t pin) {
+        return 1ULL << (63 - pin);
+    }
+
+    ContinuityState get(uint8_t cycle, uint8_t pin) const {
+        if (cycle >= rows_ || pin >= cols_) {
+            return ContinuityState::DISCONNECTED;
+        }
+        return (data_[cycle] & pinMask(pin)) ? ContinuityState::CONNECTED
+                                             : ContinuityState::DISCONNECTED;
+    }
+
+    void set(uint8_t cycle, uint8_t pin, ContinuityState state) {
+        if (cycle >= rows_ || pin >= cols_) return;
+        if (state == ContinuityState::CONNECTED) {
+            data_[cycle] |= pinMask(pin);
+        } else {
+            data_[cycle] &= ~pinMask(pin);
+        }
+    }
+
+    // 整行写入，超出列数的位会被屏蔽
+    void setRow(uint8_t cycle, uint64_t word) {
+        if (cycle < rows_) data_[cycle] = word & colMask_;
+    }
+
+    uint64_t rowWord(uint8_t cycle) const {
+        return cycle < rows_ ? data_[cycle] : 0;
+    }
+
+    RowView row(uint8_t cycle) const {
+        return cycle < rows_ ? RowView(data_[cycle], cols_) : RowView(0, 0);
+    }
+
+    ColumnView column(uint8_t pin) const {
+        return pin < cols_ ? ColumnView(this, pin, rows_)
+                           : ColumnView(this, pin, 0);
+    }
+
+    // 压缩后的字节数
+    size_t packedSize() const {
+        return (static_cast<size_t>(rows_) * cols_ + 7) / 8;
+    }
+
+    /**
+     * @brief 以大端位流形式写出矩阵（周期优先，引脚 0 在最高位）
+     *
+     * 使用 64 位累加器按字移位拼接，不逐位循环。
+     * @return 实际写入的字节数，out 空间不足时返回 0
+     */
+    size_t pack(uint8_t* out, size_t capacity) const {
+        size_t total = packedSize();
+        if (out == nullptr || capacity < total) return 0;
+
+        size_t pos = 0;
+        uint64_t acc = 0;         // 待输出的位，MSB 对齐
+        uint32_t accBits = 0;     // acc 中有效位数（< 8）
+
+        for (uint8_t r = 0; r < rows_; r++) {
+            uint64_t w = data_[r] & colMask_;
+            acc |= (accBits == 0) ? w : (w >> accBits);
+            uint32_t bits = accBits + cols_;
+
+            if (bits >= 64) {
+                for (int shift = 56; shift >= 0; shift -= 8) {
+                    out[pos++] = static_cast<uint8_t>(acc >> shift);
+                }
+                acc = (accBits == 0) ? 0 : (w << (64 - accBits));
+                bits -= 64;
+            }
+            while (bits >= 8) {
+                out[pos++] = static_cast<uint8_t>(acc >> 56);
+                acc <<= 8;
+                bits -= 8;
+            }
+            accBits = bits;
+        }
+
+        if (accBits != 0) {
+            out[pos++] = static_cast<uint8_t>(acc >> 56);
+        }
+        return pos;
+    }
+
+    std::vector<uint8_t> pack() const {
+        std::vector<uint8_t> result(packedSize());
+        pack(result.data(), result.size());
+        return result;
+    }
+
+    /**
+     * @brief 从 pack() 产生的位流恢复矩阵内容（尺寸需预先 reset）
+     * @return 输入长度不足时返回 false
+     */
+    bool unpack(const uint8_t* in, size_t len) {
+        if (packedSize() == 0) return true;
+        if (in == nullptr || len < packedSize()) return false;
+
+        size_t bitPos = 0;
+        for (uint8_t r = 0; r < rows_; r++) {
+            size_t byteOff = bitPos / 8;
+            uint32_t sh = bitPos % 8;
+
+            // 取 9 字节窗口，超出输入部分按 0 处理
+            uint64_t hi = 0;
+            for (size_t i = 0; i < 8; i++) {
+                hi = (hi << 8) | (byteOff + i < len ? in[byteOff + i] : 0);
+            }
+            uint64_t w = hi << sh;
+            if (sh != 0 && byteOff + 8 < len) {
+                w |= static_cast<uint64_t>(in[byteOff + 8]) >> (8 - sh);
+            }
+
+            data_[r] = w & colMask_;
+            bitPos += cols_;
+        }
+        return true;
+    }
+
+    // 翻转单个位
+    void flip(uint8_t cycle, uint8_t pin) {
+        if (cycle < rows_ && pin < cols_) data_[cycle] ^= pinMask(pin);
+    }
+
+   private:
+    std::array<uint64_t, MAX_ROWS> data_;
+    uint64_t colMask_;
+    uint8_t rows_;
+    uint8_t cols_;
+};
+
+}    // namespace Adapter
+
+#endif    // BIT_MATRIX_64_H
@@ -2,8 +2,6 @@
 
 #include <stdint.h>
 
-#include <algorithm>
-#include <map>
 #include <memory>
 
 #include "hal_hptimer.hpp"
@@ -15,18 +13,42 @@
 
 namespace Adapter {
 
+// 32位位反转：Cortex-M4 上为单条 RBIT 指令
+static inline uint32_t reverseBits32(uint32_t v) {
+#if defined(__arm__)
+    uint32_t result;
+    __asm("rbit %0, %1" : "=r"(result) : "r"(v));
+    return result;
+#else
+    v = ((v >> 1) & 0x55555555U) | ((v & 0x55555555U) << 1);
+    v = ((v >> 2) & 0x33333333U) | ((v & 0x33333333U) << 2);
+    v = ((v >> 4) & 0x0F0F0F0FU) | ((v & 0x0F0F0F0FU) << 4);
+    v = ((v >> 8) & 0x00FF00FFU) | ((v & 0x00FF00FFU) << 8);
+    return (v >> 16) | (v << 16);
+#endif
+}
+
 ContinuityCollector::ContinuityCollector(std::unique_ptr<IGpio> gpio)
     : gpio_(std::move(gpio)),
       status_(CollectionStatus::IDLE),
       currentCycle_(0),
       lastProcessTime_(0),
-      lastActivePin_(-1) {
+      scanAborted_(false),
+      completedCycles_(0),
+      completedAborted_(false),
+      lastActivePin_(-1),
+      scatterRunCount_(0),
+      snapshotPortCount_(0),
+      portPinMasks_{},
+      cycleTimestamps_{},
+      timedStartSyncUs_(0),
+      timedStartLocalUs_(0) {
 
     if (!gpio_) {
         status_ = CollectionStatus::ERROR;
     }
 
-    Log::t("ContinuityCollector", "Constructor: config_.num: %d", config_.num);
+    LOGT("ContinuityCollector", "Constructor: config_.num: %d", config_.num);
 }
 
 ContinuityCollector::~ContinuityCollector() {
@@ -39,7 +61,8 @@ bool ContinuityCollector::configure(const CollectorConfig &config) {
     //     return false;    // 不能在运行时重新配置
     // }
 
-    if (config.num == 0 || config.num > MAX_GPIO_PINS || config.interval == 0) {
+    if (config.num == 0 || config.num > MAX_GPIO_PINS ||
+        config.getPeriodUs() == 0) {
         return false;
     }
 
@@ -52,18 +75,22 @@ bool ContinuityCollector::configure(const CollectorConfig &config) {
         return false;
     }
 
+    // 稳定时间必须小于检测间隔，否则无法保证周期间隔
+    if (config.settleTimeUs >= config.getPeriodUs()) {
+        return false;
+    }
+
     config_ = config;
 
-    // 重新初始化数据矩阵 - 基于总检测数量
-    {
-        dataMatrix_.clear();
-        dataMatrix_.resize(config_.totalDetectionNum,
-                           std::vector<ContinuityState>(
-                               config_.num, ContinuityState::DISCONNECTED));
-    }
+    // 重新初始化数据矩阵 - 基于总检测数量（静态存储，无堆分配）
+    dataMatrix_.reset(config_.totalDetectionNum, config_.num);
+    cycleTimestamps_.fill(0);
 
     currentCycle_ = 0;
 
+    // 生成端口快照散射表
+    buildScatterTable();
+
     // 初始化GPIO引脚
     initializeGpioPins();
 
@@ -84,24 +111,59 @@ bool ContinuityCollector::startCollection() {
     // 停止之前的采集
     stopCollection();
 
+    // 采集开始前按端口批量复位所有检测引脚，之后每周期只改动两个引脚
+    resetAllPins();
+
+    if (frameRing_) {
+        frameRing_->clear();
+    }
+    completedCycles_ = 0;
+    completedAborted_ = false;
+
+    beginScan();
+    if (status_ != CollectionStatus::RUNNING) {
+        return false;
+    }
+
+    LOGT("ContinuityCollector", "startCollection completed, status: RUNNING");
+    return true;
+}
+
+void ContinuityCollector::beginScan() {
     // 重置状态
     currentCycle_ = 0;
+    cycleTimestamps_.fill(0);
+    scanAborted_ = false;
     status_ = CollectionStatus::RUNNING;
     lastProcessTime_ = getSyncTimeUs();  // 使用同步时间
     lastActivePin_ = -1;  // 重置上一个激活的引脚
 
-    Log::t("ContinuityCollector", "startCollection completed, status: RUNNING");
-    return true;
+    if (timedEngine_ && !startTimedScan()) {
+        status_ = CollectionStatus::ERROR;
+    }
+}
+
+void ContinuityCollector::finishScan() {
+    status_ = CollectionStatus::COMPLETED;
+    completedCycles_ = currentCycle_;
+    completedAborted_ = scanAborted_;
+
+    // 连续采集：保存本帧并立即开始下一次扫描
+    if (frameRing_) {
+        frameRing_->push(dataMatrix_, cycleTimestamps_[0]);
+        beginScan();
+    }
 }
 
 void ContinuityCollector::stopCollection() {
     if (status_ == CollectionStatus::RUNNING) {
         status_ = CollectionStatus::IDLE;
+        if (timedEngine_) {
+            timedEngine_->stop();
+        }
         // 复位所有引脚
         if (lastActivePin_ >= 0) {
-            uint8_t physicalPin = config_.getPhysicalPin(lastActivePin_);
-            GpioConfig gpioConfig(physicalPin, GpioMode::INPUT_PULLDOWN);
-            gpio_->init(gpioConfig);
+            setLogicalPinMode(lastActivePin_, GpioMode::INPUT_PULLDOWN);
             lastActivePin_ = -1;
         }
     }
@@ -112,13 +174,14 @@ uint32_t ContinuityCollector::getCurrentTimeMs() {
 }
 
 uint64_t ContinuityCollector::getCurrentTimeUs() {
-    return hal_hptimer_get_us();
+    return hal_hptimer_get_us64();
 }
 
 uint32_t ContinuityCollector::getSyncTimeMs() {
     // 如果设置了同步时间回调，使用同步时间，否则使用本地时间
+    // 回调返回的是微秒
     if (syncTimeCallback_) {
-        return syncTimeCallback_();
+        return static_cast<uint32_t>(syncTimeCallback_() / 1000);
     }
     return getCurrentTimeMs();
 }
@@ -142,9 +205,17 @@ void ContinuityCollector::processCollection() {
         return;
     }
 
+    // 定时扫描模式：周期由定时器中断推进，这里只在完成后收集结果
+    if (timedEngine_) {
+        if (timedEngine_->isComplete()) {
+            collectTimedScan();
+        }
+        return;
+    }
+
     // 检查是否已完成所有周期
     if (currentCycle_ >= config_.totalDetectionNum) {
-        status_ = CollectionStatus::COMPLETED;
+        finishScan();
         return;
     }
 
@@ -152,34 +223,30 @@ void ContinuityCollector::processCollection() {
     uint64_t currentTime = getSyncTimeUs();  // 使用同步时间
     uint64_t elapsedTime = currentTime - lastProcessTime_;
 
-    if (elapsedTime >= config_.interval || currentCycle_ == 0) {
+    if (elapsedTime >= config_.getPeriodUs() ||
+        currentCycle_ == 0) {
         // 立即复位上一个激活的引脚，然后配置新的引脚
         configurePinsForCycle(currentCycle_);
 
-        // 延迟5ms，确保电路稳定并抵消时差
-        delayMs(1);
-
-        // 读取当前周期的所有引脚状态
-        std::vector<ContinuityState> cycleData;
-        cycleData.reserve(config_.num);
-        // Log::d("ContinuityCollector", "Cycle %d: Reading %d pins after 5ms delay", 
-        //        currentCycle_, config_.num);
-
-        for (uint8_t pin = 0; pin < config_.num; pin++) {
-            ContinuityState state = readPinContinuity(pin);
-            cycleData.push_back(state);
-            // Log::d("ContinuityCollector", "Cycle %d, Pin %d (physical %d): %s", 
-            //        currentCycle_, pin, config_.getPhysicalPin(pin),
-            //        (state == ContinuityState::CONNECTED) ? "CONNECTED" : "DISCONNECTED");
-        }
-
-        // 保存数据到矩阵
-        {
-            if (currentCycle_ < dataMatrix_.size()) {
-                dataMatrix_[currentCycle_] = std::move(cycleData);
+        // 等待电路稳定，稳定时间按线束配置（微秒定时器唤醒，不受 tick 粒度
+        // 限制，等待期间让出 CPU；很短的稳定时间仍忙等）
+        hal_hptimer_sleep_us(config_.settleTimeUs);
+
+        // 读取当前周期的所有引脚状态，直接拼成一个行字
+        // 优先使用端口快照（几次寄存器读取），不支持时退回逐引脚读取
+        uint64_t cycleWord = 0;
+        if (!readCycleSnapshot(cycleWord)) {
+            for (uint8_t pin = 0; pin < config_.num; pin++) {
+                if (readPinContinuity(pin) == ContinuityState::CONNECTED) {
+                    cycleWord |= BitMatrix64::pinMask(pin);
+                }
             }
         }
 
+        // 保存数据和采样时刻
+        dataMatrix_.setRow(currentCycle_, cycleWord);
+        cycleTimestamps_[currentCycle_] = getSyncTimeUs();
+
         // // 调用进度回调
         // if (progressCallback_) {
         //     progressCallback_(currentCycle_ + 1, config_.totalDetectionNum);
@@ -189,16 +256,15 @@ void ContinuityCollector::processCollection() {
         lastProcessTime_ = currentTime;
         currentCycle_++;
 
-        // 检查是否完成
-        if (currentCycle_ >= config_.totalDetectionNum) {
-            status_ = CollectionStatus::COMPLETED;
+        // 检查是否完成（周期检查失败时提前结束）
+        if (!checkCycle(currentCycle_ - 1, cycleWord) ||
+            currentCycle_ >= config_.totalDetectionNum) {
             // 复位最后一个激活的引脚
             if (lastActivePin_ >= 0) {
-                uint8_t physicalPin = config_.getPhysicalPin(lastActivePin_);
-                GpioConfig gpioConfig(physicalPin, GpioMode::INPUT_PULLDOWN);
-                gpio_->init(gpioConfig);
+                setLogicalPinMode(lastActivePin_, GpioMode::INPUT_PULLDOWN);
                 lastActivePin_ = -1;
             }
+            finishScan();
         }
     }
 }
@@ -226,73 +292,29 @@ bool ContinuityCollector::isCollectionComplete() const {
     return status_ == CollectionStatus::COMPLETED;
 }
 
-ContinuityMatrix ContinuityCollector::getDataMatrix() const {
+const ContinuityMatrix &ContinuityCollector::getDataMatrix() const {
     return dataMatrix_;
 }
 
 std::vector<uint8_t> ContinuityCollector::getDataVector() const {
-    std::vector<uint8_t> compressedData;
-
-    size_t totalBits = dataMatrix_.size() * config_.num;
-    size_t totalBytes = (totalBits + 7) / 8;    // 向上取整
-    compressedData.reserve(totalBytes);
-
-    uint8_t currentByte = 0;
-    uint8_t bitPosition = 7;    // 从高位开始（大端）
-
-    for (const auto &row : dataMatrix_) {
-        for (size_t pin = 0; pin < config_.num && pin < row.size(); pin++) {
-            uint8_t bitValue = (row[pin] == ContinuityState::CONNECTED) ? 1 : 0;
-
-            // 设置对应的高位
-            currentByte |= (bitValue << bitPosition);
-
-            if (bitPosition == 0) {
-                compressedData.push_back(currentByte);
-                currentByte = 0;
-                bitPosition = 7;
-            } else {
-                bitPosition--;
-            }
-        }
-    }
-
-    // 处理不足8位的最后一个字节
-    if (bitPosition != 7) {
-        compressedData.push_back(currentByte);
-    }
-
-    return compressedData;
+    return dataMatrix_.pack();
 }
 
-std::vector<ContinuityState> ContinuityCollector::getCycleData(
-    uint8_t cycle) const {
-    if (cycle < dataMatrix_.size()) {
-        return dataMatrix_[cycle];
-    }
-    return {};
+size_t ContinuityCollector::getDataVector(uint8_t *out, size_t capacity) const {
+    return dataMatrix_.pack(out, capacity);
 }
 
-std::vector<ContinuityState> ContinuityCollector::getPinData(
-    uint8_t pin) const {
-    std::vector<ContinuityState> result;
-
-    if (pin < config_.num) {
-        result.reserve(dataMatrix_.size());
-        for (const auto &row : dataMatrix_) {
-            if (pin < row.size()) {
-                result.push_back(row[pin]);
-            }
-        }
-    }
+BitMatrix64::RowView ContinuityCollector::getCycleData(uint8_t cycle) const {
+    return dataMatrix_.row(cycle);
+}
 
-    return result;
+BitMatrix64::ColumnView ContinuityCollector::getPinData(uint8_t pin) const {
+    return dataMatrix_.column(pin);
 }
 
 void ContinuityCollector::clearData() {
-    for (auto &row : dataMatrix_) {
-        std::fill(row.begin(), row.end(), ContinuityState::DISCONNECTED);
-    }
+    dataMatrix_.clear();
+    cycleTimestamps_.fill(0);
     currentCycle_ = 0;
 }
 
@@ -304,67 +326,169 @@ void ContinuityCollector::setSyncTimeCallback(SyncTimeCallback callback) {
     syncTimeCallback_ = callback;
 }
 
+void ContinuityCollector::setCycleCheckCallback(CycleCheckCallback callback) {
+    cycleCheckCallback_ = callback;
+}
+
+bool ContinuityCollector::checkCycle(uint8_t cycle, uint64_t cycleWord) {
+    if (!cycleCheckCallback_ || cycleCheckCallback_(cycle, cycleWord)) {
+        return true;
+    }
+
+    // 提前终止：清除之后周期的旧数据，避免与本次结果混淆
+    for (uint8_t r = cycle + 1; r < dataMatrix_.rows(); r++) {
+        dataMatrix_.setRow(r, 0);
+    }
+    scanAborted_ = true;
+    LOGD("ContinuityCollector", "scan aborted at cycle %d", cycle);
+    return false;
+}
+
 ContinuityCollector::Statistics ContinuityCollector::calculateStatistics()
     const {
     Statistics stats = {};
+    stats.firstAsymmetricA = NO_PIN;
+    stats.firstAsymmetricB = NO_PIN;
+
+    const uint8_t rows = dataMatrix_.rows();
+    const uint8_t cols = dataMatrix_.cols();
 
+    // 每周期 popcount 得到周期导通数；逐个取出置位引脚累计引脚导通数，
+    // 开销与导通位数成正比
     uint32_t totalConnections = 0;
-    uint32_t totalReadings = 0;
-    std::map<uint8_t, uint32_t> pinActivity;
-
-    // 统计数据
-    for (const auto &row : dataMatrix_) {
-        for (uint8_t pin = 0; pin < row.size(); pin++) {
-            totalReadings++;
-            if (row[pin] == ContinuityState::CONNECTED) {
-                totalConnections++;
-                pinActivity[pin]++;
-            }
+    for (uint8_t cycle = 0; cycle < rows; cycle++) {
+        uint64_t word = dataMatrix_.rowWord(cycle);
+        uint8_t count = static_cast<uint8_t>(__builtin_popcountll(word));
+        stats.cycleConnections[cycle] = count;
+        totalConnections += count;
+
+        while (word) {
+            uint8_t pin = static_cast<uint8_t>(__builtin_clzll(word));
+            word &= ~BitMatrix64::pinMask(pin);
+            stats.pinConnections[pin]++;
         }
     }
 
+    uint32_t totalReadings = static_cast<uint32_t>(rows) * cols;
     stats.totalConnections = totalConnections;
     stats.totalDisconnections = totalReadings - totalConnections;
-    stats.connectionRate =
+    stats.connectionRateBp =
         totalReadings > 0
-            ? static_cast<double>(totalConnections) / totalReadings * 100.0
-            : 0.0;
+            ? static_cast<uint16_t>((totalConnections * 10000U +
+                                     totalReadings / 2) /
+                                    totalReadings)
+            : 0;
+
+    // 部分选择：维护按导通次数降序的前 K 个引脚（次数相同时引脚号小者优先）
+    uint8_t topCount = 0;
+    for (uint8_t pin = 0; pin < cols; pin++) {
+        uint8_t activity = stats.pinConnections[pin];
+        if (activity == 0) continue;
+        if (topCount == TOP_ACTIVE_PINS &&
+            activity <= stats.pinConnections[stats.mostActivePins[topCount - 1]]) {
+            continue;
+        }
 
-    // 找出最活跃的引脚
-    std::vector<std::pair<uint8_t, uint32_t>> sortedPins;
-    for (const auto &pair : pinActivity) {
-        sortedPins.push_back(pair);
+        uint8_t pos = topCount < TOP_ACTIVE_PINS ? topCount++ : topCount - 1;
+        while (pos > 0 &&
+               stats.pinConnections[stats.mostActivePins[pos - 1]] < activity) {
+            stats.mostActivePins[pos] = stats.mostActivePins[pos - 1];
+            pos--;
+        }
+        stats.mostActivePins[pos] = pin;
     }
+    stats.mostActivePinCount = topCount;
 
-    std::sort(sortedPins.begin(), sortedPins.end(),
-              [](const auto &a, const auto &b) { return a.second > b.second; });
-
-    for (size_t i = 0; i < 5 && i < sortedPins.size(); i++) {
-        stats.mostActivePins[i] = sortedPins[i].first;
+    // 对称性检查：周期 startDetectionNum + A 驱动逻辑引脚 A，
+    // 引脚 A 驱动时读到 B 应与引脚 B 驱动时读到 A 一致
+    uint8_t driven = 0;
+    if (config_.startDetectionNum < rows) {
+        driven = rows - config_.startDetectionNum;
+    }
+    if (driven > config_.num) driven = config_.num;
+    if (driven > cols) driven = cols;
+
+    for (uint8_t a = 0; a < driven; a++) {
+        uint64_t rowA = dataMatrix_.rowWord(config_.startDetectionNum + a);
+        for (uint8_t b = a + 1; b < driven; b++) {
+            uint64_t rowB = dataMatrix_.rowWord(config_.startDetectionNum + b);
+            bool ab = (rowA & BitMatrix64::pinMask(b)) != 0;
+            bool ba = (rowB & BitMatrix64::pinMask(a)) != 0;
+            if (ab != ba) {
+                if (stats.asymmetricPairs == 0) {
+                    stats.firstAsymmetricA = a;
+                    stats.firstAsymmetricB = b;
+                }
+                stats.asymmetricPairs++;
+            }
+        }
     }
 
     return stats;
 }
 
+uint64_t ContinuityCollector::getCycleTimestamp(uint8_t cycle) const {
+    if (cycle >= currentCycle_ || cycle >= cycleTimestamps_.size()) {
+        return 0;
+    }
+    return cycleTimestamps_[cycle];
+}
+
+ContinuityCollector::CycleTiming ContinuityCollector::getCycleTiming() const {
+    CycleTiming timing = {};
+
+    uint8_t cycles = currentCycle_;
+    if (cycles > cycleTimestamps_.size()) {
+        cycles = cycleTimestamps_.size();
+    }
+    timing.cycles = cycles;
+    if (cycles == 0) {
+        return timing;
+    }
+
+    timing.firstTimestampUs = cycleTimestamps_[0];
+    timing.lastTimestampUs = cycleTimestamps_[cycles - 1];
+    if (cycles < 2) {
+        return timing;
+    }
+
+    uint32_t minSpacing = UINT32_MAX;
+    uint32_t maxSpacing = 0;
+    for (uint8_t cycle = 1; cycle < cycles; cycle++) {
+        uint64_t delta = cycleTimestamps_[cycle] - cycleTimestamps_[cycle - 1];
+        uint32_t spacing =
+            delta > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(delta);
+        if (spacing < minSpacing) minSpacing = spacing;
+        if (spacing > maxSpacing) maxSpacing = spacing;
+    }
+
+    uint64_t span = timing.lastTimestampUs - timing.firstTimestampUs;
+    timing.minSpacingUs = minSpacing;
+    timing.maxSpacingUs = maxSpacing;
+    timing.meanSpacingUs = static_cast<uint32_t>(span / (cycles - 1));
+    timing.jitterUs = maxSpacing - minSpacing;
+    return timing;
+}
+
 void ContinuityCollector::initializeGpioPins() {
-    Log::t("ContinuityCollector", "initializeGpioPins");
+    LOGT("ContinuityCollector", "initializeGpioPins");
     if (!gpio_) {
-        Log::e("ContinuityCollector", "GPIO is not initialized");
+        LOGE("ContinuityCollector", "GPIO is not initialized");
         return;
     }
 
-    Log::t("ContinuityCollector", "initializeGpioPins: config_.num: %d",
-           config_.num);
+    LOGT("ContinuityCollector", "initializeGpioPins: config_.num: %d",
+         config_.num);
 
     // 初始化所有需要的GPIO引脚为输入模式，使用物理引脚号
     for (uint8_t logicalPin = 0; logicalPin < config_.num; logicalPin++) {
-        Log::t("ContinuityCollector", "logicalPin: %d", logicalPin);
+        LOGT("ContinuityCollector", "logicalPin: %d", logicalPin);
         uint8_t physicalPin = config_.getPhysicalPin(logicalPin);
-        Log::t("ContinuityCollector", "physicalPin: %d", physicalPin);
+        LOGT("ContinuityCollector", "physicalPin: %d", physicalPin);
         GpioConfig gpioConfig(physicalPin, GpioMode::INPUT_PULLDOWN);
-        Log::t("ContinuityCollector", "gpioConfig: %d", gpioConfig.pin);
+        LOGT("ContinuityCollector", "gpioConfig: %d", gpioConfig.pin);
         gpio_->init(gpioConfig);
-        Log::t("ContinuityCollector", "GPIO %d initialized", gpioConfig.pin);
+        LOGT("ContinuityCollector", "GPIO %d initialized", gpioConfig.pin);
     }
 }
 
@@ -391,48 +515,267 @@ ContinuityState ContinuityCollector::readPinContinuity(uint8_t logicalPin) {
                                           : ContinuityState::DISCONNECTED;
 }
 
-void ContinuityCollector::configurePinsForCycle(uint8_t currentCycle) {
+void ContinuityCollector::buildScatterTable() {
+    scatterRunCount_ = 0;
+    snapshotPortCount_ = 0;
+    portPinMasks_.fill(0);
+
+    for (uint8_t logicalPin = 0; logicalPin < config_.num; logicalPin++) {
+        uint8_t physicalPin = config_.getPhysicalPin(logicalPin);
+        uint8_t port = physicalPin / GPIO_PINS_PER_PORT;
+        uint8_t bit = physicalPin % GPIO_PINS_PER_PORT;
+
+        if (port >= GPIO_PORT_COUNT) {
+            // 物理引脚超出可快照的端口范围，禁用快照采样
+            scatterRunCount_ = 0;
+            snapshotPortCount_ = 0;
+            return;
+        }
+        portPinMasks_[port] |= static_cast<uint16_t>(1U << bit);
+
+        // 位反转后端口位 bit 位于 31 - bit，逻辑引脚位于行字 63 - logicalPin
+        int8_t shift = static_cast<int8_t>(32 + bit - logicalPin);
+        uint64_t mask = BitMatrix64::pinMask(logicalPin);
+
+        bool merged = false;
+        for (uint8_t i = 0; i < scatterRunCount_; i++) {
+            if (scatterRuns_[i].port == port &&
+                scatterRuns_[i].shift == shift) {
+                scatterRuns_[i].mask |= mask;
+                merged = true;
+                break;
+            }
+        }
+        if (!merged) {
+            scatterRuns_[scatterRunCount_++] = {port, shift, mask};
+        }
+
+        if (port + 1 > snapshotPortCount_) {
+            snapshotPortCount_ = port + 1;
+        }
+    }
+}
+
+bool ContinuityCollector::readCycleSnapshot(uint64_t &cycleWord) {
+    if (!gpio_ || scatterRunCount_ == 0) {
+        return false;
+    }
+
+    uint16_t ports[GPIO_PORT_COUNT];
+    if (!gpio_->readPortSnapshot(ports, snapshotPortCount_)) {
+        return false;
+    }
+
+    cycleWord = scatterPorts(ports);
+    return true;
+}
+
+uint64_t ContinuityCollector::scatterPorts(const uint16_t *ports) const {
+    uint64_t word = 0;
+    for (uint8_t i = 0; i < scatterRunCount_; i++) {
+        const ScatterRun &run = scatterRuns_[i];
+        uint64_t value = reverseBits32(ports[run.port]);
+        value = (run.shift >= 0) ? (value << run.shift)
+                                 : (value >> -run.shift);
+        word |= value & run.mask;
+    }
+    return word;
+}
+
+bool ContinuityCollector::enableTimedScan(std::unique_ptr<IScanTimer> timer,
+                                          std::unique_ptr<IScanSignal> signal) {
+    if (!gpio_ || !timer || status_ == CollectionStatus::RUNNING) {
+        return false;
+    }
+
+    // 定时扫描依赖端口快照，引脚必须全部落在可快照的端口内
+    if (scatterRunCount_ == 0 || config_.settleTimeUs == 0) {
+        LOGW("ContinuityCollector", "timed scan not supported by config");
+        return false;
+    }
+
+    if (!signal) {
+        signal = std::make_unique<TaskNotifyScanSignal>();
+    }
+    timedEngine_ = std::make_unique<TimedScanEngine>(
+        gpio_.get(), std::move(timer), std::move(signal));
+    return true;
+}
+
+void ContinuityCollector::disableTimedScan() {
+    if (status_ == CollectionStatus::RUNNING) {
+        stopCollection();
+    }
+    timedEngine_.reset();
+}
+
+bool ContinuityCollector::waitForCompletion(uint32_t timeoutMs) {
+    if (!timedEngine_) {
+        return isCollectionComplete();
+    }
+    if (status_ == CollectionStatus::RUNNING) {
+        timedEngine_->waitForCompletion(timeoutMs);
+        processCollection();
+    }
+    return isCollectionComplete();
+}
+
+bool ContinuityCollector::startTimedScan() {
+    if (scatterRunCount_ == 0) {
+        LOGE("ContinuityCollector", "timed scan requires port snapshot");
+        return false;
+    }
+
+    // 为每个周期预先算好要驱动的端口和引脚掩码，中断里只做寄存器写
+    TimedScanEngine::ScanStep steps[TimedScanEngine::MAX_CYCLES];
+    for (uint8_t cycle = 0; cycle < config_.totalDetectionNum; cycle++) {
+        steps[cycle] = {0, 0};
+        if (cycle >= config_.startDetectionNum &&
+            cycle < config_.startDetectionNum + config_.num) {
+            uint8_t physicalPin =
+                config_.getPhysicalPin(cycle - config_.startDetectionNum);
+            steps[cycle].port = physicalPin / GPIO_PINS_PER_PORT;
+            steps[cycle].mask = static_cast<uint16_t>(
+                1U << (physicalPin % GPIO_PINS_PER_PORT));
+        }
+    }
+
+    // 定时器周期为 32 位微秒
+    uint64_t periodUs = config_.getPeriodUs();
+    if (periodUs > UINT32_MAX) {
+        LOGE("ContinuityCollector", "scan period too long for timer");
+        return false;
+    }
+    if (config_.settleTimeUs == 0 || config_.settleTimeUs >= periodUs) {
+        LOGE("ContinuityCollector", "invalid settle time %lu us",
+             static_cast<unsigned long>(config_.settleTimeUs));
+        return false;
+    }
+
+    // 记录同步时间与定时器时基的对应关系，用于换算采样时刻
+    timedStartSyncUs_ = getSyncTimeUs();
+    timedStartLocalUs_ = timedEngine_->getTimer()->nowUs();
+
+    if (!timedEngine_->start(steps, config_.totalDetectionNum,
+                             snapshotPortCount_,
+                             static_cast<uint32_t>(periodUs),
+                             config_.settleTimeUs)) {
+        LOGE("ContinuityCollector", "scan timer start failed");
+        return false;
+    }
+    return true;
+}
+
+void ContinuityCollector::collectTimedScan() {
+    uint8_t cycles = timedEngine_->capturedCycles();
+    uint8_t cycle = 0;
+    while (cycle < cycles) {
+        uint64_t cycleWord = scatterPorts(timedEngine_->capture(cycle).data());
+        dataMatrix_.setRow(cycle, cycleWord);
+        uint32_t offset =
+            timedEngine_->captureTimeUs(cycle) - timedStartLocalUs_;
+        cycleTimestamps_[cycle] = timedStartSyncUs_ + offset;
+        cycle++;
+        if (!checkCycle(cycle - 1, cycleWord)) {
+            break;
+        }
+    }
+    currentCycle_ = cycle;
+    lastActivePin_ = -1;
+    finishScan();
+}
+
+bool ContinuityCollector::enableContinuousMode(uint8_t depth) {
+    if (status_ == CollectionStatus::RUNNING) {
+        return false;
+    }
+
+    std::unique_ptr<FrameRing> ring = std::make_unique<FrameRing>();
+    if (!ring->init(depth)) {
+        return false;
+    }
+    frameRing_ = std::move(ring);
+    return true;
+}
+
+void ContinuityCollector::disableContinuousMode() {
+    if (status_ == CollectionStatus::RUNNING) {
+        stopCollection();
+    }
+    frameRing_.reset();
+}
+
+size_t ContinuityCollector::encodeLatestFrame(uint8_t *out, size_t capacity,
+                                              bool keyFrame) const {
+    if (!frameRing_ || frameRing_->empty()) {
+        return 0;
+    }
+
+    const FrameRing::Frame *cur = frameRing_->latest();
+    const FrameRing::Frame *prev = keyFrame ? nullptr : frameRing_->get(1);
+    return DeltaCodec::encode(prev ? &prev->matrix : nullptr,
+                              prev ? prev->sequence : 0, cur->matrix,
+                              cur->sequence, out, capacity);
+}
+
+void ContinuityCollector::resetAllPins() {
     if (!gpio_) {
         return;
     }
 
-    // 1. 立即复位上一个激活的引脚（如果有）
-    if (lastActivePin_ >= 0) {
-        uint8_t physicalPin = config_.getPhysicalPin(lastActivePin_);
-        GpioConfig gpioConfig(physicalPin, GpioMode::INPUT_PULLDOWN);
-        gpio_->init(gpioConfig);
-        Log::t("ContinuityCollector", "Reset previous active pin: logical=%d, physical=%d", 
-               lastActivePin_, physicalPin);
+    if (scatterRunCount_ == 0) {
+        // 端口表不可用时退回逐引脚配置
+        for (uint8_t logicalPin = 0; logicalPin < config_.num; logicalPin++) {
+            uint8_t physicalPin = config_.getPhysicalPin(logicalPin);
+            gpio_->init(GpioConfig(physicalPin, GpioMode::INPUT_PULLDOWN));
+        }
+        return;
     }
 
-    // 2. 确定当前周期应该激活的引脚
+    for (uint8_t port = 0; port < GPIO_PORT_COUNT; port++) {
+        if (portPinMasks_[port] != 0) {
+            gpio_->configurePort(port, portPinMasks_[port],
+                                 GpioMode::INPUT_PULLDOWN);
+        }
+    }
+}
+
+void ContinuityCollector::setLogicalPinMode(uint8_t logicalPin, GpioMode mode,
+                                            GpioState state) {
+    uint8_t physicalPin = config_.getPhysicalPin(logicalPin);
+    uint8_t port = physicalPin / GPIO_PINS_PER_PORT;
+    uint16_t mask =
+        static_cast<uint16_t>(1U << (physicalPin % GPIO_PINS_PER_PORT));
+
+    if (!gpio_->configurePort(port, mask, mode, state)) {
+        gpio_->init(GpioConfig(physicalPin, mode, state));
+    }
+}
+
+void ContinuityCollector::configurePinsForCycle(uint8_t currentCycle) {
+    if (!gpio_) {
+        return;
+    }
+
+    // 1. 确定当前周期应该激活的引脚
     int8_t currentActivePin = -1;
     if (currentCycle >= config_.startDetectionNum &&
         currentCycle < config_.startDetectionNum + config_.num) {
         currentActivePin = currentCycle - config_.startDetectionNum;
     }
 
-    // 3. 先配置激活引脚为输出高电平（如果有），再配置其他引脚为输入
-    if (currentActivePin >= 0) {
-        uint8_t activePhysicalPin = config_.getPhysicalPin(currentActivePin);
-        GpioConfig activeConfig(activePhysicalPin, GpioMode::OUTPUT, GpioState::HIGH);
-        gpio_->init(activeConfig);
-        gpio_->write(activePhysicalPin, GpioState::HIGH);
-        
-        Log::t("ContinuityCollector", "Cycle %d: Activated pin logical=%d, physical=%d", 
-               currentCycle, currentActivePin, activePhysicalPin);
+    // 2. 复位上一个激活的引脚（其余引脚在 startCollection 时已批量复位，
+    //    采集过程中保持输入下拉，无需每周期重新配置）
+    if (lastActivePin_ >= 0 && lastActivePin_ != currentActivePin) {
+        setLogicalPinMode(lastActivePin_, GpioMode::INPUT_PULLDOWN);
     }
 
-    // 4. 配置其他引脚为输入下拉模式
-    for (uint8_t logicalPin = 0; logicalPin < config_.num; logicalPin++) {
-        if (logicalPin != currentActivePin) {  // 跳过已激活的引脚
-            uint8_t physicalPin = config_.getPhysicalPin(logicalPin);
-            GpioConfig gpioConfig(physicalPin, GpioMode::INPUT_PULLDOWN);
-            gpio_->init(gpioConfig);
-        }
+    // 3. 配置新的激活引脚为输出高电平
+    if (currentActivePin >= 0 && currentActivePin != lastActivePin_) {
+        setLogicalPinMode(currentActivePin, GpioMode::OUTPUT, GpioState::HIGH);
     }
 
-    // 5. 更新上一个激活的引脚记录
+    // 4. 更新上一个激活的引脚记录
     lastActivePin_ = currentActivePin;
 }
 
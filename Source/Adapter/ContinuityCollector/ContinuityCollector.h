@@ -1,25 +1,26 @@
 #ifndef CONTINUITY_COLLECTOR_H
 #define CONTINUITY_COLLECTOR_H
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "BitMatrix64.h"
+#include "DeltaCodec.h"
+#include "FrameRing.h"
 #include "IGpio.hpp"
 #include "Logger.h"
+#include "ScanSignal.h"
+#include "ScanTimer.h"
+#include "TimedScanEngine.h"
 
 using namespace Interface;
 
 namespace Adapter {
 
-// 导通状态枚举
-enum class ContinuityState : uint8_t {
-    DISCONNECTED = 0,    // 断开
-    CONNECTED = 1        // 导通
-};
-
 // 硬件定义的引脚映射表 (64个引脚)
 static constexpr uint8_t HARDWARE_PIN_MAP[64] = {
     // PA3 - PA12, PA15
@@ -53,46 +54,57 @@ struct CollectorConfig {
     uint8_t num;                    // 导通检测数量 a (< 64)
     uint8_t startDetectionNum;      // 开始检测数量 b
     uint8_t totalDetectionNum;      // 总检测数量 k
-    uint32_t interval;              // 检测间隔 (毫秒)
+    uint32_t interval;              // 检测间隔 (毫秒)，periodUs 为 0 时使用
     bool autoStart;                 // 是否自动开始采集
+    uint32_t settleTimeUs;          // 驱动引脚到采样的稳定时间 (微秒)
+    uint32_t periodUs;              // 检测间隔 (微秒)，非 0 时优先于 interval
 
     CollectorConfig(uint8_t n = 2, uint8_t startDetNum = 0,
                     uint8_t totalDetNum = 4, uint32_t i = 20,
-                    bool autoS = false)
+                    bool autoS = false, uint32_t settleUs = 1000,
+                    uint32_t pUs = 0)
         : num(n),
           startDetectionNum(startDetNum),
           totalDetectionNum(totalDetNum),
           interval(i),
-          autoStart(autoS) {
+          autoStart(autoS),
+          settleTimeUs(settleUs),
+          periodUs(pUs) {
 
         if (num > 64) num = 64;
         if (totalDetectionNum == 0 || totalDetectionNum > 64)
             totalDetectionNum = 64;
         if (startDetectionNum >= totalDetectionNum) startDetectionNum = 0;
 
-        Log::t("CollectorConfig", "Constructor: n=%d, final num=%d", n, num);
+        LOGT("CollectorConfig", "Constructor: n=%d, final num=%d", n, num);
+    }
+
+    // 实际检测间隔（微秒）：优先 periodUs，否则由 interval 换算
+    uint64_t getPeriodUs() const {
+        return periodUs != 0 ? periodUs
+                             : static_cast<uint64_t>(interval) * 1000;
     }
 
     // 获取逻辑引脚对应的物理引脚
     uint8_t getPhysicalPin(uint8_t logicalPin) const {
-        Log::t("CollectorConfig",
-               "getPhysicalPin called, logicalPin: %d",
-               logicalPin);
+        LOGT("CollectorConfig",
+             "getPhysicalPin called, logicalPin: %d",
+             logicalPin);
 
         if (logicalPin < 64) {
             uint8_t physicalPin = HARDWARE_PIN_MAP[logicalPin];
-            Log::t("CollectorConfig", "returning physicalPin: %d", physicalPin);
+            LOGT("CollectorConfig", "returning physicalPin: %d", physicalPin);
             return physicalPin;
         }
 
-        Log::t("CollectorConfig", "logicalPin out of range, returning: %d",
-               logicalPin);
+        LOGT("CollectorConfig", "logicalPin out of range, returning: %d",
+             logicalPin);
         return logicalPin;    // 如果超出范围，返回逻辑引脚号
     }
 };
 
-// 导通数据矩阵类型
-using ContinuityMatrix = std::vector<std::vector<ContinuityState>>;
+// 导通数据矩阵类型（按位压缩，定长 64x64）
+using ContinuityMatrix = BitMatrix64;
 
 // 采集状态枚举
 enum class CollectionStatus : uint8_t {
@@ -109,10 +121,14 @@ using ProgressCallback =
 // 时间同步回调函数类型 - 用于获取同步时间
 using SyncTimeCallback = std::function<uint64_t()>;
 
+// 周期检查回调函数类型 - 返回 false 时提前终止本次扫描
+using CycleCheckCallback =
+    std::function<bool(uint8_t cycle, uint64_t cycleWord)>;
+
 // 导通数据采集器类
 class ContinuityCollector {
    private:
-    static constexpr uint8_t MAX_GPIO_PINS = 64;
+    static constexpr uint8_t MAX_GPIO_PINS = BitMatrix64::MAX_COLS;
 
     std::unique_ptr<IGpio> gpio_;    // GPIO接口
     CollectorConfig config_;         // 采集配置
@@ -123,10 +139,38 @@ class ContinuityCollector {
     uint64_t lastProcessTime_;             // 上次处理时间（毫秒）
     ProgressCallback progressCallback_;    // 进度回调
     SyncTimeCallback syncTimeCallback_;    // 同步时间回调
+    CycleCheckCallback cycleCheckCallback_;    // 周期检查回调
+    bool scanAborted_;                     // 本次扫描是否被提前终止
+    uint8_t completedCycles_;              // 最近完成的扫描采集的周期数
+    bool completedAborted_;                // 最近完成的扫描是否被提前终止
     
     // 引脚状态跟踪
     int8_t lastActivePin_;                 // 上一个激活的引脚（-1表示无）
 
+    // 端口快照散射表：同一端口内位号与逻辑引脚号差值相同的引脚归为一段，
+    // 端口字位反转后经一次移位+掩码即可落到行字对应位置
+    struct ScatterRun {
+        uint8_t port;     // 端口索引（0=PA）
+        int8_t shift;     // 位反转后的端口字到行字的移位量（正数左移）
+        uint64_t mask;    // 本段在行字中覆盖的位
+    };
+    std::array<ScatterRun, MAX_GPIO_PINS> scatterRuns_;
+    uint8_t scatterRunCount_;              // 有效段数（0表示不支持快照采样）
+    uint8_t snapshotPortCount_;            // 需要读取的端口数
+    std::array<uint16_t, GPIO_PORT_COUNT>
+        portPinMasks_;                     // 每个端口参与检测的引脚掩码
+
+    // 每周期采样时刻（同步时间，微秒）
+    std::array<uint64_t, BitMatrix64::MAX_ROWS> cycleTimestamps_;
+
+    // 定时器驱动扫描（为空时使用 processCollection 轮询采集）
+    std::unique_ptr<TimedScanEngine> timedEngine_;
+    uint64_t timedStartSyncUs_;            // 定时扫描启动时的同步时间
+    uint32_t timedStartLocalUs_;           // 定时扫描启动时的定时器时间
+
+    // 连续采集：每次扫描完成后存入历史环并立即开始下一次扫描
+    std::unique_ptr<FrameRing> frameRing_;
+
     // 私有方法
     void initializeGpioPins();      // 初始化GPIO引脚
     void deinitializeGpioPins();    // 反初始化GPIO引脚
@@ -134,6 +178,19 @@ class ContinuityCollector {
         uint8_t logicalPin);    // 读取单个引脚导通状态
     void configurePinsForCycle(
         uint8_t currentCycle);      // 为当前周期配置引脚模式
+    void buildScatterTable();       // 根据配置生成端口快照散射表
+    void resetAllPins();            // 按端口批量复位所有引脚为输入下拉
+    void setLogicalPinMode(uint8_t logicalPin, GpioMode mode,
+                           GpioState state = GpioState::LOW);    // 批量接口配置单个引脚
+    bool readCycleSnapshot(
+        uint64_t &cycleWord);       // 通过端口快照读取整个周期
+    uint64_t scatterPorts(
+        const uint16_t *ports) const;    // 端口字散射为行字
+    bool startTimedScan();          // 启动定时器驱动扫描
+    void collectTimedScan();        // 将定时扫描的端口快照解码到数据矩阵
+    void finishScan();              // 一次扫描完成后的处理
+    void beginScan();               // 重置周期状态，开始一次扫描
+    bool checkCycle(uint8_t cycle, uint64_t cycleWord);    // 周期检查，失败时截断矩阵
     uint32_t getCurrentTimeMs();    // 获取当前时间（毫秒）
     uint64_t getCurrentTimeUs();    // 获取当前时间（微秒）
     uint32_t getSyncTimeMs();       // 获取同步时间（毫秒）
@@ -160,6 +217,50 @@ class ContinuityCollector {
     // 处理采集状态（状态机）
     void processCollection();
 
+    /**
+     * @brief 启用定时器驱动扫描
+     * @param timer 扫描定时器（HardwareScanTimer 或 SimulatedScanTimer）
+     * @param signal 完成通知，为空时使用 TaskNotifyScanSignal
+     * 稳定时间取自 CollectorConfig::settleTimeUs（需大于0）；
+     * 要求所有检测引脚都可用端口快照采样，否则返回 false
+     */
+    bool enableTimedScan(std::unique_ptr<IScanTimer> timer,
+                         std::unique_ptr<IScanSignal> signal = nullptr);
+
+    // 关闭定时器驱动扫描，恢复轮询采集
+    void disableTimedScan();
+
+    bool isTimedScanEnabled() const { return timedEngine_ != nullptr; }
+
+    // 获取定时扫描引擎（用于测试，未启用时为空）
+    TimedScanEngine *getTimedEngine() const { return timedEngine_.get(); }
+
+    // 定时扫描模式下阻塞等待采集完成，完成后数据已写入矩阵
+    bool waitForCompletion(uint32_t timeoutMs);
+
+    /**
+     * @brief 启用连续采集模式
+     * @param depth 保存的历史帧数（1 ~ FrameRing::MAX_DEPTH），存储在此一次性分配
+     * 每次扫描完成后矩阵存入历史环，并自动开始下一次扫描，状态保持 RUNNING
+     */
+    bool enableContinuousMode(uint8_t depth);
+
+    // 关闭连续采集模式并释放历史环
+    void disableContinuousMode();
+
+    bool isContinuousMode() const { return frameRing_ != nullptr; }
+
+    // 获取历史环（未启用连续采集时为空）
+    const FrameRing *getFrameRing() const { return frameRing_.get(); }
+
+    /**
+     * @brief 编码最新一帧（相对上一历史帧做差分）
+     * @param keyFrame 强制输出完整帧（如上位机丢帧、DELTA 基准不符后重新同步）
+     * @return 写入字节数，无数据或空间不足返回 0
+     */
+    size_t encodeLatestFrame(uint8_t *out, size_t capacity,
+                             bool keyFrame = false) const;
+
     // 获取采集状态
     CollectionStatus getStatus() const;
 
@@ -169,11 +270,11 @@ class ContinuityCollector {
     // 获取总周期数
     uint8_t getTotalCycles() const;
 
-    // 获取采集数据
-    ContinuityMatrix getDataMatrix() const;
+    // 获取采集数据（零拷贝引用）
+    const ContinuityMatrix &getDataMatrix() const;
 
-    // 获取指定周期的数据
-    std::vector<ContinuityState> getCycleData(uint8_t cycle) const;
+    // 获取指定周期的数据（零拷贝视图）
+    BitMatrix64::RowView getCycleData(uint8_t cycle) const;
 
     // 检查是否有新数据
     bool hasNewData() const;
@@ -187,6 +288,16 @@ class ContinuityCollector {
     // 设置同步时间回调
     void setSyncTimeCallback(SyncTimeCallback callback);
 
+    // 设置周期检查回调（如 NetlistVerifier 提前终止），传入 nullptr 取消
+    void setCycleCheckCallback(CycleCheckCallback callback);
+
+    // 最近一次完成的扫描是否因周期检查失败而提前终止
+    // 连续采集模式下对应历史环中的最新帧，不受已开始的下一次扫描影响
+    bool isScanAborted() const { return completedAborted_; }
+
+    // 最近一次完成的扫描采集的周期数
+    uint8_t getCompletedCycles() const { return completedCycles_; }
+
     // 获取采集配置
     const CollectorConfig &getConfig() const { return config_; }
 
@@ -196,24 +307,53 @@ class ContinuityCollector {
     // 获取GPIO接口（用于测试）
     IGpio *getGpio() const { return gpio_.get(); }
 
-    // 获取压缩数据向量（按位压缩，小端模式）
+    // 获取压缩数据向量（按位压缩，大端位序）
     std::vector<uint8_t> getDataVector() const;
 
-    // 获取指定引脚的所有周期数据
-    std::vector<ContinuityState> getPinData(uint8_t pin) const;
+    // 将压缩数据写入调用者提供的缓冲区，返回写入字节数（空间不足返回0）
+    size_t getDataVector(uint8_t *out, size_t capacity) const;
+
+    // 获取指定引脚的所有周期数据（零拷贝视图）
+    BitMatrix64::ColumnView getPinData(uint8_t pin) const;
 
     // 清空数据矩阵
     void clearData();
 
     // 统计功能
+    static constexpr uint8_t TOP_ACTIVE_PINS = 5;
+    static constexpr uint8_t NO_PIN = 0xFF;
+
     struct Statistics {
         uint32_t totalConnections;       // 总导通次数
         uint32_t totalDisconnections;    // 总断开次数
-        double connectionRate;           // 导通率
-        uint8_t mostActivePins[5];       // 最活跃的5个引脚
+        uint16_t connectionRateBp;       // 导通率（万分比，10000 = 100%）
+        uint8_t mostActivePins[TOP_ACTIVE_PINS];    // 最活跃的5个引脚（导通次数降序）
+        uint8_t mostActivePinCount;      // mostActivePins 中的有效个数
+        uint8_t pinConnections[MAX_GPIO_PINS];      // 每个引脚的导通次数
+        uint8_t cycleConnections[BitMatrix64::MAX_ROWS];    // 每个周期的导通次数
+        uint16_t asymmetricPairs;        // A→B 与 B→A 结果不一致的引脚对数
+        uint8_t firstAsymmetricA;        // 第一个不一致引脚对（无则为 NO_PIN）
+        uint8_t firstAsymmetricB;
     };
 
+    // 计算统计数据（定长数组，无堆分配）
     Statistics calculateStatistics() const;
+
+    // 获取指定周期的采样时刻（同步时间，微秒），未采样返回0
+    uint64_t getCycleTimestamp(uint8_t cycle) const;
+
+    // 周期间隔统计（基于已采样周期的时间戳）
+    struct CycleTiming {
+        uint8_t cycles;            // 参与统计的周期数
+        uint32_t minSpacingUs;     // 最小周期间隔
+        uint32_t maxSpacingUs;     // 最大周期间隔
+        uint32_t meanSpacingUs;    // 平均周期间隔
+        uint32_t jitterUs;         // 抖动（最大-最小）
+        uint64_t firstTimestampUs; // 第一个周期采样时刻
+        uint64_t lastTimestampUs;  // 最后一个周期采样时刻
+    };
+
+    CycleTiming getCycleTiming() const;
 };
 
 // 导通数据采集器工厂类
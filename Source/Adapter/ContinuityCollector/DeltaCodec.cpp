@@ -0,0 +1,164 @@
+#include "DeltaCodec.h"
+
+namespace Adapter {
+
+// 64位前导零计数，调用方保证 v != 0
+static inline uint32_t countLeadingZeros64(uint64_t v) {
+    return static_cast<uint32_t>(__builtin_clzll(v));
+}
+
+size_t DeltaCodec::writeVarint(uint32_t value, uint8_t *out, size_t capacity) {
+    size_t pos = 0;
+    do {
+        if (pos >= capacity) return 0;
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        out[pos++] = value ? (byte | 0x80) : byte;
+    } while (value);
+    return pos;
+}
+
+size_t DeltaCodec::readVarint(const uint8_t *in, size_t len, uint32_t &value) {
+    value = 0;
+    for (size_t pos = 0; pos < len && pos < 5; pos++) {
+        value |= static_cast<uint32_t>(in[pos] & 0x7F) << (7 * pos);
+        if ((in[pos] & 0x80) == 0) return pos + 1;
+    }
+    return 0;
+}
+
+size_t DeltaCodec::encodeKey(const BitMatrix64 &cur, uint32_t sequence,
+                             uint8_t *out, size_t capacity) {
+    if (capacity < 3) return 0;
+    out[0] = static_cast<uint8_t>(FrameType::KEY);
+    out[1] = cur.rows();
+    out[2] = cur.cols();
+    size_t pos = 3;
+
+    size_t n = writeVarint(sequence, out + pos, capacity - pos);
+    if (n == 0) return 0;
+    pos += n;
+
+    n = cur.pack(out + pos, capacity - pos);
+    if (n == 0 && cur.packedSize() != 0) return 0;
+    return pos + n;
+}
+
+size_t DeltaCodec::encode(const BitMatrix64 *prev, uint32_t prevSequence,
+                          const BitMatrix64 &cur, uint32_t sequence,
+                          uint8_t *out, size_t capacity) {
+    if (out == nullptr) return 0;
+
+    if (prev == nullptr || prev->rows() != cur.rows() ||
+        prev->cols() != cur.cols()) {
+        return encodeKey(cur, sequence, out, capacity);
+    }
+
+    // 差分帧超过完整帧大小时没有意义，以此为上限
+    size_t keySize = maxEncodedSize(cur);
+    size_t limit = capacity < keySize ? capacity : keySize;
+
+    uint32_t flips = 0;
+    for (uint8_t r = 0; r < cur.rows(); r++) {
+        flips += static_cast<uint32_t>(
+            __builtin_popcountll(cur.rowWord(r) ^ prev->rowWord(r)));
+    }
+
+    if (limit < 3) return encodeKey(cur, sequence, out, capacity);
+    out[0] = static_cast<uint8_t>(FrameType::DELTA);
+    out[1] = cur.rows();
+    out[2] = cur.cols();
+    size_t pos = 3;
+
+    size_t n = writeVarint(sequence, out + pos, limit - pos);
+    if (n == 0) return encodeKey(cur, sequence, out, capacity);
+    pos += n;
+    n = writeVarint(prevSequence, out + pos, limit - pos);
+    if (n == 0) return encodeKey(cur, sequence, out, capacity);
+    pos += n;
+    n = writeVarint(flips, out + pos, limit - pos);
+    if (n == 0) return encodeKey(cur, sequence, out, capacity);
+    pos += n;
+
+    // 逐行取异或字，用前导零计数直接定位翻转位
+    uint32_t lastBit = 0;    // 上一个翻转位之后的位序号
+    for (uint8_t r = 0; r < cur.rows(); r++) {
+        uint64_t diff = cur.rowWord(r) ^ prev->rowWord(r);
+        uint32_t rowBase = static_cast<uint32_t>(r) * cur.cols();
+        while (diff) {
+            uint32_t pin = countLeadingZeros64(diff);
+            diff &= ~BitMatrix64::pinMask(pin);
+
+            uint32_t bit = rowBase + pin;
+            n = writeVarint(bit - lastBit, out + pos, limit - pos);
+            if (n == 0) return encodeKey(cur, sequence, out, capacity);
+            pos += n;
+            lastBit = bit + 1;
+        }
+    }
+
+    return pos;
+}
+
+bool DeltaCodec::decode(const uint8_t *in, size_t len, BitMatrix64 &frame,
+                        uint32_t &sequence, FrameType *type) {
+    if (in == nullptr || len < 4) return false;
+
+    FrameType frameType = static_cast<FrameType>(in[0]);
+    uint8_t rows = in[1];
+    uint8_t cols = in[2];
+    if (rows > BitMatrix64::MAX_ROWS || cols > BitMatrix64::MAX_COLS) {
+        return false;
+    }
+
+    size_t pos = 3;
+    uint32_t seq = 0;
+    size_t n = readVarint(in + pos, len - pos, seq);
+    if (n == 0) return false;
+    pos += n;
+
+    // 解码到副本，失败时调用方的帧保持不变
+    BitMatrix64 result;
+    if (frameType == FrameType::KEY) {
+        result.reset(rows, cols);
+        if (!result.unpack(in + pos, len - pos)) return false;
+    } else if (frameType == FrameType::DELTA) {
+        if (frame.rows() != rows || frame.cols() != cols) return false;
+
+        // 基准帧必须是调用方持有的帧，否则中间有帧丢失
+        uint32_t baseSeq = 0;
+        n = readVarint(in + pos, len - pos, baseSeq);
+        if (n == 0 || baseSeq != sequence) return false;
+        pos += n;
+
+        result = frame;
+        uint32_t flips = 0;
+        n = readVarint(in + pos, len - pos, flips);
+        if (n == 0) return false;
+        pos += n;
+
+        uint32_t totalBits = static_cast<uint32_t>(rows) * cols;
+        uint32_t bit = 0;
+        for (uint32_t i = 0; i < flips; i++) {
+            uint32_t gap = 0;
+            n = readVarint(in + pos, len - pos, gap);
+            if (n == 0) return false;
+            pos += n;
+
+            bit += gap;
+            if (bit >= totalBits) return false;
+            result.flip(static_cast<uint8_t>(bit / cols),
+                       static_cast<uint8_t>(bit % cols));
+            bit++;
+        }
+    } else {
+        return false;
+    }
+
+    frame = result;
+    sequence = seq;
+    if (type) *type = frameType;
+    return true;
+}
+
+}    // namespace Adapter
@@ -0,0 +1,75 @@
+#ifndef DELTA_CODEC_H
+#define DELTA_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "BitMatrix64.h"
+
+namespace Adapter {
+
+/**
+ * @brief 导通矩阵帧间差分编解码
+ *
+ * 帧格式：
+ *   [0]    帧类型（KEY / DELTA）
+ *   [1]    周期数 rows
+ *   [2]    引脚数 cols
+ *   [3..]  帧序号（LEB128 变长整数）
+ *   KEY:   BitMatrix64::pack() 位流
+ *   DELTA: 基准帧序号（LEB128），翻转位数量（LEB128），随后每个翻转位前的
+ *          连续未变位数（LEB128），位序与 pack() 相同（周期优先，引脚 0 在前）
+ *
+ * 与上一帧相同时 DELTA 帧只有 6~14 字节；差分比完整帧大时自动退回 KEY 帧。
+ * 解码端持有的帧序号与基准帧序号不符（中间丢帧）时拒绝该 DELTA 帧，
+ * 上位机应请求 KEY 帧重新同步。
+ * 本文件只依赖 BitMatrix64，可直接在上位机编译用于解码。
+ */
+class DeltaCodec {
+   public:
+    enum class FrameType : uint8_t {
+        KEY = 0,      // 完整帧
+        DELTA = 1     // 相对上一帧的差分
+    };
+
+    // KEY 帧头最大长度；DELTA 帧不会超过同尺寸 KEY 帧
+    static constexpr size_t HEADER_MAX_SIZE = 3 + 5;
+
+    // 编码一帧所需的最大缓冲区大小
+    static size_t maxEncodedSize(const BitMatrix64 &frame) {
+        return HEADER_MAX_SIZE + frame.packedSize();
+    }
+
+    /**
+     * @brief 编码一帧
+     * @param prev         差分基准帧，为 nullptr 或尺寸不同时输出 KEY 帧
+     * @param prevSequence 基准帧序号，写入 DELTA 帧头
+     * @param cur          当前帧
+     * @param sequence     帧序号
+     * @return 写入字节数，缓冲区不足返回 0
+     */
+    static size_t encode(const BitMatrix64 *prev, uint32_t prevSequence,
+                         const BitMatrix64 &cur, uint32_t sequence,
+                         uint8_t *out, size_t capacity);
+
+    /**
+     * @brief 解码一帧
+     * @param frame    输入为上一帧（DELTA 帧的基准），输出为解码结果
+     * @param sequence 输入为 frame 的帧序号，输出为解码帧序号
+     * @param type     输出帧类型，可为 nullptr
+     * @return 数据损坏，或 DELTA 帧与 frame 尺寸、基准序号不符时返回 false，
+     *         此时 frame 与 sequence 不变
+     */
+    static bool decode(const uint8_t *in, size_t len, BitMatrix64 &frame,
+                       uint32_t &sequence, FrameType *type = nullptr);
+
+   private:
+    static size_t writeVarint(uint32_t value, uint8_t *out, size_t capacity);
+    static size_t readVarint(const uint8_t *in, size_t len, uint32_t &value);
+    static size_t encodeKey(const BitMatrix64 &cur, uint32_t sequence,
+                            uint8_t *out, size_t capacity);
+};
+
+}    // namespace Adapter
+
+#endif    // DELTA_CODEC_H
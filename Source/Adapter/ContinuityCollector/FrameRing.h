@@ -0,0 +1,80 @@
+#ifndef FRAME_RING_H
+#define FRAME_RING_H
+
+#include <cstdint>
+#include <memory>
+
+#include "BitMatrix64.h"
+
+namespace Adapter {
+
+/**
+ * @brief 导通矩阵历史环形缓冲
+ *
+ * 连续采集模式下保存最近 N 帧完整矩阵。存储在 init() 时一次性分配，
+ * 之后 push() 只做定长拷贝，采集过程中不再产生堆操作。
+ */
+class FrameRing {
+   public:
+    static constexpr uint8_t MAX_DEPTH = 16;
+
+    struct Frame {
+        uint32_t sequence;       // 帧序号（从 1 开始递增）
+        uint64_t timestampUs;    // 首个周期采样时刻（同步时间）
+        BitMatrix64 matrix;      // 完整矩阵
+    };
+
+    // 分配 depth 帧存储并清空
+    bool init(uint8_t depth) {
+        if (depth == 0 || depth > MAX_DEPTH) return false;
+        frames_ = std::make_unique<Frame[]>(depth);
+        depth_ = depth;
+        clear();
+        return true;
+    }
+
+    void clear() {
+        head_ = 0;
+        count_ = 0;
+        nextSequence_ = 1;
+    }
+
+    // 写入新帧，缓冲满时覆盖最旧帧，返回新帧序号
+    uint32_t push(const BitMatrix64 &matrix, uint64_t timestampUs) {
+        if (depth_ == 0) return 0;
+        Frame &frame = frames_[head_];
+        frame.sequence = nextSequence_++;
+        frame.timestampUs = timestampUs;
+        frame.matrix = matrix;
+        head_ = (head_ + 1) % depth_;
+        if (count_ < depth_) count_++;
+        return frame.sequence;
+    }
+
+    uint8_t depth() const { return depth_; }
+    uint8_t count() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    // 最新帧序号，无数据时为 0
+    uint32_t latestSequence() const { return nextSequence_ - 1; }
+
+    // age = 0 为最新帧，超出已有帧数返回 nullptr
+    const Frame *get(uint8_t age) const {
+        if (age >= count_) return nullptr;
+        uint8_t index = (head_ + depth_ - 1 - age) % depth_;
+        return &frames_[index];
+    }
+
+    const Frame *latest() const { return get(0); }
+
+   private:
+    std::unique_ptr<Frame[]> frames_;
+    uint8_t depth_ = 0;
+    uint8_t head_ = 0;     // 下一个写入位置
+    uint8_t count_ = 0;    // 有效帧数
+    uint32_t nextSequence_ = 1;
+};
+
+}    // namespace Adapter
+
+#endif    // FRAME_RING_H
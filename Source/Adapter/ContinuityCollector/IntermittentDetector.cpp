@@ -0,0 +1,159 @@
+#include "IntermittentDetector.h"
+
+namespace Adapter {
+
+// 取出行字中最高位（最小引脚号）的置位引脚，调用方保证 word != 0
+static inline uint8_t popFirstPin(uint64_t &word) {
+    uint8_t pin = static_cast<uint8_t>(__builtin_clzll(word));
+    word &= ~BitMatrix64::pinMask(pin);
+    return pin;
+}
+
+bool IntermittentDetector::init(uint8_t rows, uint8_t cols,
+                                const Config &config) {
+    if (rows == 0 || cols == 0 || rows > BitMatrix64::MAX_ROWS ||
+        cols > BitMatrix64::MAX_COLS) {
+        return false;
+    }
+
+    size_t pairs = static_cast<size_t>(rows) * cols;
+    if (!stats_ || static_cast<size_t>(rows_) * cols_ != pairs) {
+        stats_ = std::make_unique<PairStats[]>(pairs);
+    }
+    rows_ = rows;
+    cols_ = cols;
+    config_ = config;
+    reset();
+    return true;
+}
+
+void IntermittentDetector::reset() {
+    size_t pairs = static_cast<size_t>(rows_) * cols_;
+    for (size_t i = 0; i < pairs; i++) {
+        stats_[i] = {};
+    }
+    last_.reset(rows_, cols_);
+    flakyMap_.reset(rows_, cols_);
+    frameCount_ = 0;
+    flakyCount_ = 0;
+    lastFrameMs_ = 0;
+}
+
+void IntermittentDetector::onFlip(uint8_t cycle, uint8_t pin, bool connected,
+                                  uint32_t nowMs) {
+    PairStats &s = stats(cycle, pin);
+
+    // 结束上一个稳定段
+    uint32_t run = frameCount_ - s.runStart;
+    if (run > s.longestRun) s.longestRun = run;
+    s.runStart = frameCount_;
+    s.flips++;
+
+    if (connected) {
+        if (s.firstSeenMs == 0) s.firstSeenMs = nowMs;
+    } else {
+        // 上一帧仍为导通
+        s.lastSeenMs = lastFrameMs_;
+    }
+
+    // 翻转率只在翻转时升高，达到 minFrames 之后只需在此判定；
+    // 之前的翻转由 update() 在帧数达到 minFrames 时统一补判
+    checkFlaky(cycle, pin, frameCount_ + 1);
+}
+
+void IntermittentDetector::checkFlaky(uint8_t cycle, uint8_t pin,
+                                      uint32_t frames) {
+    const PairStats &s = stats(cycle, pin);
+    if (!isFlaky(cycle, pin) && s.flips >= config_.minFlips &&
+        frames >= config_.minFrames &&
+        static_cast<uint64_t>(s.flips) * 1000 >=
+            static_cast<uint64_t>(config_.flipRatePermille) * frames) {
+        flakyMap_.set(cycle, pin, ContinuityState::CONNECTED);
+        flakyCount_++;
+    }
+}
+
+uint32_t IntermittentDetector::update(const BitMatrix64 &frame,
+                                      uint64_t timestampUs) {
+    if (!stats_ || frame.rows() != rows_ || frame.cols() != cols_) {
+        return 0;
+    }
+
+    uint32_t nowMs = static_cast<uint32_t>(timestampUs / 1000);
+    uint32_t changed = 0;
+
+    if (frameCount_ == 0) {
+        // 第一帧作为基准，只记录导通引脚对的首次导通时间
+        for (uint8_t r = 0; r < rows_; r++) {
+            uint64_t word = frame.rowWord(r);
+            while (word) {
+                stats(r, popFirstPin(word)).firstSeenMs = nowMs;
+            }
+        }
+    } else {
+        for (uint8_t r = 0; r < rows_; r++) {
+            uint64_t cur = frame.rowWord(r);
+            uint64_t diff = cur ^ last_.rowWord(r);
+            if (diff == 0) continue;
+
+            changed += static_cast<uint32_t>(__builtin_popcountll(diff));
+            while (diff) {
+                uint8_t pin = popFirstPin(diff);
+                onFlip(r, pin, (cur & BitMatrix64::pinMask(pin)) != 0, nowMs);
+            }
+        }
+    }
+
+    last_ = frame;
+    lastFrameMs_ = nowMs;
+    frameCount_++;
+
+    // 未满 minFrames 时的翻转没有判定，此时补判一次（每次 reset 后只执行一次）
+    if (frameCount_ == config_.minFrames && frameCount_ > 1) {
+        for (uint8_t r = 0; r < rows_; r++) {
+            for (uint8_t p = 0; p < cols_; p++) {
+                if (stats(r, p).flips != 0) checkFlaky(r, p, frameCount_);
+            }
+        }
+    }
+    return changed;
+}
+
+bool IntermittentDetector::getPair(uint8_t cycle, uint8_t pin,
+                                   PairReport &report) const {
+    if (!stats_ || cycle >= rows_ || pin >= cols_) {
+        return false;
+    }
+
+    const PairStats &s = stats(cycle, pin);
+    bool connected = last_.get(cycle, pin) == ContinuityState::CONNECTED;
+
+    // 当前稳定段尚未结束，查询时补齐
+    uint32_t run = frameCount_ - s.runStart;
+
+    report.cycle = cycle;
+    report.pin = pin;
+    report.connected = connected;
+    report.flaky = isFlaky(cycle, pin);
+    report.flips = s.flips;
+    report.longestStableRun = run > s.longestRun ? run : s.longestRun;
+    report.firstSeenMs = s.firstSeenMs;
+    report.lastSeenMs = connected ? lastFrameMs_ : s.lastSeenMs;
+    return true;
+}
+
+size_t IntermittentDetector::getFlakyPairs(PairReport *out,
+                                           size_t capacity) const {
+    if (out == nullptr) return 0;
+
+    size_t count = 0;
+    for (uint8_t r = 0; r < rows_ && count < capacity; r++) {
+        uint64_t word = flakyMap_.rowWord(r);
+        while (word && count < capacity) {
+            getPair(r, popFirstPin(word), out[count++]);
+        }
+    }
+    return count;
+}
+
+}    // namespace Adapter
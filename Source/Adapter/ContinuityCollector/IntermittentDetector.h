@@ -0,0 +1,115 @@
+#ifndef INTERMITTENT_DETECTOR_H
+#define INTERMITTENT_DETECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "BitMatrix64.h"
+
+namespace Adapter {
+
+/**
+ * @brief 间歇接触检测器
+ *
+ * 跨多次扫描累计每个引脚对（驱动周期 x 检测引脚）的统计：
+ * 翻转次数、最长稳定帧数、首次/最后一次导通时间。
+ * 每帧与上一帧逐行异或，只处理发生变化的位，单帧开销为 O(变化位数)；
+ * 未变化的引脚对在查询时按当前帧补齐统计。
+ * 累计帧数达到 minFrames 后，翻转率超过阈值的引脚对被标记为间歇接触
+ * （标记保持到 reset）；之前发生的翻转在第 minFrames 帧统一判定。
+ */
+class IntermittentDetector {
+   public:
+    struct Config {
+        uint16_t minFlips;            // 标记所需的最少翻转次数
+        uint16_t flipRatePermille;    // 翻转率阈值（翻转次数/帧数，千分比）
+        uint32_t minFrames;           // 开始判定前的最少帧数
+
+        Config(uint16_t flips = 2, uint16_t ratePermille = 50,
+               uint32_t frames = 8)
+            : minFlips(flips),
+              flipRatePermille(ratePermille),
+              minFrames(frames) {}
+    };
+
+    // 单个引脚对的统计结果
+    struct PairReport {
+        uint8_t cycle;                // 驱动周期
+        uint8_t pin;                  // 检测引脚
+        bool connected;               // 最新一帧状态
+        bool flaky;                   // 是否已标记为间歇接触
+        uint32_t flips;               // 翻转次数
+        uint32_t longestStableRun;    // 最长稳定帧数
+        uint32_t firstSeenMs;         // 首次导通时间（同步时间，毫秒，0=从未导通）
+        uint32_t lastSeenMs;          // 最后一次导通时间
+    };
+
+    /**
+     * @brief 分配统计存储（rows x cols 个引脚对，每个 20 字节）
+     * 只在配置阶段调用一次，update() 过程中不再分配
+     */
+    bool init(uint8_t rows, uint8_t cols, const Config &config = Config());
+
+    // 清空所有统计，保留尺寸和阈值
+    void reset();
+
+    /**
+     * @brief 输入新的一帧
+     * @param frame       扫描矩阵，尺寸必须与 init() 一致
+     * @param timestampUs 该帧采样时间（同步时间，微秒）
+     * @return 相对上一帧变化的位数，尺寸不符返回 0
+     */
+    uint32_t update(const BitMatrix64 &frame, uint64_t timestampUs);
+
+    uint32_t frameCount() const { return frameCount_; }
+    uint32_t flakyCount() const { return flakyCount_; }
+
+    // 间歇接触标记矩阵（置位即为被标记的引脚对）
+    const BitMatrix64 &flakyMap() const { return flakyMap_; }
+
+    bool isFlaky(uint8_t cycle, uint8_t pin) const {
+        return flakyMap_.get(cycle, pin) == ContinuityState::CONNECTED;
+    }
+
+    // 查询单个引脚对
+    bool getPair(uint8_t cycle, uint8_t pin, PairReport &report) const;
+
+    // 列出被标记的引脚对，返回写入数量
+    size_t getFlakyPairs(PairReport *out, size_t capacity) const;
+
+   private:
+    struct PairStats {
+        uint32_t flips;          // 翻转次数
+        uint32_t runStart;       // 当前稳定段起始帧
+        uint32_t longestRun;     // 已结束稳定段中的最长帧数
+        uint32_t firstSeenMs;    // 首次导通时间
+        uint32_t lastSeenMs;     // 最后一次导通时间（当前导通时以最新帧为准）
+    };
+
+    PairStats &stats(uint8_t cycle, uint8_t pin) {
+        return stats_[static_cast<size_t>(cycle) * cols_ + pin];
+    }
+    const PairStats &stats(uint8_t cycle, uint8_t pin) const {
+        return stats_[static_cast<size_t>(cycle) * cols_ + pin];
+    }
+
+    void onFlip(uint8_t cycle, uint8_t pin, bool connected, uint32_t nowMs);
+    // 按 frames 帧计算翻转率，超过阈值时标记
+    void checkFlaky(uint8_t cycle, uint8_t pin, uint32_t frames);
+
+    Config config_;
+    std::unique_ptr<PairStats[]> stats_;
+    uint8_t rows_ = 0;
+    uint8_t cols_ = 0;
+
+    BitMatrix64 last_;        // 上一帧
+    BitMatrix64 flakyMap_;    // 间歇接触标记
+    uint32_t frameCount_ = 0;
+    uint32_t flakyCount_ = 0;
+    uint32_t lastFrameMs_ = 0;    // 上一帧时间
+};
+
+}    // namespace Adapter
+
+#endif    // INTERMITTENT_DETECTOR_H
@@ -0,0 +1,215 @@
+#include "NetlistVerifier.h"
+
+#include "Logger.h"
+#include "json.hpp"
+
+namespace Adapter {
+
+// 取出字中最高位（最小引脚号）的置位引脚，调用方保证 word != 0
+static inline uint8_t popFirstPin(uint64_t &word) {
+    uint8_t pin = static_cast<uint8_t>(__builtin_clzll(word));
+    word &= ~BitMatrix64::pinMask(pin);
+    return pin;
+}
+
+// 将一组引脚合并为同一网络，pinNets[p] 保存与 p 导通的全部引脚
+static bool mergeNet(const nlohmann::json &pins, uint8_t num,
+                     std::array<uint64_t, BitMatrix64::MAX_COLS> &pinNets) {
+    if (!pins.is_array()) return false;
+
+    uint64_t merged = 0;
+    for (const auto &pin : pins) {
+        if (!pin.is_number_unsigned()) return false;
+        uint32_t p = pin.get<uint32_t>();
+        if (p >= num) return false;
+        merged |= pinNets[p];
+    }
+
+    uint64_t members = merged;
+    while (members) {
+        pinNets[popFirstPin(members)] = merged;
+    }
+    return true;
+}
+
+bool NetlistVerifier::loadSpec(const char *json, size_t len,
+                               const CollectorConfig &config) {
+    loaded_ = false;
+    if (json == nullptr || config.num == 0 ||
+        config.num > BitMatrix64::MAX_COLS) {
+        return false;
+    }
+
+    // 不抛异常的解析方式（固件以 -fno-exceptions 编译）
+    nlohmann::json spec = nlohmann::json::parse(json, json + len, nullptr, false);
+    if (spec.is_discarded() || !spec.is_object()) {
+        LOGE("NetlistVerifier", "invalid netlist json");
+        return false;
+    }
+
+    std::array<uint64_t, BitMatrix64::MAX_COLS> pinNets;
+    for (uint8_t p = 0; p < BitMatrix64::MAX_COLS; p++) {
+        pinNets[p] = BitMatrix64::pinMask(p);
+    }
+
+    for (const char *key : {"nets", "connections"}) {
+        auto it = spec.find(key);
+        if (it == spec.end()) continue;
+        if (!it->is_array()) return false;
+        for (const auto &net : *it) {
+            if (!mergeNet(net, config.num, pinNets)) {
+                LOGE("NetlistVerifier", "invalid net in '%s'", key);
+                return false;
+            }
+        }
+    }
+
+    buildExpected(pinNets, config);
+    return true;
+}
+
+void NetlistVerifier::buildExpected(
+    const std::array<uint64_t, BitMatrix64::MAX_COLS> &pinNets,
+    const CollectorConfig &config) {
+    expected_.reset(config.totalDetectionNum, config.num);
+    startDetectionNum_ = config.startDetectionNum;
+
+    // 周期 startDetectionNum + d 驱动逻辑引脚 d，其余周期不驱动，期望全部断开
+    for (uint8_t cycle = 0; cycle < expected_.rows(); cycle++) {
+        if (cycle >= config.startDetectionNum &&
+            cycle < config.startDetectionNum + config.num) {
+            expected_.setRow(cycle, pinNets[cycle - config.startDetectionNum]);
+        }
+    }
+
+    result_ = {};
+    loaded_ = true;
+}
+
+bool NetlistVerifier::setExpected(const BitMatrix64 &expected,
+                                  const CollectorConfig &config) {
+    if (expected.rows() != config.totalDetectionNum ||
+        expected.cols() != config.num) {
+        return false;
+    }
+    expected_ = expected;
+    startDetectionNum_ = config.startDetectionNum;
+    result_ = {};
+    loaded_ = true;
+    return true;
+}
+
+void NetlistVerifier::attach(ContinuityCollector &collector) {
+    if (!earlyAbort_) {
+        collector.setCycleCheckCallback(nullptr);
+        return;
+    }
+    collector.setCycleCheckCallback(
+        [this](uint8_t cycle, uint64_t cycleWord) {
+            return checkCycle(cycle, cycleWord);
+        });
+}
+
+void NetlistVerifier::addFault(FaultType type, uint8_t drivePin,
+                               uint8_t expectedPin, uint8_t actualPin) {
+    switch (type) {
+        case FaultType::OPEN:
+            result_.opens++;
+            break;
+        case FaultType::SHORT:
+            result_.shorts++;
+            break;
+        case FaultType::MISWIRE:
+            result_.miswires++;
+            break;
+    }
+    if (result_.faultCount < MAX_FAULTS) {
+        faults_[result_.faultCount++] = {type, drivePin, expectedPin,
+                                         actualPin};
+    }
+}
+
+const NetlistVerifier::Result &NetlistVerifier::verify(const BitMatrix64 &scan,
+                                                       uint8_t cycles,
+                                                       bool aborted) {
+    result_ = {};
+    if (!loaded_ || scan.rows() != expected_.rows() ||
+        scan.cols() != expected_.cols()) {
+        return result_;
+    }
+    if (cycles > scan.rows()) cycles = scan.rows();
+
+    for (uint8_t cycle = 0; cycle < cycles; cycle++) {
+        uint64_t actual = scan.rowWord(cycle);
+        uint64_t expect = expected_.rowWord(cycle);
+        if (actual == expect) continue;
+
+        uint8_t drivePin = NO_PIN;
+        if (cycle >= startDetectionNum_ &&
+            cycle - startDetectionNum_ < expected_.cols()) {
+            drivePin = cycle - startDetectionNum_;
+        }
+
+        // 同一驱动引脚下缺失点与多余点成对记为错线，剩余分别为开路/短路
+        uint64_t missing = expect & ~actual;
+        uint64_t extra = actual & ~expect;
+        while (missing && extra) {
+            uint8_t expectedPin = popFirstPin(missing);
+            uint8_t actualPin = popFirstPin(extra);
+            addFault(FaultType::MISWIRE, drivePin, expectedPin, actualPin);
+        }
+        while (missing) {
+            addFault(FaultType::OPEN, drivePin, popFirstPin(missing), NO_PIN);
+        }
+        while (extra) {
+            addFault(FaultType::SHORT, drivePin, NO_PIN, popFirstPin(extra));
+        }
+    }
+
+    result_.checkedCycles = cycles;
+    result_.aborted = aborted || cycles < scan.rows();
+    result_.pass = !result_.aborted && result_.opens == 0 &&
+                   result_.shorts == 0 && result_.miswires == 0;
+    return result_;
+}
+
+const NetlistVerifier::Result &NetlistVerifier::verify(
+    const ContinuityCollector &collector) {
+    // 连续采集模式下完成一帧后立即开始下一次扫描，当前矩阵和周期已被重置
+    const FrameRing *ring = collector.getFrameRing();
+    if (ring != nullptr) {
+        const FrameRing::Frame *frame = ring->latest();
+        if (frame == nullptr) {
+            result_ = {};
+            return result_;
+        }
+        return verify(frame->matrix, collector.getCompletedCycles(),
+                      collector.isScanAborted());
+    }
+    return verify(collector.getDataMatrix(), collector.getCompletedCycles(),
+                  collector.isScanAborted());
+}
+
+size_t NetlistVerifier::encodeReport(uint8_t *out, size_t capacity) const {
+    size_t size = 4 + static_cast<size_t>(result_.faultCount) * sizeof(Fault);
+    if (out == nullptr || capacity < size) return 0;
+
+    uint32_t total = result_.opens + result_.shorts + result_.miswires;
+    out[0] = (result_.pass ? 0x01 : 0) | (result_.aborted ? 0x02 : 0) |
+             (total > result_.faultCount ? 0x04 : 0);
+    out[1] = result_.checkedCycles;
+    out[2] = static_cast<uint8_t>(result_.faultCount & 0xFF);
+    out[3] = static_cast<uint8_t>(result_.faultCount >> 8);
+
+    size_t pos = 4;
+    for (uint16_t i = 0; i < result_.faultCount; i++) {
+        const Fault &fault = faults_[i];
+        out[pos++] = static_cast<uint8_t>(fault.type);
+        out[pos++] = fault.drivePin;
+        out[pos++] = fault.expectedPin;
+        out[pos++] = fault.actualPin;
+    }
+    return pos;
+}
+
+}    // namespace Adapter
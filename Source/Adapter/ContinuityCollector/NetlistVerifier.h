@@ -0,0 +1,121 @@
+#ifndef NETLIST_VERIFIER_H
+#define NETLIST_VERIFIER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "BitMatrix64.h"
+#include "ContinuityCollector.h"
+
+namespace Adapter {
+
+/**
+ * @brief 期望网表比对
+ *
+ * 配置阶段由 JSON 网表生成期望导通矩阵，每次扫描完成后逐行异或比对，
+ * 只输出开路、短路和错线三类故障的紧凑列表。
+ *
+ * JSON 格式（逻辑引脚号）：
+ *   {
+ *     "nets": [[0, 1, 2], [3, 4]],       // 同一网络内引脚两两导通
+ *     "connections": [[5, 6]]            // 可选，追加两点连接
+ *   }
+ * 未出现在任何网络中的引脚只与自身导通。
+ */
+class NetlistVerifier {
+   public:
+    static constexpr size_t MAX_FAULTS = 64;
+    static constexpr uint8_t NO_PIN = 0xFF;
+
+    enum class FaultType : uint8_t {
+        OPEN = 0,       // 期望导通但未导通
+        SHORT = 1,      // 不应导通但导通
+        MISWIRE = 2     // 同一驱动引脚缺失一个期望点、多出一个意外点
+    };
+
+    // 故障记录，4 字节，可直接上传
+    struct Fault {
+        FaultType type;
+        uint8_t drivePin;       // 驱动的逻辑引脚
+        uint8_t expectedPin;    // 期望导通的引脚（SHORT 为 NO_PIN）
+        uint8_t actualPin;      // 实际导通的引脚（OPEN 为 NO_PIN）
+    };
+
+    struct Result {
+        bool pass;                // 全部一致
+        bool aborted;             // 扫描因首个不一致提前终止
+        uint8_t checkedCycles;    // 参与比对的周期数
+        uint16_t opens;
+        uint16_t shorts;
+        uint16_t miswires;
+        uint16_t faultCount;      // faults() 中的记录数（超过 MAX_FAULTS 时截断）
+    };
+
+    /**
+     * @brief 从 JSON 网表生成期望矩阵
+     * @param config 采集配置，决定矩阵尺寸和各周期驱动的引脚
+     * @return JSON 格式错误或引脚号超出 config.num 时返回 false
+     */
+    bool loadSpec(const char *json, size_t len, const CollectorConfig &config);
+
+    // 直接设置期望矩阵（例如由已知良品扫描得到）
+    bool setExpected(const BitMatrix64 &expected, const CollectorConfig &config);
+
+    const BitMatrix64 &expected() const { return expected_; }
+    bool isLoaded() const { return loaded_; }
+
+    // 发现第一个不一致周期时立即停止扫描
+    void setEarlyAbort(bool enable) { earlyAbort_ = enable; }
+
+    /**
+     * @brief 挂接到采集器，启用提前终止时在每个周期采样后比对
+     * 定时扫描模式下比对发生在整次扫描解码时
+     */
+    void attach(ContinuityCollector &collector);
+
+    // 单周期比对，一致返回 true
+    bool checkCycle(uint8_t cycle, uint64_t cycleWord) const {
+        return cycle >= expected_.rows() ||
+               cycleWord == expected_.rowWord(cycle);
+    }
+
+    /**
+     * @brief 比对一次扫描结果
+     * @param scan   扫描矩阵
+     * @param cycles  有效周期数（提前终止时小于总周期数）
+     * @param aborted 扫描被提前终止（在最后一个周期终止时 cycles 等于总周期数）
+     */
+    const Result &verify(const BitMatrix64 &scan, uint8_t cycles,
+                         bool aborted = false);
+
+    // 比对采集器最近完成的一帧（连续采集模式下为历史环最新帧）
+    const Result &verify(const ContinuityCollector &collector);
+
+    const Result &result() const { return result_; }
+    const Fault *faults() const { return faults_.data(); }
+
+    /**
+     * @brief 输出紧凑报告：[标志][周期数][故障数 u16 LE][Fault x N]
+     * 标志位 bit0=pass，bit1=aborted，bit2=故障列表被截断
+     * @return 写入字节数，空间不足返回 0
+     */
+    size_t encodeReport(uint8_t *out, size_t capacity) const;
+
+   private:
+    void addFault(FaultType type, uint8_t drivePin, uint8_t expectedPin,
+                  uint8_t actualPin);
+    void buildExpected(const std::array<uint64_t, BitMatrix64::MAX_COLS> &pinNets,
+                       const CollectorConfig &config);
+
+    BitMatrix64 expected_;
+    std::array<Fault, MAX_FAULTS> faults_{};
+    Result result_{};
+    uint8_t startDetectionNum_ = 0;
+    bool earlyAbort_ = false;
+    bool loaded_ = false;
+};
+
+}    // namespace Adapter
+
+#endif    // NETLIST_VERIFIER_H
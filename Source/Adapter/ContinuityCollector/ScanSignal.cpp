@@ -0,0 +1,38 @@
+#include "ScanSignal.h"
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+// 扫描完成使用的任务通知索引，与日志、SPI、UART、高精度定时器的索引互不重叠
+#define SCAN_NOTIFY_INDEX 3
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES < 5
+#error "TaskNotifyScanSignal needs a dedicated task notification index"
+#endif
+
+namespace Adapter {
+
+bool TaskNotifyScanSignal::wait(Predicate done, void *arg,
+                                uint32_t timeoutMs) {
+    // 先登记等待任务再检查条件，避免错过通知；唤醒后重新检查直到超时
+    waitingTask_ = xTaskGetCurrentTaskHandle();
+    TimeOut_t timeOut;
+    vTaskSetTimeOutState(&timeOut);
+    TickType_t remaining = pdMS_TO_TICKS(timeoutMs);
+    while (!done(arg) && xTaskCheckForTimeOut(&timeOut, &remaining) == pdFALSE) {
+        ulTaskNotifyTakeIndexed(SCAN_NOTIFY_INDEX, pdTRUE, remaining);
+    }
+    waitingTask_ = nullptr;
+    return done(arg);
+}
+
+void TaskNotifyScanSignal::notifyFromIsr() {
+    TaskHandle_t task = static_cast<TaskHandle_t>(waitingTask_);
+    if (task != nullptr) {
+        BaseType_t higherPriorityTaskWoken = pdFALSE;
+        vTaskNotifyGiveIndexedFromISR(task, SCAN_NOTIFY_INDEX,
+                                      &higherPriorityTaskWoken);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    }
+}
+
+}    // namespace Adapter
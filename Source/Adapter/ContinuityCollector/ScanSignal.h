@@ -0,0 +1,67 @@
+#ifndef SCAN_SIGNAL_H
+#define SCAN_SIGNAL_H
+
+#include <cstdint>
+
+#include "ScanTimer.h"
+
+namespace Adapter {
+
+/**
+ * @brief 扫描完成通知接口
+ *
+ * 把“任务阻塞等待、定时器回调唤醒”与 RTOS 解耦，使 TimedScanEngine
+ * 可以在主机上配合 SimulatedScanTimer 运行。
+ */
+class IScanSignal {
+   public:
+    using Predicate = bool (*)(void *arg);
+
+    virtual ~IScanSignal() = default;
+
+    // 任务上下文：阻塞直到 done(arg) 为真或超时，返回 done(arg)
+    virtual bool wait(Predicate done, void *arg, uint32_t timeoutMs) = 0;
+
+    // 定时器回调（中断上下文）中调用，唤醒 wait()
+    virtual void notifyFromIsr() = 0;
+};
+
+// 基于任务通知的实现，使用专用通知索引
+class TaskNotifyScanSignal : public IScanSignal {
+   public:
+    bool wait(Predicate done, void *arg, uint32_t timeoutMs) override;
+    void notifyFromIsr() override;
+
+   private:
+    void *volatile waitingTask_ = nullptr;
+};
+
+/**
+ * @brief 仿真通知，配合 SimulatedScanTimer 使用
+ *
+ * wait() 直接推进虚拟时间，直到条件满足或虚拟时间超时。
+ */
+class SimulatedScanSignal : public IScanSignal {
+   public:
+    explicit SimulatedScanSignal(SimulatedScanTimer *timer) : timer_(timer) {}
+
+    bool wait(Predicate done, void *arg, uint32_t timeoutMs) override {
+        uint64_t deadline = timer_->nowUs64() + timeoutMs * 1000ULL;
+        while (!done(arg) && timer_->nowUs64() < deadline) {
+            timer_->advanceUs(1);
+        }
+        return done(arg);
+    }
+
+    void notifyFromIsr() override { notifyCount_++; }
+
+    uint32_t notifyCount() const { return notifyCount_; }
+
+   private:
+    SimulatedScanTimer *timer_;
+    uint32_t notifyCount_ = 0;
+};
+
+}    // namespace Adapter
+
+#endif    // SCAN_SIGNAL_H
@@ -0,0 +1,22 @@
+#include "ScanTimer.h"
+
+#include "hal_hptimer.hpp"
+#include "hal_scan_timer.hpp"
+
+namespace Adapter {
+
+bool HardwareScanTimer::start(uint32_t periodUs, uint32_t settleUs,
+                              Callback onUpdate, Callback onCompare,
+                              void *arg) {
+    return hal_scan_timer_start(periodUs, settleUs, onUpdate, onCompare, arg);
+}
+
+void HardwareScanTimer::stop() { hal_scan_timer_stop(); }
+
+bool HardwareScanTimer::isRunning() const {
+    return hal_scan_timer_is_running();
+}
+
+uint32_t HardwareScanTimer::nowUs() const { return hal_hptimer_get_us(); }
+
+}    // namespace Adapter
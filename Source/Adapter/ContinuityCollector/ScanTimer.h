@@ -0,0 +1,120 @@
+#ifndef SCAN_TIMER_H
+#define SCAN_TIMER_H
+
+#include <cstdint>
+
+namespace Adapter {
+
+/**
+ * @brief 扫描定时器接口
+ *
+ * 每个周期产生两个事件：
+ *   - compare：周期开始后 settleUs 微秒，用于采样
+ *   - update：周期结束，用于切换到下一个驱动引脚
+ * 回调在中断上下文（硬件）或模拟时间推进中（仿真）执行。
+ */
+class IScanTimer {
+   public:
+    using Callback = void (*)(void *arg);
+
+    virtual ~IScanTimer() = default;
+
+    virtual bool start(uint32_t periodUs, uint32_t settleUs, Callback onUpdate,
+                       Callback onCompare, void *arg) = 0;
+    virtual void stop() = 0;
+    virtual bool isRunning() const = 0;
+
+    // 当前时间（微秒，32位回绕），可在回调中调用，用于记录采样时刻
+    virtual uint32_t nowUs() const = 0;
+};
+
+// 基于 TIMER4 的硬件实现
+class HardwareScanTimer : public IScanTimer {
+   public:
+    bool start(uint32_t periodUs, uint32_t settleUs, Callback onUpdate,
+               Callback onCompare, void *arg) override;
+    void stop() override;
+    bool isRunning() const override;
+    uint32_t nowUs() const override;
+};
+
+/**
+ * @brief 仿真扫描定时器，配合 VirtualGpio 使用
+ *
+ * 不依赖硬件，由调用者推进虚拟时间，按时间顺序触发 compare/update 事件。
+ */
+class SimulatedScanTimer : public IScanTimer {
+   public:
+    bool start(uint32_t periodUs, uint32_t settleUs, Callback onUpdate,
+               Callback onCompare, void *arg) override {
+        if (running_ || periodUs < 2 || settleUs == 0 || settleUs >= periodUs) {
+            return false;
+        }
+        periodUs_ = periodUs;
+        settleUs_ = settleUs;
+        onUpdate_ = onUpdate;
+        onCompare_ = onCompare;
+        arg_ = arg;
+        periodStartUs_ = nowUs_;
+        compareFired_ = false;
+        running_ = true;
+        return true;
+    }
+
+    void stop() override { running_ = false; }
+
+    bool isRunning() const override { return running_; }
+
+    // 推进虚拟时间，期间到期的事件按顺序触发
+    void advanceUs(uint64_t us) {
+        uint64_t target = nowUs_ + us;
+        while (running_) {
+            uint64_t next = compareFired_ ? periodStartUs_ + periodUs_
+                                          : periodStartUs_ + settleUs_;
+            if (next > target) break;
+            nowUs_ = next;
+            if (!compareFired_) {
+                compareFired_ = true;
+                compareCount_++;
+                if (onCompare_) onCompare_(arg_);
+            } else {
+                periodStartUs_ = next;
+                compareFired_ = false;
+                updateCount_++;
+                if (onUpdate_) onUpdate_(arg_);
+            }
+        }
+        nowUs_ = target;
+    }
+
+    // 一直运行到定时器被回调停止，maxUs 为安全上限
+    void runUntilStopped(uint64_t maxUs = 10000000ULL) {
+        uint64_t deadline = nowUs_ + maxUs;
+        while (running_ && nowUs_ < deadline) {
+            advanceUs(settleUs_ < periodUs_ - settleUs_ ? settleUs_
+                                                        : periodUs_ - settleUs_);
+        }
+    }
+
+    uint32_t nowUs() const override { return static_cast<uint32_t>(nowUs_); }
+    uint64_t nowUs64() const { return nowUs_; }
+    uint32_t compareCount() const { return compareCount_; }
+    uint32_t updateCount() const { return updateCount_; }
+
+   private:
+    uint32_t periodUs_ = 0;
+    uint32_t settleUs_ = 0;
+    Callback onUpdate_ = nullptr;
+    Callback onCompare_ = nullptr;
+    void *arg_ = nullptr;
+    uint64_t nowUs_ = 0;
+    uint64_t periodStartUs_ = 0;
+    bool compareFired_ = false;
+    bool running_ = false;
+    uint32_t compareCount_ = 0;
+    uint32_t updateCount_ = 0;
+};
+
+}    // namespace Adapter
+
+#endif    // SCAN_TIMER_H
@@ -0,0 +1,136 @@
+#include "TimedScanEngine.h"
+
+namespace Adapter {
+
+TimedScanEngine::TimedScanEngine(IGpio *gpio, std::unique_ptr<IScanTimer> timer,
+                                 std::unique_ptr<IScanSignal> signal)
+    : gpio_(gpio),
+      timer_(std::move(timer)),
+      signal_(std::move(signal)),
+      steps_{},
+      captures_{},
+      captureTimes_{},
+      cycles_(0),
+      portCount_(0),
+      driveCycle_(0),
+      capturedCycles_(0),
+      running_(false),
+      complete_(false) {}
+
+TimedScanEngine::~TimedScanEngine() { stop(); }
+
+bool TimedScanEngine::start(const ScanStep *steps, uint8_t cycles,
+                            uint8_t portCount, uint32_t periodUs,
+                            uint32_t settleUs) {
+    if (!gpio_ || !timer_ || !signal_ || running_ || steps == nullptr || cycles == 0 ||
+        cycles > MAX_CYCLES || portCount == 0 || portCount > GPIO_PORT_COUNT) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < cycles; i++) {
+        steps_[i] = steps[i];
+    }
+    cycles_ = cycles;
+    portCount_ = portCount;
+    driveCycle_ = 0;
+    capturedCycles_ = 0;
+    complete_ = false;
+    running_ = true;
+
+    // 第一个周期在启动定时器前驱动，之后全部由定时器事件推进
+    driveStep(0);
+
+    if (!timer_->start(periodUs, settleUs, &TimedScanEngine::onUpdate,
+                       &TimedScanEngine::onCompare, this)) {
+        releaseStep(0);
+        running_ = false;
+        return false;
+    }
+    return true;
+}
+
+void TimedScanEngine::stop() {
+    if (!running_) {
+        return;
+    }
+    timer_->stop();
+    releaseStep(driveCycle_);
+    running_ = false;
+}
+
+bool TimedScanEngine::waitForCompletion(uint32_t timeoutMs) {
+    signal_->wait(&TimedScanEngine::isSettled, this, timeoutMs);
+    return complete_;
+}
+
+// 扫描完成或被停止时结束等待
+bool TimedScanEngine::isSettled(void *arg) {
+    TimedScanEngine *self = static_cast<TimedScanEngine *>(arg);
+    return self->complete_ || !self->running_;
+}
+
+void TimedScanEngine::driveStep(uint8_t cycle) {
+    const ScanStep &step = steps_[cycle];
+    if (step.mask != 0) {
+        gpio_->configurePort(step.port, step.mask, GpioMode::OUTPUT,
+                             GpioState::HIGH);
+    }
+}
+
+void TimedScanEngine::releaseStep(uint8_t cycle) {
+    const ScanStep &step = steps_[cycle];
+    if (step.mask != 0) {
+        gpio_->configurePort(step.port, step.mask, GpioMode::INPUT_PULLDOWN);
+    }
+}
+
+void TimedScanEngine::onUpdate(void *arg) {
+    TimedScanEngine *self = static_cast<TimedScanEngine *>(arg);
+    if (!self->running_) {
+        return;
+    }
+
+    uint8_t next = self->driveCycle_ + 1;
+    if (next >= self->cycles_) {
+        return;
+    }
+
+    // 相邻周期驱动同一引脚时无需切换
+    const ScanStep &prev = self->steps_[self->driveCycle_];
+    const ScanStep &cur = self->steps_[next];
+    if (prev.port != cur.port || prev.mask != cur.mask) {
+        self->releaseStep(self->driveCycle_);
+        self->driveStep(next);
+    }
+    self->driveCycle_ = next;
+}
+
+void TimedScanEngine::onCompare(void *arg) {
+    TimedScanEngine *self = static_cast<TimedScanEngine *>(arg);
+    if (!self->running_) {
+        return;
+    }
+
+    uint8_t cycle = self->capturedCycles_;
+    if (cycle >= self->cycles_) {
+        return;
+    }
+    self->captureTimes_[cycle] = self->timer_->nowUs();
+    self->gpio_->readPortSnapshot(self->captures_[cycle].data(),
+                                  self->portCount_);
+    self->capturedCycles_ = cycle + 1;
+
+    if (cycle + 1 >= self->cycles_) {
+        self->finishFromIsr();
+    }
+}
+
+void TimedScanEngine::finishFromIsr() {
+    timer_->stop();
+    releaseStep(driveCycle_);
+    running_ = false;
+    complete_ = true;
+    signal_->notifyFromIsr();
+}
+
+}    // namespace Adapter
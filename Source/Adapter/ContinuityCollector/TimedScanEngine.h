@@ -0,0 +1,97 @@
+#ifndef TIMED_SCAN_ENGINE_H
+#define TIMED_SCAN_ENGINE_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include "IGpio.hpp"
+#include "ScanSignal.h"
+#include "ScanTimer.h"
+
+using namespace Interface;
+
+namespace Adapter {
+
+/**
+ * @brief 定时器驱动的导通扫描引擎
+ *
+ * 每个周期由定时器事件推进，任务只在整次扫描结束时被唤醒一次：
+ *   - update 中断：释放上一驱动引脚，驱动本周期引脚（各一次端口批量写）
+ *   - compare 中断：驱动后 settleUs 微秒抓取端口输入快照
+ * 周期间隔和稳定时间不再受 RTOS tick 与任务调度抖动影响。
+ * 任务等待通过 IScanSignal 完成，引擎本身不依赖 RTOS。
+ */
+class TimedScanEngine {
+   public:
+    static constexpr uint8_t MAX_CYCLES = 64;
+
+    // 单个周期要驱动的引脚，mask 为 0 表示本周期不驱动
+    struct ScanStep {
+        uint8_t port;
+        uint16_t mask;
+    };
+
+    using PortCapture = std::array<uint16_t, GPIO_PORT_COUNT>;
+
+    TimedScanEngine(IGpio *gpio, std::unique_ptr<IScanTimer> timer,
+                    std::unique_ptr<IScanSignal> signal);
+    ~TimedScanEngine();
+
+    TimedScanEngine(const TimedScanEngine &) = delete;
+    TimedScanEngine &operator=(const TimedScanEngine &) = delete;
+
+    /**
+     * @brief 启动扫描
+     * @param steps     每周期驱动步骤，共 cycles 项
+     * @param cycles    周期数（<= MAX_CYCLES）
+     * @param portCount 每次快照读取的端口数
+     * @param periodUs  周期间隔（微秒）
+     * @param settleUs  驱动到采样的稳定时间（微秒，需小于 periodUs）
+     */
+    bool start(const ScanStep *steps, uint8_t cycles, uint8_t portCount,
+               uint32_t periodUs, uint32_t settleUs);
+
+    // 停止扫描并释放驱动引脚
+    void stop();
+
+    // 阻塞等待扫描完成或停止，由 compare 中断通过 IScanSignal 唤醒
+    bool waitForCompletion(uint32_t timeoutMs);
+
+    bool isRunning() const { return running_; }
+    bool isComplete() const { return complete_; }
+    uint8_t capturedCycles() const { return capturedCycles_; }
+    const PortCapture &capture(uint8_t cycle) const { return captures_[cycle]; }
+    // 采样时刻（定时器时基，微秒，32位回绕）
+    uint32_t captureTimeUs(uint8_t cycle) const { return captureTimes_[cycle]; }
+
+    IScanTimer *getTimer() const { return timer_.get(); }
+
+   private:
+    static void onUpdate(void *arg);     // 定时器 update 事件
+    static void onCompare(void *arg);    // 定时器 compare 事件
+
+    void driveStep(uint8_t cycle);
+    void releaseStep(uint8_t cycle);
+    void finishFromIsr();
+    static bool isSettled(void *arg);
+
+    IGpio *gpio_;
+    std::unique_ptr<IScanTimer> timer_;
+    std::unique_ptr<IScanSignal> signal_;
+
+    std::array<ScanStep, MAX_CYCLES> steps_;
+    std::array<PortCapture, MAX_CYCLES> captures_;
+    std::array<uint32_t, MAX_CYCLES> captureTimes_;
+    uint8_t cycles_;
+    uint8_t portCount_;
+
+    volatile uint8_t driveCycle_;        // 当前正在驱动的周期
+    volatile uint8_t capturedCycles_;    // 已完成采样的周期数
+    volatile bool running_;
+    volatile bool complete_;
+};
+
+}    // namespace Adapter
+
+#endif    // TIMED_SCAN_ENGINE_H
@@ -0,0 +1,192 @@
+#include "CrashLog.h"
+
+#include <cstddef>
+#include <cstring>
+
+#include "Logger.h"
+#include "RamLogSink.h"
+#include "gd32f4xx.h"
+
+namespace {
+
+constexpr uint32_t FAULT_MAGIC = 0x43524153;    // "CRAS"
+
+LOG_NOINIT CrashLog::FaultRecord s_fault;
+
+CrashLog::StackMark s_stacks[CRASH_LOG_STACK_SLOTS];
+volatile uint32_t s_stackCount = 0;
+RamLogSink* s_ring = nullptr;
+
+uint32_t checksum(const CrashLog::FaultRecord& record) {
+    const uint32_t* words = reinterpret_cast<const uint32_t*>(&record);
+    size_t count = offsetof(CrashLog::FaultRecord, check) / sizeof(uint32_t);
+    uint32_t sum = 0x5A5A5A5A;
+    for (size_t i = 0; i < count; i++) {
+        sum = ((sum << 5) | (sum >> 27)) ^ words[i];
+    }
+    return sum;
+}
+
+void copyName(char* dst, size_t size, const char* src) {
+    size_t i = 0;
+    if (src != nullptr) {
+        for (; i + 1 < size && src[i] != '\0'; i++) dst[i] = src[i];
+    }
+    dst[i] = '\0';
+}
+
+// 故障记录公共部分，调用者填写原因相关的字段后 commit()
+void begin(uint32_t reason) {
+    memset(&s_fault, 0, sizeof(s_fault));
+    s_fault.reason = reason;
+    s_fault.cfsr = SCB->CFSR;
+    s_fault.hfsr = SCB->HFSR;
+    s_fault.mmfar = SCB->MMFAR;
+    s_fault.bfar = SCB->BFAR;
+    s_fault.msp = __get_MSP();
+    s_fault.psp = __get_PSP();
+
+    if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED) {
+        s_fault.tick = xTaskGetTickCountFromISR();
+        copyName(s_fault.task, sizeof(s_fault.task), pcTaskGetName(nullptr));
+    }
+
+    uint32_t count = s_stackCount;
+    if (count > CRASH_LOG_STACK_SLOTS) count = CRASH_LOG_STACK_SLOTS;
+    memcpy(s_fault.stacks, s_stacks, count * sizeof(CrashLog::StackMark));
+    s_fault.stackCount = count;
+}
+
+void commit() {
+    s_fault.magic = FAULT_MAGIC;
+    s_fault.check = checksum(s_fault);
+
+    // 日志缓冲中尚未输出的记录转存到环形缓冲
+    Logger* logger = Logger::getInstance();
+    if (logger != nullptr && s_ring != nullptr) {
+        logger->salvage(*s_ring);
+    }
+}
+
+}    // namespace
+
+extern "C" void crash_log_fault(uint32_t reason, const uint32_t* stack_frame,
+                                uint32_t exc_return) {
+    begin(reason);
+    if (stack_frame != nullptr) {
+        memcpy(s_fault.frame, stack_frame, sizeof(s_fault.frame));
+    }
+    s_fault.excReturn = exc_return;
+    commit();
+}
+
+extern "C" void crash_log_assert(const char* file, int line) {
+    begin(CRASH_REASON_ASSERT);
+    // 只保留路径末尾
+    if (file != nullptr) {
+        size_t len = strlen(file);
+        if (len >= CRASH_LOG_FILE_LEN) file += len - (CRASH_LOG_FILE_LEN - 1);
+        copyName(s_fault.file, sizeof(s_fault.file), file);
+    }
+    s_fault.line = static_cast<uint32_t>(line);
+    commit();
+}
+
+extern "C" void crash_log_stack_overflow(const char* task_name) {
+    begin(CRASH_REASON_STACK_OVERFLOW);
+    copyName(s_fault.task, sizeof(s_fault.task), task_name);
+    commit();
+}
+
+extern "C" void crash_log_halt(void) {
+#if CRASH_LOG_RESET_ON_FAULT
+    NVIC_SystemReset();
+#endif
+    for (;;) {
+    }
+}
+
+void CrashLog::setRing(RamLogSink* ring) { s_ring = ring; }
+
+void CrashLog::recordStacks(const TaskStatus_t* tasks, UBaseType_t count) {
+    if (count > CRASH_LOG_STACK_SLOTS) count = CRASH_LOG_STACK_SLOTS;
+    for (UBaseType_t i = 0; i < count; i++) {
+        copyName(s_stacks[i].name, sizeof(s_stacks[i].name),
+                 tasks[i].pcTaskName);
+        s_stacks[i].freeWords = tasks[i].usStackHighWaterMark;
+    }
+    s_stackCount = count;
+}
+
+bool CrashLog::hasFault() {
+    return s_fault.magic == FAULT_MAGIC && s_fault.check == checksum(s_fault);
+}
+
+const CrashLog::FaultRecord& CrashLog::fault() { return s_fault; }
+
+void CrashLog::clearFault() { memset(&s_fault, 0, sizeof(s_fault)); }
+
+const char* CrashLog::reasonName(uint32_t reason) {
+    switch (reason) {
+        case CRASH_REASON_HARD_FAULT:
+            return "HardFault";
+        case CRASH_REASON_ASSERT:
+            return "assert";
+        case CRASH_REASON_STACK_OVERFLOW:
+            return "stack overflow";
+        default:
+            return "unknown";
+    }
+}
+
+void CrashLog::report(Logger& logger, RamLogSink* ring) {
+    static constexpr const char TAG[] = "CrashLog";
+
+    if (!hasFault()) return;
+    const FaultRecord& f = s_fault;
+
+    LOGE(TAG, "previous run stopped by %s at tick %lu, task '%s'",
+         reasonName(f.reason), (unsigned long)f.tick, f.task);
+    if (f.reason == CRASH_REASON_ASSERT) {
+        LOGE(TAG, "assert failed at %s:%lu", f.file, (unsigned long)f.line);
+    }
+    if (f.reason == CRASH_REASON_HARD_FAULT) {
+        LOGE(TAG, "pc=0x%08lx lr=0x%08lx psr=0x%08lx exc_return=0x%08lx",
+             (unsigned long)f.frame[6], (unsigned long)f.frame[5],
+             (unsigned long)f.frame[7], (unsigned long)f.excReturn);
+        LOGE(TAG, "r0=0x%08lx r1=0x%08lx r2=0x%08lx r3=0x%08lx r12=0x%08lx",
+             (unsigned long)f.frame[0], (unsigned long)f.frame[1],
+             (unsigned long)f.frame[2], (unsigned long)f.frame[3],
+             (unsigned long)f.frame[4]);
+    }
+    LOGE(TAG, "cfsr=0x%08lx hfsr=0x%08lx mmfar=0x%08lx bfar=0x%08lx",
+         (unsigned long)f.cfsr, (unsigned long)f.hfsr, (unsigned long)f.mmfar,
+         (unsigned long)f.bfar);
+    LOGE(TAG, "msp=0x%08lx psp=0x%08lx", (unsigned long)f.msp,
+         (unsigned long)f.psp);
+    for (uint32_t i = 0; i < f.stackCount && i < CRASH_LOG_STACK_SLOTS; i++) {
+        LOGE(TAG, "stack %-16s %lu words free", f.stacks[i].name,
+             (unsigned long)f.stacks[i].freeWords);
+    }
+
+    if (ring != nullptr && ring->recovered() && ring->size() > 0) {
+        LOGE(TAG, "---- last %u bytes of log before reset ----",
+             (unsigned)ring->size());
+        // 分块原样输出，缓冲区满时等待日志任务腾出空间
+        uint8_t chunk[LOG_MESSAGE_MAX];
+        size_t total = ring->size();
+        int retries = 0;
+        for (size_t offset = 0; offset < total && retries < 100;) {
+            size_t len = ring->copyFrom(offset, chunk, sizeof(chunk));
+            if (len == 0) break;
+            if (!logger.writeRaw(Logger::Level::RAW, chunk, len)) {
+                retries++;
+                vTaskDelay(pdMS_TO_TICKS(1));
+                continue;
+            }
+            offset += len;
+        }
+        LOGE(TAG, "---- end of previous log ----");
+    }
+    clearFault();
+}
@@ -0,0 +1,105 @@
+#pragma once
+#ifndef _CRASH_LOG_H_
+#define _CRASH_LOG_H_
+
+#include <stdint.h>
+
+// 故障原因
+#define CRASH_REASON_NONE           0
+#define CRASH_REASON_HARD_FAULT     1
+#define CRASH_REASON_ASSERT         2
+#define CRASH_REASON_STACK_OVERFLOW 3
+
+// 故障后复位（记录在 .noinit 中保留到下次启动）还是原地停住等待调试器；
+// Release 变体由 CMake 定义为 1
+#ifndef CRASH_LOG_RESET_ON_FAULT
+#define CRASH_LOG_RESET_ON_FAULT 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 故障处理函数中调用（C 接口）：保存寄存器、当前任务、最近的栈水位，
+ * 并把日志缓冲和中断日志环中尚未输出的记录转存到 .noinit 环形缓冲
+ */
+void crash_log_fault(uint32_t reason, const uint32_t *stack_frame,
+                     uint32_t exc_return);
+void crash_log_assert(const char *file, int line);
+void crash_log_stack_overflow(const char *task_name);
+
+// 记录完成后复位或停住，不返回
+void crash_log_halt(void) __attribute__((noreturn));
+
+#ifdef __cplusplus
+}
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+class Logger;
+class RamLogSink;
+
+// 保存的栈水位数量
+#define CRASH_LOG_STACK_SLOTS 16
+// 断言文件名保留的末尾字符数
+#define CRASH_LOG_FILE_LEN 48
+
+/**
+ * @brief 故障记录
+ *
+ * 故障记录放在 .noinit 段，复位后由 LogManager 初始化时检测并经日志
+ * 输出，同时输出 .noinit 环形缓冲中故障前的日志（建议使用二进制格式，
+ * 同样空间能保存更多记录）。
+ */
+class CrashLog {
+   public:
+    struct StackMark {
+        char name[configMAX_TASK_NAME_LEN];
+        uint32_t freeWords;    // 栈历史最小剩余（字）
+    };
+
+    struct FaultRecord {
+        uint32_t magic;
+        uint32_t reason;
+        uint32_t frame[8];    // 压栈的 R0-R3、R12、LR、PC、xPSR
+        uint32_t excReturn;
+        uint32_t cfsr;
+        uint32_t hfsr;
+        uint32_t mmfar;
+        uint32_t bfar;
+        uint32_t msp;
+        uint32_t psp;
+        uint32_t tick;
+        uint32_t line;
+        char file[CRASH_LOG_FILE_LEN];
+        char task[configMAX_TASK_NAME_LEN];
+        uint32_t stackCount;
+        StackMark stacks[CRASH_LOG_STACK_SLOTS];
+        uint32_t check;
+    };
+
+    // 故障时转存日志的环形缓冲
+    static void setRing(RamLogSink* ring);
+
+    // TaskManager 每次取得任务状态后调用，故障时复制到故障记录
+    static void recordStacks(const TaskStatus_t* tasks, UBaseType_t count);
+
+    // 上次运行是否留下了有效的故障记录
+    static bool hasFault();
+    static const FaultRecord& fault();
+    static void clearFault();
+
+    /**
+     * @brief 输出上次的故障记录和环形缓冲中的日志，然后清除故障记录
+     * 在 ring 挂接到 Logger 之前调用，避免把输出的内容再次写入 ring
+     */
+    static void report(Logger& logger, RamLogSink* ring);
+
+    static const char* reasonName(uint32_t reason);
+};
+
+#endif
+
+#endif
@@ -0,0 +1,41 @@
+#pragma once
+#ifndef _FILE_LOG_SINK_H_
+#define _FILE_LOG_SINK_H_
+
+#include <cstdio>
+
+#include "LogSink.h"
+
+/**
+ * @brief 文件输出端，用于主机上的测试和仿真
+ *
+ * 只有头文件，不编入固件；二进制格式的文件可直接交给
+ * Scripts/log_decoder.py 解析。
+ */
+class FileLogSink : public ILogSink {
+   public:
+    explicit FileLogSink(const char* path, bool append = false)
+        : file(fopen(path, append ? "ab" : "wb")) {}
+
+    ~FileLogSink() override {
+        if (file != nullptr) fclose(file);
+    }
+
+    FileLogSink(const FileLogSink&) = delete;
+    FileLogSink& operator=(const FileLogSink&) = delete;
+
+    bool isOpen() const { return file != nullptr; }
+
+    void write(const uint8_t* data, size_t len) override {
+        if (file != nullptr) fwrite(data, 1, len, file);
+    }
+
+    void flush() override {
+        if (file != nullptr) fflush(file);
+    }
+
+   private:
+    FILE* file;
+};
+
+#endif
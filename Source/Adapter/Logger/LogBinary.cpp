@@ -0,0 +1,337 @@
+#include "LogBinary.h"
+
+#include <cstring>
+
+namespace {
+
+// 有界写入器，空间不足时置 ok = false 且不再写入
+struct Writer {
+    uint8_t* pos;
+    uint8_t* end;
+    bool ok;
+
+    void put(uint8_t b) {
+        if (pos < end) {
+            *pos++ = b;
+        } else {
+            ok = false;
+        }
+    }
+
+    void bytes(const void* data, size_t len) {
+        if (static_cast<size_t>(end - pos) < len) {
+            ok = false;
+            return;
+        }
+        memcpy(pos, data, len);
+        pos += len;
+    }
+
+    void varint(uint64_t v) {
+        while (v >= 0x80) {
+            put(static_cast<uint8_t>(v) | 0x80);
+            v >>= 7;
+        }
+        put(static_cast<uint8_t>(v));
+    }
+
+    void zigzag(int64_t v) {
+        varint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63));
+    }
+
+    void u32le(uint32_t v) {
+        for (int i = 0; i < 4; i++) {
+            put(static_cast<uint8_t>(v >> (i * 8)));
+        }
+    }
+
+    // 写入 varint 长度 + 字符串，超过 maxLen 时截断并返回 false
+    bool string(const char* s, size_t maxLen) {
+        size_t len = s ? strnlen(s, maxLen) : 0;
+        varint(len);
+        bytes(s, len);
+        return s == nullptr || s[len] == '\0';
+    }
+
+    size_t room() const { return static_cast<size_t>(end - pos); }
+};
+
+// Flash 中的字符串写地址，否则内联
+bool putStringRef(Writer& w, const char* s, size_t inlineMax) {
+    if (s != nullptr && LogBinaryEncoder::inRom(s)) {
+        w.u32le(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(s)));
+        return false;
+    }
+    w.string(s, inlineMax);
+    return true;
+}
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+bool isFlag(char c) {
+    return c == '-' || c == '+' || c == ' ' || c == '#' || c == '0';
+}
+
+enum class LengthMod : uint8_t { NONE, LONG, LLONG, SIZE, MAX, PTRDIFF, LDOUBLE };
+
+int64_t signedArg(LengthMod mod, va_list& args) {
+    switch (mod) {
+        case LengthMod::LONG:
+            return va_arg(args, long);
+        case LengthMod::LLONG:
+            return va_arg(args, long long);
+        case LengthMod::SIZE:
+        case LengthMod::PTRDIFF:
+            return va_arg(args, ptrdiff_t);
+        case LengthMod::MAX:
+            return va_arg(args, intmax_t);
+        default:
+            return va_arg(args, int);
+    }
+}
+
+uint64_t unsignedArg(LengthMod mod, va_list& args) {
+    switch (mod) {
+        case LengthMod::LONG:
+            return va_arg(args, unsigned long);
+        case LengthMod::LLONG:
+            return va_arg(args, unsigned long long);
+        case LengthMod::SIZE:
+        case LengthMod::PTRDIFF:
+            return va_arg(args, size_t);
+        case LengthMod::MAX:
+            return va_arg(args, uintmax_t);
+        default:
+            return va_arg(args, unsigned int);
+    }
+}
+
+/**
+ * 按格式串顺序序列化参数，参数写不下时回退到上一个完整参数
+ * @return 全部完整写入返回 true
+ */
+bool encodeArgs(Writer& w, const char* f, va_list& args) {
+    bool complete = true;
+    while (*f != '\0') {
+        if (*f++ != '%') continue;
+        if (*f == '%') {
+            f++;
+            continue;
+        }
+
+        uint8_t* mark = w.pos;
+
+        while (isFlag(*f)) f++;
+        if (*f == '*') {
+            w.zigzag(va_arg(args, int));
+            f++;
+        } else {
+            while (isDigit(*f)) f++;
+        }
+        if (*f == '.') {
+            f++;
+            if (*f == '*') {
+                w.zigzag(va_arg(args, int));
+                f++;
+            } else {
+                while (isDigit(*f)) f++;
+            }
+        }
+
+        LengthMod mod = LengthMod::NONE;
+        switch (*f) {
+            case 'h':
+                f++;
+                if (*f == 'h') f++;
+                break;
+            case 'l':
+                f++;
+                mod = LengthMod::LONG;
+                if (*f == 'l') {
+                    f++;
+                    mod = LengthMod::LLONG;
+                }
+                break;
+            case 'z':
+                f++;
+                mod = LengthMod::SIZE;
+                break;
+            case 'j':
+                f++;
+                mod = LengthMod::MAX;
+                break;
+            case 't':
+                f++;
+                mod = LengthMod::PTRDIFF;
+                break;
+            case 'L':
+                f++;
+                mod = LengthMod::LDOUBLE;
+                break;
+            default:
+                break;
+        }
+
+        char conv = *f;
+        if (conv == '\0') break;
+        f++;
+
+        switch (conv) {
+            case 'd':
+            case 'i':
+                w.zigzag(signedArg(mod, args));
+                break;
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+                w.varint(unsignedArg(mod, args));
+                break;
+            case 'c':
+                w.varint(static_cast<unsigned int>(va_arg(args, int)));
+                break;
+            case 'p':
+                w.varint(reinterpret_cast<uintptr_t>(va_arg(args, void*)));
+                break;
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            case 'a':
+            case 'A': {
+                double v = mod == LengthMod::LDOUBLE
+                               ? static_cast<double>(va_arg(args, long double))
+                               : va_arg(args, double);
+                w.bytes(&v, sizeof(v));
+                break;
+            }
+            case 's':
+                if (!w.string(va_arg(args, const char*),
+                              w.room() > 2 ? w.room() - 2 : 0)) {
+                    complete = false;
+                }
+                break;
+            case 'n':
+                (void)va_arg(args, void*);
+                break;
+            default:
+                // 无法识别的转换，后续参数类型未知，不再继续
+                return complete;
+        }
+
+        if (!w.ok) {
+            w.pos = mark;
+            w.ok = true;
+            return false;
+        }
+    }
+    return complete;
+}
+
+size_t finish(uint8_t* out, Writer& w) {
+    size_t payload = static_cast<size_t>(w.pos - (out + 2));
+    out[1] = static_cast<uint8_t>(payload);
+    out[2 + payload] = LogBinaryEncoder::crc8(out + 1, payload + 1);
+    return payload + LogBinaryEncoder::OVERHEAD;
+}
+
+// 负载区间：len 为单字节，末尾预留 CRC
+Writer payloadWriter(uint8_t* out, size_t capacity) {
+    size_t limit = capacity - LogBinaryEncoder::OVERHEAD;
+    if (limit > 0xFF) limit = 0xFF;
+    return Writer{out + 2, out + 2 + limit, true};
+}
+
+}    // namespace
+
+uint8_t LogBinaryEncoder::crc8(const uint8_t* data, size_t len) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07)
+                               : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+size_t LogBinaryEncoder::encode(uint8_t* out, size_t capacity, uint8_t level,
+                                const char* tag, const char* format,
+                                uint64_t timestampUs, va_list args) {
+    if (out == nullptr || capacity < OVERHEAD + 1 + 4 + 4 + 1) {
+        return 0;
+    }
+    out[0] = SYNC;
+    Writer w = payloadWriter(out, capacity);
+
+    uint8_t* flags = w.pos;
+    w.put(level & LEVEL_MASK);
+
+    bool tagInline = putStringRef(w, tag, LOG_BIN_TAG_INLINE_MAX);
+    w.varint(timestampUs);
+    bool fmtInline =
+        putStringRef(w, format, w.room() > 2 ? w.room() - 2 : 0);
+    if (!w.ok) {
+        return 0;
+    }
+    if (fmtInline) *flags |= FLAG_FMT_INLINE;
+    if (tagInline) *flags |= FLAG_TAG_INLINE;
+
+    va_list ap;
+    va_copy(ap, args);
+    bool complete = encodeArgs(w, format ? format : "", ap);
+    va_end(ap);
+    if (!complete) *flags |= FLAG_TRUNCATED;
+
+    return finish(out, w);
+}
+
+size_t LogBinaryEncoder::encodeBlob(uint8_t* out, size_t capacity,
+                                    uint8_t level, uint64_t timestampUs,
+                                    const uint8_t* data, size_t size) {
+    if (out == nullptr || capacity < OVERHEAD + 1 + 10 + 1) {
+        return 0;
+    }
+    out[0] = SYNC;
+    Writer w = payloadWriter(out, capacity);
+
+    uint8_t* flags = w.pos;
+    w.put((level & LEVEL_MASK) | FLAG_BLOB);
+    w.varint(timestampUs);
+
+    // 长度 varint 最多 2 字节（负载不超过 255）
+    size_t room = w.room() > 2 ? w.room() - 2 : 0;
+    if (size > room) {
+        size = room;
+        *flags |= FLAG_TRUNCATED;
+    }
+    w.varint(size);
+    w.bytes(data, size);
+    if (!w.ok) {
+        return 0;
+    }
+    return finish(out, w);
+}
+
+size_t LogBinaryEncoder::encodeData(uint8_t* out, size_t capacity,
+                                    uint8_t level, uint8_t type,
+                                    uint64_t timestampUs, const uint8_t* data,
+                                    size_t size) {
+    if (out == nullptr || size > DATA_MAX ||
+        capacity < OVERHEAD + 2 + 10 + size) {
+        return 0;
+    }
+    out[0] = SYNC;
+    Writer w = payloadWriter(out, capacity);
+    w.put((level & LEVEL_MASK) | FLAG_DATA);
+    w.put(type);
+    w.varint(timestampUs);
+    w.bytes(data, size);
+    if (!w.ok) {
+        return 0;
+    }
+    return finish(out, w);
+}
@@ -0,0 +1,100 @@
+#pragma once
+#ifndef _LOG_BINARY_H_
+#define _LOG_BINARY_H_
+
+#include <stdarg.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// 常量字符串所在的 Flash 区间，与链接脚本 FLASH 段一致；
+// 区间内的格式串/标签只发送地址，由上位机从 ELF 中还原
+#ifndef LOG_BIN_ROM_BASE
+#define LOG_BIN_ROM_BASE 0x08000000UL
+#endif
+#ifndef LOG_BIN_ROM_SIZE
+#define LOG_BIN_ROM_SIZE (2048UL * 1024UL)
+#endif
+
+// 内联标签的最大长度（标签不在 Flash 中时）
+#define LOG_BIN_TAG_INLINE_MAX 16
+
+/**
+ * @brief 二进制日志记录编码（延迟格式化）
+ *
+ * 调用者只序列化格式串地址和原始参数，不做 vsnprintf，
+ * 由上位机工具 Scripts/log_decoder.py 根据 ELF 还原文本。
+ *
+ * 帧格式：
+ *   0      SYNC (0xA5)
+ *   1      len，负载字节数
+ *   2..    负载
+ *            flags   bit0-2 日志级别，bit3 结构化数据，bit4 参数被截断，
+ *                    bit5 数据块，
+ *                    bit6 格式串内联，bit7 标签内联
+ *            tag     4 字节小端地址；内联时为 varint 长度 + 字符串
+ *            ts      varint，微秒时间戳
+ *            fmt     同 tag
+ *            args    按格式串顺序：%d/%i 为 zigzag varint，其余整数为
+ *                    varint，浮点为 8 字节小端 double，%s 为 varint 长度
+ *                    + 字符串，宽度/精度 '*' 为 zigzag varint
+ *   2+len  CRC8（多项式 0x07，覆盖 len 与负载）
+ *
+ * 数据块记录（flags bit5）没有 tag/fmt，ts 之后为 varint 长度 + 原始字节。
+ * 结构化数据记录（flags bit3）为 type(1) + ts + 数据，数据长度为负载剩余
+ * 部分，按 type 解析（见 LogDataType，多字节字段均为小端）。
+ */
+// 结构化数据记录类型，与 Scripts/log_decoder.py 一致
+enum LogDataType : uint8_t {
+    LOG_DATA_TELEMETRY = 0x01,         // TaskTelemetry 快照
+    LOG_DATA_TELEMETRY_TASK = 0x02,    // 任务编号与名称
+    LOG_DATA_TRACE_BEGIN = 0x10,       // 调度跟踪转储：头部
+    LOG_DATA_TRACE_TASK = 0x11,        // 任务编号与名称
+    LOG_DATA_TRACE_EVENTS = 0x12,      // 事件块
+    LOG_DATA_TRACE_END = 0x13,         // 结束
+};
+
+class LogBinaryEncoder {
+   public:
+    static constexpr uint8_t SYNC = 0xA5;
+    static constexpr uint8_t LEVEL_MASK = 0x07;
+    static constexpr uint8_t FLAG_DATA = 0x08;
+    static constexpr uint8_t FLAG_TRUNCATED = 0x10;
+    static constexpr uint8_t FLAG_BLOB = 0x20;
+    static constexpr uint8_t FLAG_FMT_INLINE = 0x40;
+    static constexpr uint8_t FLAG_TAG_INLINE = 0x80;
+    static constexpr size_t OVERHEAD = 3;    // SYNC + len + CRC
+    // 结构化数据记录一定能完整容纳的数据字节数（flags + type + 最长 ts）
+    static constexpr size_t DATA_MAX = 0xFF - 2 - 10;
+
+    /**
+     * @brief 编码一条格式化日志
+     * @return 帧总字节数，out 空间不足以容纳头部时返回 0
+     */
+    static size_t encode(uint8_t* out, size_t capacity, uint8_t level,
+                         const char* tag, const char* format,
+                         uint64_t timestampUs, va_list args);
+
+    // 编码原始数据块（Log::r），上位机以十六进制显示
+    static size_t encodeBlob(uint8_t* out, size_t capacity, uint8_t level,
+                             uint64_t timestampUs, const uint8_t* data,
+                             size_t size);
+
+    /**
+     * @brief 编码结构化数据记录，数据不截断
+     * @return 帧总字节数，超过 DATA_MAX 或 out 空间不足时返回 0
+     */
+    static size_t encodeData(uint8_t* out, size_t capacity, uint8_t level,
+                             uint8_t type, uint64_t timestampUs,
+                             const uint8_t* data, size_t size);
+
+    static uint8_t crc8(const uint8_t* data, size_t len);
+
+    static bool inRom(const void* ptr) {
+        uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+        return addr >= LOG_BIN_ROM_BASE &&
+               addr - LOG_BIN_ROM_BASE < LOG_BIN_ROM_SIZE;
+    }
+};
+
+#endif
@@ -0,0 +1,75 @@
+#pragma once
+#ifndef _LOG_FILTER_H_
+#define _LOG_FILTER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// 日志级别数值，与 Logger::Level 一致，供预处理器和编译期表使用
+#define LOG_LEVEL_RAW   0
+#define LOG_LEVEL_TRACE 1
+#define LOG_LEVEL_DEBUG 2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_WARN  4
+#define LOG_LEVEL_ERROR 5
+
+// 编译期最低级别，低于该级别的 LOGx() 调用连同参数求值一起被去除；
+// Release 变体由 CMake 定义为 LOG_LEVEL_INFO
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_RAW
+#endif
+
+// 运行期可单独设置级别的标签数量
+#ifndef LOG_TAG_SLOTS
+#define LOG_TAG_SLOTS 16
+#endif
+
+namespace LogTag {
+
+// 标签 ID：FNV-1a 32 位哈希，字面量或 constexpr 标签在编译期求值
+constexpr uint32_t hash(const char* tag) {
+    uint32_t h = 2166136261u;
+    if (tag == nullptr) return h;
+    for (; *tag != '\0'; tag++) {
+        h = (h ^ static_cast<uint8_t>(*tag)) * 16777619u;
+    }
+    return h;
+}
+
+}    // namespace LogTag
+
+namespace LogFilter {
+
+struct TagLevel {
+    uint32_t tag;
+    uint8_t level;
+};
+
+/**
+ * 编译期按标签提高最低级别（不低于 LOG_COMPILE_LEVEL），
+ * 标签为编译期常量时低于该级别的调用被整体去除，用于热点路径上的逐次跟踪日志。
+ */
+constexpr TagLevel kCompileTagLevels[] = {
+    {LogTag::hash("HardwareGpio"), LOG_LEVEL_DEBUG},           // 每个引脚 6 条
+    {LogTag::hash("ContinuityCollector"), LOG_LEVEL_DEBUG},    // 每个引脚 4 条
+    {LogTag::hash("CollectorConfig"), LOG_LEVEL_DEBUG},        // 每次映射 2 条
+};
+
+constexpr uint8_t compileLevel(uint32_t tag) {
+    for (const TagLevel& entry : kCompileTagLevels) {
+        if (entry.tag == tag) {
+            return entry.level > LOG_COMPILE_LEVEL ? entry.level
+                                                   : LOG_COMPILE_LEVEL;
+        }
+    }
+    return LOG_COMPILE_LEVEL;
+}
+
+// 该级别/标签的调用是否编译进固件
+constexpr bool compiledIn(uint8_t level, uint32_t tag) {
+    return level >= LOG_COMPILE_LEVEL && level >= compileLevel(tag);
+}
+
+}    // namespace LogFilter
+
+#endif
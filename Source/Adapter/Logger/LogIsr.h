@@ -0,0 +1,64 @@
+#pragma once
+#ifndef _LOG_ISR_H_
+#define _LOG_ISR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "gd32f4xx.h"
+
+// 每条中断日志携带的参数个数
+#define LOG_ISR_ARGS 4
+// 中断日志环形缓冲的记录数（2 的幂）
+#ifndef LOG_ISR_RING_SIZE
+#define LOG_ISR_RING_SIZE 32
+#endif
+// 统计 Log::isr_*() 的最大耗时（DWT 周期计数）
+#ifndef LOG_ISR_MEASURE
+#define LOG_ISR_MEASURE 1
+#endif
+
+/**
+ * @brief 中断日志记录，固定 32 字节
+ *
+ * 中断中只保存时间戳、标签/格式串指针和原始参数，不做格式化，
+ * 由 LogTask 取出后按当前输出格式（文本/二进制）生成日志。
+ * 标签和格式串必须是字符串常量。
+ */
+struct LogIsrRecord {
+    uint32_t timestamp;    // hal_hptimer_get_us64() 的低 32 位，不经同步时间戳回调
+    const char* tag;
+    const char* format;
+    uint8_t level;
+    uint8_t argc;
+    uint32_t args[LOG_ISR_ARGS];
+};
+
+namespace LogIsr {
+
+// 参数按 32 位保存：整数、枚举和指针（%s 须指向常量字符串）
+template <typename T>
+uint32_t word(T value) {
+    static_assert(std::is_integral<T>::value || std::is_enum<T>::value,
+                  "ISR log arguments must be integers, enums or pointers");
+    static_assert(sizeof(T) <= sizeof(uint32_t),
+                  "64-bit arguments are not supported in ISR log");
+    return static_cast<uint32_t>(value);
+}
+
+template <typename T>
+uint32_t word(T* value) {
+    return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(value));
+}
+
+inline void enableCycleCounter() {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+inline uint32_t cycles() { return DWT->CYCCNT; }
+
+}    // namespace LogIsr
+
+#endif
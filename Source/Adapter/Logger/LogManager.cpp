@@ -1,8 +1,13 @@
 #include "LogManager.h"
 
+// 内存环形日志的存储区，复位后不清零
+LOG_NOINIT alignas(4) static uint8_t s_ramRingStorage[LOG_RAM_RING_SIZE];
+
 // 静态成员变量定义
 std::unique_ptr<UartConfig> LogManager::s_uartConfig = nullptr;
 std::unique_ptr<Uart> LogManager::s_uart = nullptr;
+std::unique_ptr<UartLogSink> LogManager::s_uartSink = nullptr;
+std::unique_ptr<RamLogSink> LogManager::s_ramSink = nullptr;
 std::unique_ptr<Logger> LogManager::s_logger = nullptr;
 std::unique_ptr<LogTask> LogManager::s_logTask = nullptr;
 bool LogManager::s_initialized = false;
@@ -46,12 +51,19 @@ bool LogManager::init(UasrtInfo& uartInfo, bool enableColor, Logger::Level logLe
         return false;
     }
     
+    s_uartSink = std::make_unique<UartLogSink>(*s_uart);
+    if (!s_uartSink) {
+        cleanup();
+        return false;
+    }
+
     // 创建Logger实例
-    s_logger = std::make_unique<Logger>(*s_uart);
+    s_logger = std::make_unique<Logger>();
     if (!s_logger) {
         cleanup();
         return false;
     }
+    s_logger->addSink(*s_uartSink);
     
     // 设置全局实例
     Logger::setInstance(s_logger.get());
@@ -68,11 +80,42 @@ bool LogManager::init(UasrtInfo& uartInfo, bool enableColor, Logger::Level logLe
     }
     
     s_logTask->give();
+
+    // 故障前的日志与故障记录
+    enableRamRing();
     
     s_initialized = true;
     return true;
 }
 
+bool LogManager::addSink(ILogSink& sink, Logger::Level level) {
+    if (!s_logger) {
+        return false;
+    }
+    return s_logger->addSink(sink, level);
+}
+
+RamLogSink* LogManager::enableRamRing(Logger::Level level) {
+    if (!s_logger) {
+        return nullptr;
+    }
+    if (!s_ramSink) {
+        s_ramSink = std::make_unique<RamLogSink>(s_ramRingStorage,
+                                                 sizeof(s_ramRingStorage));
+        if (!s_ramSink) {
+            return nullptr;
+        }
+        // 先输出上次的内容再挂接
+        CrashLog::report(*s_logger, s_ramSink.get());
+        if (!s_logger->addSink(*s_ramSink, level)) {
+            s_ramSink.reset();
+            return nullptr;
+        }
+        CrashLog::setRing(s_ramSink.get());
+    }
+    return s_ramSink.get();
+}
+
 Logger* LogManager::getInstance() {
     return s_logger.get();
 }
@@ -82,8 +125,11 @@ bool LogManager::isInitialized() {
 }
 
 void LogManager::cleanup() {
+    CrashLog::setRing(nullptr);
     s_logTask.reset();
     s_logger.reset();
+    s_ramSink.reset();
+    s_uartSink.reset();
     s_uart.reset();
     s_uartConfig.reset();
     s_initialized = false;
@@ -2,7 +2,10 @@
 #ifndef _LOG_MANAGER_H_
 #define _LOG_MANAGER_H_
 
+#include "CrashLog.h"
 #include "Logger.h"
+#include "RamLogSink.h"
+#include "UartLogSink.h"
 #include "hal_uart.hpp"
 #include <memory>
 
@@ -21,6 +24,17 @@ public:
                     bool enableColor = true, 
                     Logger::Level logLevel = Logger::Level::TRACE);
 
+    // 挂接额外的输出端（如 UdpLogSink），sink 的生命周期由调用者保证
+    static bool addSink(ILogSink& sink,
+                        Logger::Level level = Logger::Level::RAW);
+
+    /**
+     * 启用 .noinit 段中的内存环形输出端（LOG_RAM_RING_SIZE 字节），init() 时
+     * 自动启用。上次运行留下故障记录时先经日志输出故障记录和环形缓冲内容，
+     * 故障时未输出的日志转存到这里。RAW 级别不写入，避免输出的旧日志再被记录
+     */
+    static RamLogSink* enableRamRing(Logger::Level level = Logger::Level::TRACE);
+
     static Logger* getInstance();
 
     static bool isInitialized();
@@ -30,6 +44,8 @@ public:
 private:
     static std::unique_ptr<UartConfig> s_uartConfig;
     static std::unique_ptr<Uart> s_uart;
+    static std::unique_ptr<UartLogSink> s_uartSink;
+    static std::unique_ptr<RamLogSink> s_ramSink;
     static std::unique_ptr<Logger> s_logger;
     static std::unique_ptr<LogTask> s_logTask;
     static bool s_initialized;
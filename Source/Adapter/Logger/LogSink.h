@@ -0,0 +1,27 @@
+#pragma once
+#ifndef _LOG_SINK_H_
+#define _LOG_SINK_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 日志输出端接口
+ *
+ * LogTask 把每条记录（带前缀的文本行或二进制帧）只生成一次，
+ * 依次交给所有级别满足的输出端。输出端可以缓存合并多条记录，
+ * 在 flush() 时（缓冲区暂时为空或自身缓存已满）一次性发出。
+ * 两个方法都只在 LogTask 中调用。
+ */
+class ILogSink {
+   public:
+    virtual ~ILogSink() = default;
+
+    // 写入一条完整记录，可以先缓存
+    virtual void write(const uint8_t* data, size_t len) = 0;
+
+    // 当前没有更多记录，发出已缓存的数据
+    virtual void flush() {}
+};
+
+#endif
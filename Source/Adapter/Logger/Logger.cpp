@@ -1,5 +1,7 @@
 #include "Logger.h"
 
+#include "CrashLog.h"
+
 // 静态实例指针
 Logger* Logger::s_instance = nullptr;
 
@@ -56,6 +58,17 @@ void Log::e(const char* TAG, const char* format, ...) {
     }
 }
 
+void Log::print(Logger::Level level, const char* TAG, const char* format,
+                ...) {
+    Logger* instance = Logger::getInstance();
+    if (instance) {
+        va_list args;
+        va_start(args, format);
+        instance->emit(level, TAG, format, args);
+        va_end(args);
+    }
+}
+
 void Log::r(uint8_t* data, size_t size) {
     Logger* instance = Logger::getInstance();
     if (instance) {
@@ -70,6 +83,43 @@ void Log::setLogLevel(Logger::Level level) {
     }
 }
 
+void Log::setFormat(Logger::Format format) {
+    Logger* instance = Logger::getInstance();
+    if (instance) {
+        instance->setFormat(format);
+    }
+}
+
+void Log::setOverflowPolicy(Logger::OverflowPolicy policy, TickType_t timeout) {
+    Logger* instance = Logger::getInstance();
+    if (instance) {
+        instance->setOverflowPolicy(policy, timeout);
+    }
+}
+
+uint32_t Log::getDroppedCount() {
+    Logger* instance = Logger::getInstance();
+    if (instance) {
+        return instance->getDroppedCount();
+    }
+    return 0;
+}
+
+uint32_t Log::getIsrMaxCycles() {
+    Logger* instance = Logger::getInstance();
+    if (instance) {
+        return instance->getIsrMaxCycles();
+    }
+    return 0;
+}
+
+void Log::resetIsrMaxCycles() {
+    Logger* instance = Logger::getInstance();
+    if (instance) {
+        instance->resetIsrMaxCycles();
+    }
+}
+
 void Log::setTagLogLevel(const char* tag, Logger::Level level) {
     Logger* instance = Logger::getInstance();
     if (instance) {
@@ -131,8 +181,9 @@ void Log::clearSyncTimestampCallback() {
 // 原有的vAssertCalled函数
 void vAssertCalled(const char* file, int line) {
     taskDISABLE_INTERRUPTS();
+    crash_log_assert(file, line);
     printf("Assert failed in file %s at line %d\n", file, line);
-    for (;;);
+    crash_log_halt();
 }
 
 #ifdef ARM
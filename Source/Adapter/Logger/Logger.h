@@ -5,25 +5,43 @@
 #include <stdarg.h>
 
 #include <array>
-#include <map>
 #include <string>
 #include <functional>
 
-#include "QueueCPP.h"
+#include "LogBinary.h"
+#include "LogFilter.h"
+#include "LogIsr.h"
+#include "LogSink.h"
+#include "MessageBufferCPP.h"
+#include "MutexCPP.h"
+#include "SemaphoreCPP.h"
 #include "TaskCPP.h"
 #include "hal_hptimer.hpp"
-#include "hal_uart.hpp"
-#include "queue.h"
+#include "hal_ring_buffer.hpp"
 #include "task.h"
 
 
 #define LOG_TASK_DEPTH_SIZE 512
 #define LOG_TASK_PRIO       TaskPrio_Highest
 
-// 定义日志消息的最大长度
+// 定义日志消息正文的最大长度
 #define LOG_QUEUE_SIZE 256
-// 定义日志队列的长度
-#define LOG_QUEUE_LENGTH 20
+// 单条记录的最大长度（正文 + 时间戳/级别/标签/颜色前缀）
+#define LOG_MESSAGE_MAX (LOG_QUEUE_SIZE + 64)
+// 缓冲区中每条记录前有 1 字节级别，供各输出端过滤
+#define LOG_ENTRY_MAX (LOG_MESSAGE_MAX + 1)
+// 日志缓冲区字节数，记录按实际长度存放（每条另占 4 字节长度头）
+#ifndef LOG_BUFFER_SIZE
+#define LOG_BUFFER_SIZE 4096
+#endif
+// 同时挂接的输出端数量
+#define LOG_SINK_SLOTS 4
+// 二进制日志记录的最大长度
+#define LOG_RECORD_MAX 64
+// 结构化数据记录帧的最大长度（负载长度为单字节）
+#define LOG_BINARY_FRAME_MAX (0xFF + 3)
+// 丢弃计数的上报周期
+#define LOG_DROP_REPORT_MS 5000
 
 // ANSI颜色代码定义
 #define ANSI_COLOR_RESET   "\033[0m"
@@ -46,30 +64,227 @@
 #define ANSI_COLOR_BRIGHT_CYAN    "\033[96m"
 #define ANSI_COLOR_BRIGHT_WHITE   "\033[97m"
 
-// 日志消息结构体
-struct LogMessage {
-    std::array<char, LOG_QUEUE_SIZE> message;
-};
-
 // 日志级别枚举
 class Logger {
    public:
     enum class Level { RAW, TRACE, DEBUGL, INFO, WARN, ERROR };
 
+    // 输出格式：TEXT 在调用者上下文格式化；BINARY 只序列化格式串地址和参数，
+    // 由上位机 Scripts/log_decoder.py 结合 ELF 还原
+    enum class Format { TEXT, BINARY };
+
+    // 缓冲区满时的处理策略
+    enum class OverflowPolicy {
+        DROP_NEWEST,    // 丢弃新记录，调用者不等待
+        DROP_OLDEST,    // 丢弃最旧的记录直到放得下
+        BLOCK           // 等待日志任务腾出空间，超时后丢弃新记录
+    };
+
     // 同步时间戳回调函数类型
     using SyncTimestampCallback = std::function<uint64_t()>;
 
-    Logger(Uart& uart) : uart(uart), logQueue("LogQueue"), colorEnabled(true), syncTimestampCallback(nullptr) {}
+    Logger()
+        : spaceSem("LogSpace"),
+          bufferMutex("LogBuffer"),
+          colorEnabled(true),
+          syncTimestampCallback(nullptr) {}
 
-    Uart& uart;    // 串口对象的引用
-    FreeRTOScpp::Queue<LogMessage, LOG_QUEUE_LENGTH> logQueue;
+    // 文本行与二进制帧按原始字节存放，长度可变
+    FreeRTOScpp::MessageBuffer<LOG_BUFFER_SIZE> logBuffer;
+    FreeRTOScpp::BinarySemaphore spaceSem;    // BLOCK 策略下日志任务读出后释放
+    // 串行化各任务对 logBuffer 的读写（MessageBuffer 只支持单一读写者）
+    FreeRTOScpp::Mutex bufferMutex;
+    TaskHandle_t consumerTask = nullptr;    // 日志任务，写入后通知
 
     Level currentLevel = Level::RAW;
+    Format outputFormat = Format::TEXT;
     bool colorEnabled;                         // 颜色输出控制
-    std::map<std::string, Level> tagLevels;    // 存储每个标签的日志等级
     SyncTimestampCallback syncTimestampCallback;  // 同步时间戳回调函数
 
-    void setLogLevel(Level level) { currentLevel = level; }
+    void setLogLevel(Level level) {
+        currentLevel = level;
+        updateLevelBounds();
+    }
+
+    void setFormat(Format fmt) { outputFormat = fmt; }
+
+    Format getFormat() const { return outputFormat; }
+
+    // 设置缓冲区满时的策略，timeout 为 BLOCK 策略的最长等待时间
+    void setOverflowPolicy(OverflowPolicy policy,
+                           TickType_t timeout = pdMS_TO_TICKS(10)) {
+        blockTimeout = timeout;
+        overflowPolicy = policy;
+    }
+
+    OverflowPolicy getOverflowPolicy() const { return overflowPolicy; }
+
+    // 启动以来丢弃的记录数（含中断日志）
+    uint32_t getDroppedCount() const { return droppedCount; }
+
+    // Log::isr_*() 单次调用的最大 CPU 周期数
+    uint32_t getIsrMaxCycles() const { return isrMaxCycles; }
+
+    void resetIsrMaxCycles() { isrMaxCycles = 0; }
+
+    /**
+     * @brief 中断日志入口，只复制固定长度记录，不格式化、不分配
+     * 多个中断可能嵌套写入，push 在屏蔽中断（BASEPRI）的临界区内完成；
+     * 调用中断的优先级不能高于 configMAX_SYSCALL_INTERRUPT_PRIORITY
+     */
+    void logFromIsr(Level level, const char* tag, const char* format,
+                    const uint32_t* args, uint8_t argc) {
+        // 低于所有设置值时直接返回，标签过滤由日志任务完成
+        if (level < levelFloor) return;
+#if LOG_ISR_MEASURE
+        uint32_t start = LogIsr::cycles();
+#endif
+        LogIsrRecord record;
+        record.timestamp = hal_hptimer_get_us();
+        record.tag = tag;
+        record.format = format;
+        record.level = static_cast<uint8_t>(level);
+        record.argc = argc;
+        memcpy(record.args, args, sizeof(record.args));
+
+        UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+        bool queued = isrRing.push(record);
+        if (!queued) droppedCount = droppedCount + 1;
+        taskEXIT_CRITICAL_FROM_ISR(mask);
+
+        BaseType_t woken = pdFALSE;
+        TaskHandle_t task = consumerTask;
+        if (queued && task != nullptr) {
+            vTaskNotifyGiveFromISR(task, &woken);
+        }
+#if LOG_ISR_MEASURE
+        uint32_t cycles = LogIsr::cycles() - start;
+        mask = taskENTER_CRITICAL_FROM_ISR();
+        if (cycles > isrMaxCycles) isrMaxCycles = cycles;
+        taskEXIT_CRITICAL_FROM_ISR(mask);
+#endif
+        portYIELD_FROM_ISR(woken);
+    }
+
+    // 日志任务取出中断日志，过滤后按当前格式写入日志缓冲
+    void drainIsr() {
+        LogIsrRecord record;
+        while (isrRing.pop(record)) {
+            Level level = static_cast<Level>(record.level);
+            if (!shouldLog(level, record.tag)) continue;
+            emitArgs(level, record.tag, isrTimestamp(record), record.format,
+                     record.args[0], record.args[1], record.args[2],
+                     record.args[3]);
+        }
+    }
+
+    /**
+     * @brief 挂接输出端，低于 level 的记录不交给该输出端
+     * @return 输出端数量已满时返回 false
+     */
+    bool addSink(ILogSink& sink, Level level = Level::RAW) {
+        if (sinkCount >= LOG_SINK_SLOTS) return false;
+        taskENTER_CRITICAL();
+        sinks[sinkCount] = {&sink, level};
+        sinkCount = sinkCount + 1;
+        taskEXIT_CRITICAL();
+        return true;
+    }
+
+    bool setSinkLevel(ILogSink& sink, Level level) {
+        for (size_t i = 0; i < sinkCount; i++) {
+            if (sinks[i].sink == &sink) {
+                sinks[i].level = level;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 把一条记录交给级别满足的各输出端（日志任务调用）
+    void dispatch(const uint8_t* entry, size_t len) {
+        if (len <= 1) return;
+        Level level = static_cast<Level>(entry[0]);
+        for (size_t i = 0; i < sinkCount; i++) {
+            if (level >= sinks[i].level) {
+                sinks[i].sink->write(entry + 1, len - 1);
+            }
+        }
+    }
+
+    void flushSinks() {
+        for (size_t i = 0; i < sinkCount; i++) {
+            sinks[i].sink->flush();
+        }
+    }
+
+    /**
+     * @brief 原样输出一段数据（不加前缀），超过单条记录长度时截断
+     * @return 缓冲区已满（按溢出策略被丢弃）时返回 false
+     */
+    bool writeRaw(Level level, const uint8_t* data, size_t len) {
+        uint8_t entry[LOG_ENTRY_MAX];
+        if (len > LOG_MESSAGE_MAX) len = LOG_MESSAGE_MAX;
+        entry[0] = static_cast<uint8_t>(level);
+        memcpy(entry + 1, data, len);
+        return enqueue(entry, len + 1);
+    }
+
+    /**
+     * @brief 输出一条结构化数据记录（二进制帧，与输出格式无关）
+     * 文本模式下帧夹在文本行之间，log_decoder.py 同样能分离解析
+     * @return 数据过长或缓冲区已满时返回 false
+     */
+    bool writeData(Level level, uint8_t type, const void* data, size_t size) {
+        uint8_t entry[1 + LOG_BINARY_FRAME_MAX];
+        size_t len = LogBinaryEncoder::encodeData(
+            entry + 1, LOG_BINARY_FRAME_MAX, static_cast<uint8_t>(level),
+            type, timestamp(), static_cast<const uint8_t*>(data), size);
+        if (len == 0) return false;
+        entry[0] = static_cast<uint8_t>(level);
+        return enqueue(entry, len + 1);
+    }
+
+    /**
+     * @brief 故障处理中把缓冲区内尚未输出的记录直接写入 sink
+     * 中断已屏蔽且任务不再运行，使用 ISR 版本读取，不进入临界区；
+     * 日志任务尚未取出的中断日志在此按当前格式生成后一并写入
+     */
+    void salvage(ILogSink& sink) {
+        BaseType_t woken = pdFALSE;
+        size_t len;
+        while ((len = logBuffer.read_ISR(dropScratch, sizeof(dropScratch),
+                                         woken)) > 1) {
+            sink.write(dropScratch + 1, len - 1);
+        }
+
+        LogIsrRecord record;
+        while (isrRing.pop(record)) {
+            Level level = static_cast<Level>(record.level);
+            if (!shouldLog(level, record.tag)) continue;
+            len = formatEntryArgs(dropScratch, sizeof(dropScratch), level,
+                                  record.tag, isrTimestamp(record),
+                                  record.format, record.args[0],
+                                  record.args[1], record.args[2],
+                                  record.args[3]);
+            if (len > 1) sink.write(dropScratch + 1, len - 1);
+        }
+        sink.flush();
+    }
+
+    /**
+     * @brief 日志任务取出一条记录（首字节为级别）
+     * @return 记录字节数，缓冲区为空时返回 0
+     */
+    size_t receive(uint8_t* out, size_t capacity) {
+        if (!lockBuffer()) return 0;
+        size_t len = logBuffer.read(out, capacity, (TickType_t)0);
+        bufferMutex.give();
+        if (len > 0 && overflowPolicy == OverflowPolicy::BLOCK) {
+            spaceSem.give();
+        }
+        return len;
+    }
 
     // 设置同步时间戳回调函数
     void setSyncTimestampCallback(SyncTimestampCallback callback) {
@@ -81,32 +296,59 @@ class Logger {
         syncTimestampCallback = nullptr;
     }
 
-    // 设置特定标签的日志等级
-    void setTagLogLevel(const char* tag, Level level) {
-        tagLevels[std::string(tag)] = level;
+    // 设置特定标签的日志等级，标签表已满时返回 false
+    bool setTagLogLevel(const char* tag, Level level) {
+        uint32_t id = LogTag::hash(tag);
+        TagLevel* entry = findTag(id);
+        if (entry == nullptr) {
+            if (tagCount >= LOG_TAG_SLOTS) return false;
+            entry = &tagLevels[tagCount];
+            entry->tag = id;
+            tagCount++;
+        }
+        entry->level = level;
+        updateLevelBounds();
+        return true;
     }
 
     // 获取特定标签的日志等级
     Level getTagLogLevel(const char* tag) const {
-        auto it = tagLevels.find(std::string(tag));
-        if (it != tagLevels.end()) {
-            return it->second;
+        const TagLevel* entry = findTag(LogTag::hash(tag));
+        if (entry != nullptr) {
+            return entry->level;
         }
         return currentLevel;    // 如果没有设置特定标签级别，返回全局级别
     }
 
     // 清除特定标签的日志等级设置
     void clearTagLogLevel(const char* tag) {
-        tagLevels.erase(std::string(tag));
+        TagLevel* entry = findTag(LogTag::hash(tag));
+        if (entry != nullptr) {
+            *entry = tagLevels[--tagCount];
+            updateLevelBounds();
+        }
     }
 
     // 清除所有标签的日志等级设置
-    void clearAllTagLogLevels() { tagLevels.clear(); }
+    void clearAllTagLogLevels() {
+        tagCount = 0;
+        updateLevelBounds();
+    }
 
     // 检查是否应该输出日志
     bool shouldLog(Level level, const char* tag) const {
-        Level tagLevel = getTagLogLevel(tag);
-        return level >= tagLevel;
+        return shouldLog(level, LogTag::hash(tag));
+    }
+
+    /**
+     * @brief 按标签 ID 过滤，LOGx() 宏的运行期检查
+     * 级别不低于所有设置的上界或低于下界时不查表，只有两次比较
+     */
+    bool shouldLog(Level level, uint32_t tag) const {
+        if (level >= levelCeiling) return true;
+        if (level < levelFloor) return false;
+        const TagLevel* entry = findTag(tag);
+        return level >= (entry != nullptr ? entry->level : currentLevel);
     }
 
     void setColorEnabled(bool enabled) { colorEnabled = enabled; }
@@ -138,6 +380,46 @@ class Logger {
     void log(Level level, const char* TAG, const char* format, va_list args) {
         // 检查是否应该输出这个标签的日志
         if (!shouldLog(level, TAG)) return;
+        emit(level, TAG, format, args);
+    }
+
+    // 输出日志，调用者已完成过滤
+    void emit(Level level, const char* TAG, const char* format, va_list args) {
+        emitAt(level, TAG, timestamp(), format, args);
+    }
+
+    void emitAt(Level level, const char* TAG, uint64_t timestampUs,
+                const char* format, va_list args) {
+        // 二进制记录较短，只占用较小的栈
+        if (outputFormat == Format::BINARY) {
+            uint8_t entry[1 + LOG_RECORD_MAX];
+            size_t len = formatEntry(entry, sizeof(entry), level, TAG,
+                                     timestampUs, format, args);
+            if (len != 0) enqueue(entry, len);
+            return;
+        }
+        uint8_t entry[LOG_ENTRY_MAX];
+        size_t len = formatEntry(entry, sizeof(entry), level, TAG, timestampUs,
+                                 format, args);
+        if (len != 0) enqueue(entry, len);
+    }
+
+    /**
+     * @brief 按当前输出格式生成一条记录（首字节为级别）
+     * @return 记录字节数，编码失败返回 0
+     */
+    size_t formatEntry(uint8_t* entry, size_t capacity, Level level,
+                       const char* TAG, uint64_t timestampUs,
+                       const char* format, va_list args) {
+        if (capacity < 2) return 0;
+        if (outputFormat == Format::BINARY) {
+            size_t len = LogBinaryEncoder::encode(
+                entry + 1, capacity - 1, static_cast<uint8_t>(level), TAG,
+                format, timestampUs, args);
+            if (len == 0) return 0;
+            entry[0] = static_cast<uint8_t>(level);
+            return len + 1;
+        }
 
         // 定义日志级别的字符串表示
         static const char* levelStr[] = {"RAW",  "TRACE", "DEBUG",
@@ -152,14 +434,6 @@ class Logger {
         // 格式化日志内容
         vsnprintf(buffer, sizeof(buffer), format, args);
 
-        // 获取时间戳 - 优先使用同步时间戳
-        uint64_t timestampUs;
-        if (syncTimestampCallback) {
-            timestampUs = syncTimestampCallback();
-        } else {
-            timestampUs = hal_hptimer_get_us();
-        }
-        
         // 转换为秒和毫秒
         uint32_t seconds = timestampUs / 1000000;
         uint32_t milliseconds = (timestampUs % 1000000) / 1000;
@@ -168,23 +442,23 @@ class Logger {
         const char* colorCode = getLevelColor(level);
         const char* resetCode = colorEnabled ? ANSI_COLOR_RESET : "";
 
-        // 添加时间戳和级别前缀，包含颜色
-        char finalMessage[bufferSize + 64];    // 增加缓冲区大小以容纳颜色代码
+        // 添加时间戳和级别前缀，包含颜色；首字节留给级别
+        char* finalMessage = reinterpret_cast<char*>(entry) + 1;
         if (colorEnabled) {
-            snprintf(finalMessage, sizeof(finalMessage),
+            snprintf(finalMessage, capacity - 1,
                      "%s[%lu.%03lu] [%s] [%s] %s%s\r\n", colorCode, 
                      (unsigned long)seconds, (unsigned long)milliseconds,
                      levelStr[static_cast<int>(level)], TAG,
                      buffer, resetCode);
         } else {
-            snprintf(finalMessage, sizeof(finalMessage),
+            snprintf(finalMessage, capacity - 1,
                      "[%lu.%03lu] [%s] [%s] %s\r\n", 
                      (unsigned long)seconds, (unsigned long)milliseconds,
                      levelStr[static_cast<int>(level)], TAG, buffer);
         }
 
-        // 输出日志
-        output(level, finalMessage);
+        entry[0] = static_cast<uint8_t>(level);
+        return 1 + strlen(finalMessage);
     }
 
     void verbose(const char* TAG, const char* format, ...) {
@@ -231,6 +505,17 @@ class Logger {
         const char* TAG = "";
         if (!shouldLog(Level::RAW, TAG)) return;
 
+        if (outputFormat == Format::BINARY) {
+            uint8_t entry[1 + LOG_RECORD_MAX];
+            size_t len = LogBinaryEncoder::encodeBlob(
+                entry + 1, LOG_RECORD_MAX, static_cast<uint8_t>(Level::RAW),
+                timestamp(), data, size);
+            if (len == 0) return;
+            entry[0] = static_cast<uint8_t>(Level::RAW);
+            enqueue(entry, len + 1);
+            return;
+        }
+
         // 每个字节需要两个字符+一个空格，最后一个字节不需要空格
         char buffer[size * 3];
         for (size_t i = 0; i < size; i++) {
@@ -251,17 +536,172 @@ class Logger {
     static Logger* getInstance() { return s_instance; }
 
    private:
-    void output(Level level, const char* message) {
-        LogMessage logMsg;
-        std::strncpy(logMsg.message.data(), message, LOG_QUEUE_SIZE - 1);
-        logMsg.message[LOG_QUEUE_SIZE - 1] = '\0';
-
-        // 将日志消息放入队列
-        if (!logQueue.add(logMsg, portMAX_DELAY)) {
-            printf("Failed to add log message to queue!\n");
+    struct TagLevel {
+        uint32_t tag;
+        Level level;
+    };
+
+    static_assert(LOG_ENTRY_MAX + sizeof(size_t) <= LOG_BUFFER_SIZE,
+                  "LOG_BUFFER_SIZE too small for one record");
+
+    struct SinkSlot {
+        ILogSink* sink;
+        Level level;
+    };
+
+    std::array<SinkSlot, LOG_SINK_SLOTS> sinks;
+    volatile size_t sinkCount = 0;
+
+    OverflowPolicy overflowPolicy = OverflowPolicy::DROP_NEWEST;
+    TickType_t blockTimeout = pdMS_TO_TICKS(10);
+    volatile uint32_t droppedCount = 0;
+    uint8_t dropScratch[LOG_ENTRY_MAX];    // DROP_OLDEST 读出丢弃的记录
+
+    SpscRing<LogIsrRecord, LOG_ISR_RING_SIZE> isrRing;    // 中断写、日志任务读
+    volatile uint32_t isrMaxCycles = 0;
+
+    std::array<TagLevel, LOG_TAG_SLOTS> tagLevels;    // 存储每个标签的日志等级
+    size_t tagCount = 0;
+    Level levelFloor = Level::RAW;      // 全局与各标签级别的最小值
+    Level levelCeiling = Level::RAW;    // 全局与各标签级别的最大值
+
+    const TagLevel* findTag(uint32_t tag) const {
+        for (size_t i = 0; i < tagCount; i++) {
+            if (tagLevels[i].tag == tag) return &tagLevels[i];
+        }
+        return nullptr;
+    }
+
+    TagLevel* findTag(uint32_t tag) {
+        return const_cast<TagLevel*>(
+            static_cast<const Logger*>(this)->findTag(tag));
+    }
+
+    void updateLevelBounds() {
+        Level floor = currentLevel;
+        Level ceiling = currentLevel;
+        for (size_t i = 0; i < tagCount; i++) {
+            if (tagLevels[i].level < floor) floor = tagLevels[i].level;
+            if (tagLevels[i].level > ceiling) ceiling = tagLevels[i].level;
+        }
+        levelFloor = floor;
+        levelCeiling = ceiling;
+    }
+
+    // 获取时间戳 - 优先使用同步时间戳
+    uint64_t timestamp() const {
+        if (syncTimestampCallback) {
+            return syncTimestampCallback();
+        }
+        return hal_hptimer_get_us64();
+    }
+
+    void emitArgs(Level level, const char* TAG, uint64_t timestampUs,
+                  const char* format, ...) {
+        va_list args;
+        va_start(args, format);
+        emitAt(level, TAG, timestampUs, format, args);
+        va_end(args);
+    }
+
+    size_t formatEntryArgs(uint8_t* entry, size_t capacity, Level level,
+                           const char* TAG, uint64_t timestampUs,
+                           const char* format, ...) {
+        va_list args;
+        va_start(args, format);
+        size_t len = formatEntry(entry, capacity, level, TAG, timestampUs,
+                                 format, args);
+        va_end(args);
+        return len;
+    }
+
+    // 中断日志只保存低 32 位时间戳，按与当前时间的差值还原为 64 位
+    static uint64_t isrTimestamp(const LogIsrRecord& record) {
+        uint64_t now = hal_hptimer_get_us64();
+        return now - static_cast<uint32_t>(static_cast<uint32_t>(now) -
+                                           record.timestamp);
+    }
+
+    void notifyConsumer() {
+        TaskHandle_t task = consumerTask;
+        if (task != nullptr) {
+            xTaskNotifyGive(task);
         }
     }
 
+    /**
+     * @brief 取得 logBuffer 的互斥量
+     * 调度器挂起时不能等待，互斥量被占用则放弃（调用者按丢弃处理）；
+     * 调度器启动前只有一个执行流，互斥量总是空闲
+     */
+    bool lockBuffer() {
+        TickType_t wait =
+            xTaskGetSchedulerState() == taskSCHEDULER_RUNNING ? portMAX_DELAY
+                                                              : 0;
+        return bufferMutex.take(wait);
+    }
+
+    // 中断日志也会累加丢弃计数，读改写在临界区内完成
+    void countDrop() {
+        taskENTER_CRITICAL();
+        droppedCount = droppedCount + 1;
+        taskEXIT_CRITICAL();
+    }
+
+    /**
+     * @brief 写入一条记录（多个写入者）
+     * MessageBuffer 只支持单一写入者，持有互斥量以 0 等待写入；
+     * DROP_OLDEST 时在持有互斥量期间读出最旧的记录腾出空间
+     */
+    bool push(const void* data, size_t len) {
+        if (!lockBuffer()) {
+            countDrop();
+            return false;
+        }
+        bool sent = logBuffer.send(data, len, (TickType_t)0) == len;
+        while (!sent && overflowPolicy == OverflowPolicy::DROP_OLDEST &&
+               logBuffer.read(dropScratch, sizeof(dropScratch),
+                              (TickType_t)0) > 0) {
+            countDrop();
+            sent = logBuffer.send(data, len, (TickType_t)0) == len;
+        }
+        bufferMutex.give();
+        if (!sent) countDrop();
+        return sent;
+    }
+
+    bool enqueue(const void* data, size_t len) {
+        if (len == 0) return false;
+        if (len > LOG_ENTRY_MAX) len = LOG_ENTRY_MAX;
+
+        // 日志任务自身输出（如丢弃统计）不能等待自己腾空间
+        TickType_t wait = blockTimeout;
+        bool canBlock = overflowPolicy == OverflowPolicy::BLOCK && wait > 0 &&
+                        xTaskGetSchedulerState() == taskSCHEDULER_RUNNING &&
+                        xTaskGetCurrentTaskHandle() != consumerTask;
+        if (!canBlock) {
+            if (!push(data, len)) return false;
+            notifyConsumer();
+            return true;
+        }
+
+        TimeOut_t timeOut;
+        vTaskSetTimeOutState(&timeOut);
+        for (;;) {
+            bufferMutex.take();
+            bool sent = logBuffer.send(data, len, (TickType_t)0) == len;
+            bufferMutex.give();
+            if (sent) {
+                notifyConsumer();
+                return true;
+            }
+            if (xTaskCheckForTimeOut(&timeOut, &wait) != pdFALSE) break;
+            spaceSem.take(wait);
+        }
+        countDrop();
+        return false;
+    }
+
     static Logger* s_instance;
 };
 
@@ -275,6 +715,10 @@ class Log {
     static void e(const char* TAG, const char* format, ...);
     static void r(uint8_t* data, size_t size);
     static void setLogLevel(Logger::Level level);
+    static void setFormat(Logger::Format format);
+    static void setOverflowPolicy(Logger::OverflowPolicy policy,
+                                  TickType_t timeout = pdMS_TO_TICKS(10));
+    static uint32_t getDroppedCount();
     static void setTagLogLevel(const char* tag, Logger::Level level);
     static Logger::Level getTagLogLevel(const char* tag);
     static void clearTagLogLevel(const char* tag);
@@ -283,8 +727,77 @@ class Log {
     static bool isColorEnabled();
     static void setSyncTimestampCallback(Logger::SyncTimestampCallback callback);
     static void clearSyncTimestampCallback();
+
+    // LOGx() 宏使用：运行期过滤与已过滤的输出
+    static bool enabled(Logger::Level level, uint32_t tag) {
+        Logger* instance = Logger::getInstance();
+        return instance != nullptr && instance->shouldLog(level, tag);
+    }
+    static void print(Logger::Level level, const char* TAG, const char* format,
+                      ...);
+
+    /**
+     * 中断上下文日志：最多 LOG_ISR_ARGS 个 32 位整数/指针参数，
+     * 标签和格式串须为字符串常量（只保存指针），%s 参数同样须为常量字符串
+     */
+    template <typename... Args>
+    static void isr(Logger::Level level, const char* TAG, const char* format,
+                    Args... args) {
+        static_assert(sizeof...(Args) <= LOG_ISR_ARGS,
+                      "too many arguments for ISR log");
+        if (static_cast<uint8_t>(level) < LOG_COMPILE_LEVEL) return;
+        Logger* instance = Logger::getInstance();
+        if (instance == nullptr) return;
+        const uint32_t words[LOG_ISR_ARGS] = {LogIsr::word(args)...};
+        instance->logFromIsr(level, TAG, format, words, sizeof...(Args));
+    }
+
+    template <typename... Args>
+    static void isr_t(const char* TAG, const char* format, Args... args) {
+        isr(Logger::Level::TRACE, TAG, format, args...);
+    }
+    template <typename... Args>
+    static void isr_d(const char* TAG, const char* format, Args... args) {
+        isr(Logger::Level::DEBUGL, TAG, format, args...);
+    }
+    template <typename... Args>
+    static void isr_i(const char* TAG, const char* format, Args... args) {
+        isr(Logger::Level::INFO, TAG, format, args...);
+    }
+    template <typename... Args>
+    static void isr_w(const char* TAG, const char* format, Args... args) {
+        isr(Logger::Level::WARN, TAG, format, args...);
+    }
+    template <typename... Args>
+    static void isr_e(const char* TAG, const char* format, Args... args) {
+        isr(Logger::Level::ERROR, TAG, format, args...);
+    }
+
+    static uint32_t getIsrMaxCycles();
+    static void resetIsrMaxCycles();
 };
 
+/**
+ * 日志宏：低于编译期级别（LOG_COMPILE_LEVEL 及 LogFilter 标签表）的调用
+ * 整体去除，参数不会求值；运行期按标签 ID 过滤，不构造字符串。
+ * 标签只哈希一次，常量标签由编译器折叠为常数
+ */
+#define LOG_AT(level, tag, ...)                                           \
+    do {                                                                  \
+        const uint32_t logTagId = LogTag::hash(tag);                      \
+        if (LogFilter::compiledIn(static_cast<uint8_t>(level),            \
+                                  logTagId) &&                            \
+            Log::enabled(level, logTagId)) {                              \
+            Log::print(level, tag, __VA_ARGS__);                          \
+        }                                                                 \
+    } while (0)
+
+#define LOGT(tag, ...) LOG_AT(Logger::Level::TRACE, tag, __VA_ARGS__)
+#define LOGD(tag, ...) LOG_AT(Logger::Level::DEBUGL, tag, __VA_ARGS__)
+#define LOGI(tag, ...) LOG_AT(Logger::Level::INFO, tag, __VA_ARGS__)
+#define LOGW(tag, ...) LOG_AT(Logger::Level::WARN, tag, __VA_ARGS__)
+#define LOGE(tag, ...) LOG_AT(Logger::Level::ERROR, tag, __VA_ARGS__)
+
 class LogTask : public TaskClassS<LOG_TASK_DEPTH_SIZE> {
    private:
     Logger& Log;
@@ -294,17 +807,45 @@ class LogTask : public TaskClassS<LOG_TASK_DEPTH_SIZE> {
         : TaskClassS<LOG_TASK_DEPTH_SIZE>("LogTask", LOG_TASK_PRIO), Log(Log) {}
 
     void task() override {
-        char buffer[LOG_QUEUE_SIZE + 8];
+        Log.consumerTask = xTaskGetCurrentTaskHandle();
+        lastReport = xTaskGetTickCount();
+#if LOG_ISR_MEASURE
+        LogIsr::enableCycleCounter();
+#endif
         for (;;) {
-            LogMessage logMsg;
-            // 从队列中获取日志消息
-            if (Log.logQueue.pop(logMsg, portMAX_DELAY)) {
-                Log.uart.data_send(
-                    reinterpret_cast<const uint8_t*>(logMsg.message.data()),
-                    strlen(logMsg.message.data()));
+            reportDropped();
+            Log.drainIsr();
+
+            // 有记录时逐条分发，由各输出端合并；缓冲区为空时发出合并的数据
+            // 并等待生产者通知，超时用于定期上报丢弃数
+            size_t len = Log.receive(entry, sizeof(entry));
+            if (len == 0) {
+                Log.flushSinks();
+                ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOG_DROP_REPORT_MS));
+                continue;
             }
+            Log.dispatch(entry, len);
         }
     }
+
+   private:
+    uint8_t entry[LOG_ENTRY_MAX];
+    TickType_t lastReport = 0;
+    uint32_t reportedDrops = 0;
+
+    // 每 LOG_DROP_REPORT_MS 检查一次丢弃计数，有新增时输出一条警告
+    void reportDropped() {
+        TickType_t now = xTaskGetTickCount();
+        if (now - lastReport < pdMS_TO_TICKS(LOG_DROP_REPORT_MS)) return;
+        lastReport = now;
+
+        uint32_t dropped = Log.getDroppedCount();
+        if (dropped == reportedDrops) return;
+        Log.warn("Logger", "%lu log messages dropped (total %lu)",
+                 (unsigned long)(dropped - reportedDrops),
+                 (unsigned long)dropped);
+        reportedDrops = dropped;
+    }
 };
 
 #endif
\ No newline at end of file
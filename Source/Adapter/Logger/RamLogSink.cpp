@@ -0,0 +1,85 @@
+#include "RamLogSink.h"
+
+#include <cstring>
+
+RamLogSink::RamLogSink(void* storage, size_t size)
+    : header(static_cast<Header*>(storage)),
+      data(static_cast<uint8_t*>(storage) + sizeof(Header)),
+      capacity(size > sizeof(Header) ? size - sizeof(Header) : 0) {
+    wasRecovered = valid() && (header->pos != 0 || header->wrapped != 0);
+    if (!valid()) {
+        clear();
+    }
+}
+
+uint32_t RamLogSink::checksum() const {
+    return header->magic ^ header->capacity ^ header->pos ^
+           (header->wrapped * 0x9E3779B9u) ^ 0xA5A5A5A5u;
+}
+
+bool RamLogSink::valid() const {
+    return capacity > 0 && header->magic == MAGIC &&
+           header->capacity == capacity && header->pos < capacity &&
+           header->wrapped <= 1 && header->check == checksum();
+}
+
+void RamLogSink::clear() {
+    if (capacity == 0) return;
+    header->magic = MAGIC;
+    header->capacity = capacity;
+    header->pos = 0;
+    header->wrapped = 0;
+    header->check = checksum();
+}
+
+void RamLogSink::write(const uint8_t* src, size_t len) {
+    if (capacity == 0) return;
+
+    // 只保留最后 capacity 字节
+    if (len > capacity) {
+        src += len - capacity;
+        len = capacity;
+    }
+
+    uint32_t pos = header->pos;
+    uint32_t wrapped = header->wrapped;
+    size_t first = capacity - pos < len ? capacity - pos : len;
+    memcpy(data + pos, src, first);
+    memcpy(data, src + first, len - first);
+
+    pos += len;
+    if (pos >= capacity) {
+        pos -= capacity;
+        wrapped = 1;
+    }
+    header->pos = pos;
+    header->wrapped = wrapped;
+    header->check = checksum();
+}
+
+size_t RamLogSink::size() const {
+    if (capacity == 0) return 0;
+    return header->wrapped ? capacity : header->pos;
+}
+
+size_t RamLogSink::copyTo(uint8_t* out, size_t outCapacity) const {
+    size_t total = size();
+    size_t len = total < outCapacity ? total : outCapacity;
+    return copyFrom(total - len, out, len);
+}
+
+size_t RamLogSink::copyFrom(size_t offset, uint8_t* out,
+                            size_t outCapacity) const {
+    size_t total = size();
+    if (offset >= total) return 0;
+    size_t len = total - offset;
+    if (len > outCapacity) len = outCapacity;
+
+    // 最旧的一字节位于 pos（写满一圈时）或 0
+    size_t oldest = header->wrapped ? header->pos : 0;
+    size_t start = (oldest + offset) % capacity;
+    size_t first = capacity - start < len ? capacity - start : len;
+    memcpy(out, data + start, first);
+    memcpy(out + first, data, len - first);
+    return len;
+}
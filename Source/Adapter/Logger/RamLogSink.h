@@ -0,0 +1,62 @@
+#pragma once
+#ifndef _RAM_LOG_SINK_H_
+#define _RAM_LOG_SINK_H_
+
+#include "LogSink.h"
+
+// .noinit 段中的变量启动时不清零，软件复位后内容仍在
+#define LOG_NOINIT __attribute__((section(".noinit")))
+
+// LogManager::enableRamRing() 使用的存储区字节数（含头部）
+#ifndef LOG_RAM_RING_SIZE
+#define LOG_RAM_RING_SIZE 4096
+#endif
+
+/**
+ * @brief 内存环形输出端
+ *
+ * 保存最近写入的日志字节，写满后覆盖最旧的数据。存储区由调用者提供，
+ * 放在 .noinit 段时软件复位后可通过 recovered()/copyTo() 取回上次运行
+ * 的日志。存储区开头是带校验的头部，上电后的随机内容不会被误认为有效。
+ */
+class RamLogSink : public ILogSink {
+   public:
+    RamLogSink(void* storage, size_t size);
+
+    void write(const uint8_t* data, size_t len) override;
+
+    // 构造时存储区中是否有上次运行留下的有效内容
+    bool recovered() const { return wasRecovered; }
+
+    // 当前保存的字节数
+    size_t size() const;
+
+    // 按从旧到新的顺序拷贝最近的 capacity 字节，返回拷贝的字节数
+    size_t copyTo(uint8_t* out, size_t capacity) const;
+
+    // 从最旧数据起第 offset 字节开始拷贝，用于分块读出
+    size_t copyFrom(size_t offset, uint8_t* out, size_t capacity) const;
+
+    void clear();
+
+   private:
+    struct Header {
+        uint32_t magic;
+        uint32_t capacity;
+        uint32_t pos;        // 下一次写入的位置
+        uint32_t wrapped;    // 是否已写满一圈
+        uint32_t check;
+    };
+
+    static constexpr uint32_t MAGIC = 0x4C4F4752;    // "LOGR"
+
+    uint32_t checksum() const;
+    bool valid() const;
+
+    Header* header;
+    uint8_t* data;
+    size_t capacity;
+    bool wasRecovered = false;
+};
+
+#endif
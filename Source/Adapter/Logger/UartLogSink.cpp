@@ -0,0 +1,28 @@
+#include "UartLogSink.h"
+
+#include <cstring>
+
+void UartLogSink::write(const uint8_t* data, size_t len) {
+    if (fill + len > LOG_UART_BURST_SIZE) {
+        flush();
+    }
+    if (len > LOG_UART_BURST_SIZE) {
+        len = LOG_UART_BURST_SIZE;
+    }
+    memcpy(bursts[slot] + fill, data, len);
+    fill += len;
+}
+
+void UartLogSink::flush() {
+    if (fill == 0) return;
+
+    if (!uart.sendAsync(bursts[slot], fill)) {
+        uart.send(bursts[slot], fill);
+    }
+    slot = (slot + 1) % LOG_TX_BUFFERS;
+    fill = 0;
+
+    // 发送按顺序完成，未完成数不超过 LOG_TX_BUFFERS - 1 时
+    // 下一个缓冲的上一次发送必然已结束
+    uart.waitTxPending(LOG_TX_BUFFERS - 1);
+}
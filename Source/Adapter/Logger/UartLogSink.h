@@ -0,0 +1,38 @@
+#pragma once
+#ifndef _UART_LOG_SINK_H_
+#define _UART_LOG_SINK_H_
+
+#include "LogSink.h"
+#include "hal_uart.hpp"
+
+// 异步发送缓冲数量（不超过 UART_TX_QUEUE_DEPTH）
+#define LOG_TX_BUFFERS 4
+// 每个缓冲的字节数，多条记录合并为一次 DMA 发送
+#ifndef LOG_UART_BURST_SIZE
+#define LOG_UART_BURST_SIZE 512
+#endif
+
+/**
+ * @brief 串口输出端
+ *
+ * 记录依次拷贝到当前发送缓冲，缓冲写满或 flush() 时整块交给
+ * Uart::sendAsync()；LOG_TX_BUFFERS 个缓冲轮流使用。
+ */
+class UartLogSink : public ILogSink {
+   public:
+    explicit UartLogSink(Uart& uart) : uart(uart) {}
+
+    void write(const uint8_t* data, size_t len) override;
+    void flush() override;
+
+   private:
+    static_assert(LOG_TX_BUFFERS <= UART_TX_QUEUE_DEPTH,
+                  "LOG_TX_BUFFERS exceeds uart tx queue depth");
+
+    Uart& uart;
+    uint8_t bursts[LOG_TX_BUFFERS][LOG_UART_BURST_SIZE];    // 等待DMA发送的日志
+    size_t fill = 0;
+    uint8_t slot = 0;
+};
+
+#endif
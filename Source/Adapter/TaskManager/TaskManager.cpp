@@ -4,30 +4,25 @@
 #include <cstring>
 
 // 静态成员定义
-const char* TaskManager::TAG = "TaskManager";
 TaskManager* TaskManager::instance = nullptr;
 
-// 用于FreeRTOS运行时统计的计时器
-static uint32_t runTimeStatsTimer = 0;
+// 采样缓冲较大，静态分配，不占用创建者的栈
+static TaskTelemetry s_telemetry;
 
 void configureTimerForRunTimeStats(void) {
-    // 初始化运行时统计计时器
-    runTimeStatsTimer = 0;
+    // 调度器启动时调用，确保计数器已经运行
+    hal_hptimer_init();
 }
 
 unsigned long getRunTimeCounterValue(void) {
-    // 使用高精度定时器获取当前时间
-    // 为了避免溢出，使用系统时钟的1/10作为运行时统计时钟
-    return hal_hptimer_get_ms() / 10;
+    // 1MHz 计数，32 位约 71 分钟回绕；遥测按周期取差值，不受回绕影响
+    return hal_hptimer_get_us();
 }
 
 TaskManager::TaskManager(uint32_t statsIntervalMs) 
     : TaskClassS<0>("TaskManager", TaskPrio_Low, TASK_MANAGER_TASK_DEPTH_SIZE)
     , statsInterval(statsIntervalMs)
-    , lastStatsTime(0)
     , enableRuntimeStats(true)
-    , totalRunTime(0)
-    , lastTotalRunTime(0)
 {
     instance = this;
     
@@ -51,6 +46,10 @@ void TaskManager::setStatsInterval(uint32_t intervalMs) {
     statsInterval = intervalMs;
 }
 
+TaskTelemetry& TaskManager::getTelemetry() {
+    return s_telemetry;
+}
+
 void TaskManager::enableRuntimeStatistics(bool enable) {
     enableRuntimeStats = enable;
 }
@@ -78,47 +77,25 @@ const char* TaskManager::getTaskStateString(eTaskState state) {
 }
 
 void TaskManager::printTaskList() {
-    Log::w(TAG, "=== Task List ===");
-    Log::w(TAG, "Name             State    Priority  Stack HWM");
-    Log::w(TAG, "----------------------------------------");
-    
-    UBaseType_t taskCount = uxTaskGetNumberOfTasks();
-    TaskStatus_t* taskStatusArray = new TaskStatus_t[taskCount];
-    
-    if (taskStatusArray == nullptr) {
-        Log::e(TAG, "Failed to allocate memory for task status array");
-        return;
-    }
-    
-    // 获取任务状态信息
-    UBaseType_t arraySize = uxTaskGetSystemState(taskStatusArray, taskCount, nullptr);
-    
-    for (UBaseType_t i = 0; i < arraySize; i++) {
-        TaskStatus_t* task = &taskStatusArray[i];
-        
-        // 格式化输出任务信息
-        char taskName[configMAX_TASK_NAME_LEN + 1];
-        strncpy(taskName, task->pcTaskName, configMAX_TASK_NAME_LEN);
-        taskName[configMAX_TASK_NAME_LEN] = '\0';
-        
-        Log::w(TAG, "%-16s %-8s %8u %10u", 
-               taskName,
-               getTaskStateString(task->eCurrentState),
-               static_cast<unsigned int>(task->uxCurrentPriority),
-               static_cast<unsigned int>(task->usStackHighWaterMark));
+    const TaskTelemetry& telemetry = s_telemetry;
+    UBaseType_t taskCount = telemetry.taskCount();
+    
+    LOGW(TAG, "=== Task List ===");
+    LOGW(TAG, "Name             State    Priority  Stack HWM");
+    
+    for (UBaseType_t i = 0; i < taskCount; i++) {
+        const TaskTelemetry::TaskSample& task = telemetry.task(i);
+        LOGW(TAG, "%-16s %-8s %8u %10u", 
+             task.name,
+             getTaskStateString(static_cast<eTaskState>(task.state)),
+             static_cast<unsigned int>(task.priority),
+             static_cast<unsigned int>(task.stackFree));
     }
     
-    delete[] taskStatusArray;
-    
-    // 打印系统堆信息
-    size_t freeHeap = xPortGetFreeHeapSize();
-    size_t minEverFreeHeap = xPortGetMinimumEverFreeHeapSize();
-    
-    Log::w(TAG, "----------------------------------------");
-    Log::w(TAG, "Free Heap: %u bytes", static_cast<unsigned int>(freeHeap));
-    Log::w(TAG, "Min Ever Free Heap: %u bytes", static_cast<unsigned int>(minEverFreeHeap));
-    Log::w(TAG, "Total Tasks: %u", static_cast<unsigned int>(taskCount));
-    Log::w(TAG, "===================");
+    LOGW(TAG, "Free Heap: %lu bytes, Min Ever: %lu bytes, Tasks: %u",
+         static_cast<unsigned long>(telemetry.freeHeap()),
+         static_cast<unsigned long>(telemetry.minFreeHeap()),
+         static_cast<unsigned int>(taskCount));
 }
 
 void TaskManager::printRuntimeStats() {
@@ -126,67 +103,62 @@ void TaskManager::printRuntimeStats() {
         return;
     }
     
-    Log::w(TAG, "=== Runtime Statistics ===");
-    Log::w(TAG, "Name             Run Time    CPU Usage   Stack HWM");
-    Log::w(TAG, "-------------------------------------------------");
-    
-    UBaseType_t taskCount = uxTaskGetNumberOfTasks();
-    TaskStatus_t* taskStatusArray = new TaskStatus_t[taskCount];
-    
-    if (taskStatusArray == nullptr) {
-        Log::e(TAG, "Failed to allocate memory for task status array");
-        return;
+    const TaskTelemetry& telemetry = s_telemetry;
+    char cpuUsage[16];
+    
+    formatPercentage(telemetry.cpuLoad(), 10000, cpuUsage, sizeof(cpuUsage));
+    LOGW(TAG, "=== Runtime Statistics (%lu ms, load %s) ===",
+         static_cast<unsigned long>(telemetry.intervalUs() / 1000), cpuUsage);
+    LOGW(TAG, "Name             Run Time(us)  CPU Usage  Stack HWM");
+    
+    for (UBaseType_t i = 0; i < telemetry.taskCount(); i++) {
+        const TaskTelemetry::TaskSample& task = telemetry.task(i);
+        formatPercentage(task.cpu, 10000, cpuUsage, sizeof(cpuUsage));
+        LOGW(TAG, "%-16s %12lu %10s %10u", 
+             task.name,
+             static_cast<unsigned long>(task.runDelta),
+             cpuUsage,
+             static_cast<unsigned int>(task.stackFree));
     }
-    
-    uint32_t totalRunTime = 0;
-    
-    // 获取任务状态信息，包括运行时间
-    UBaseType_t arraySize = uxTaskGetSystemState(taskStatusArray, taskCount, &totalRunTime);
-    
-    if (totalRunTime == 0) {
-        Log::w(TAG, "Runtime statistics not available");
-        delete[] taskStatusArray;
+}
+
+void TaskManager::publishTelemetry() {
+    if (!s_telemetry.sample()) {
+        if (s_telemetry.raisedAlarms() & TaskTelemetry::ALARM_OVERFLOW) {
+            LOGE(TAG, "More than %u tasks, telemetry unavailable",
+                 static_cast<unsigned int>(TELEMETRY_MAX_TASKS));
+        }
         return;
     }
-    
-    // 计算时间差
-    uint32_t timeDiff = totalRunTime - lastTotalRunTime;
-    lastTotalRunTime = totalRunTime;
-    
-    for (UBaseType_t i = 0; i < arraySize; i++) {
-        TaskStatus_t* task = &taskStatusArray[i];
-        
-        char taskName[configMAX_TASK_NAME_LEN + 1];
-        strncpy(taskName, task->pcTaskName, configMAX_TASK_NAME_LEN);
-        taskName[configMAX_TASK_NAME_LEN] = '\0';
-        
-        // 计算CPU使用率
-        char cpuUsage[16];
-        if (totalRunTime > 0) {
-            uint32_t percentage = (task->ulRunTimeCounter * 10000) / totalRunTime;
-            snprintf(cpuUsage, sizeof(cpuUsage), "%u.%02u%%", 
-                     percentage / 100, percentage % 100);
-        } else {
-            strcpy(cpuUsage, "0.00%");
+    s_telemetry.publish();
+    reportAlarms();
+}
+
+void TaskManager::reportAlarms() {
+    const TaskTelemetry& telemetry = s_telemetry;
+    uint8_t raised = telemetry.raisedAlarms();
+    char cpuUsage[16];
+    
+    // 栈告警逐个任务报告，已经低于阈值的任务不重复报告
+    for (UBaseType_t i = 0; i < telemetry.taskCount(); i++) {
+        const TaskTelemetry::TaskSample& task = telemetry.task(i);
+        if (task.stackLowRaised) {
+            LOGW(TAG, "Stack of %s down to %u words (%d this interval)",
+                 task.name, static_cast<unsigned int>(task.stackFree),
+                 static_cast<int>(task.stackTrend));
         }
-        
-        Log::w(TAG, "%-16s %10u %10s %10u", 
-               taskName,
-               static_cast<unsigned int>(task->ulRunTimeCounter),
-               cpuUsage,
-               static_cast<unsigned int>(task->usStackHighWaterMark));
     }
     
-    delete[] taskStatusArray;
+    if (raised & TaskTelemetry::ALARM_CPU) {
+        formatPercentage(telemetry.cpuLoad(), 10000, cpuUsage, sizeof(cpuUsage));
+        LOGW(TAG, "CPU load %s over last %lu ms", cpuUsage,
+             static_cast<unsigned long>(telemetry.intervalUs() / 1000));
+    }
     
-    Log::w(TAG, "-------------------------------------------------");
-    Log::w(TAG, "Total Runtime: %u ticks", static_cast<unsigned int>(totalRunTime));
-    Log::w(TAG, "Sample Period: %u ticks", static_cast<unsigned int>(timeDiff));
-    Log::w(TAG, "===========================");
-}
-
-uint32_t TaskManager::getTotalRunTime() {
-    return getRunTimeCounterValue();
+    if (raised & TaskTelemetry::ALARM_HEAP) {
+        LOGW(TAG, "Min ever free heap down to %lu bytes",
+             static_cast<unsigned long>(telemetry.minFreeHeap()));
+    }
 }
 
 void TaskManager::formatPercentage(uint32_t value, uint32_t total, char* buffer, size_t bufferSize) {
@@ -200,30 +172,26 @@ void TaskManager::formatPercentage(uint32_t value, uint32_t total, char* buffer,
 }
 
 void TaskManager::task() {
-    Log::w(TAG, "TaskManager started");
+    LOGW(TAG, "TaskManager started");
     
     // 启动时打印任务列表
     delay(1000);  // 等待1秒让其他任务启动
+    s_telemetry.sample();
     printTaskList();
     
-    lastStatsTime = hal_hptimer_get_ms();
+    TickType_t lastWake = xTaskGetTickCount();
     
     for (;;) {
-        uint32_t currentTime = hal_hptimer_get_ms();
-        
-        // 检查是否需要打印运行时统计
-        if (statsInterval > 0 && 
-            (currentTime - lastStatsTime) >= statsInterval) {
-            
-            if (enableRuntimeStats) {
-                printRuntimeStats();
-            }
-            
-            lastStatsTime = currentTime;
+        if (statsInterval == 0) {
+            delay(1000);
+            lastWake = xTaskGetTickCount();
+            continue;
         }
         
-        // 任务休眠1秒
-        delay(1000);
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(statsInterval));
+        if (enableRuntimeStats) {
+            publishTelemetry();
+        }
     }
 }
 
@@ -6,6 +6,7 @@
 #include "task.h"
 #include "TaskCPP.h"
 #include "Logger.h"
+#include "TaskTelemetry.h"
 
 #define TASK_MANAGER_TASK_DEPTH_SIZE 1024
 #define TASK_MANAGER_TASK_PRIO       TaskPrio_Low
@@ -26,21 +27,17 @@ struct TaskStats {
  * 
  * 提供FreeRTOS任务监控功能：
  * 1. 启动时打印任务列表
- * 2. 定期打印任务运行时统计信息
+ * 2. 定期采样 TaskTelemetry，输出二进制快照，超过阈值时告警
+ * 3. 按需打印最近一个周期的运行时统计
  */
 class TaskManager : public FreeRTOScpp::TaskClassS<0> {
 private:
-    static const char* TAG;
+    static constexpr const char TAG[] = "TaskManager";
     static TaskManager* instance;
     
-    uint32_t statsInterval;     // 统计信息打印间隔(ms)
-    uint32_t lastStatsTime;     // 上次打印统计信息的时间
+    uint32_t statsInterval;     // 遥测采样与输出周期(ms)
     bool enableRuntimeStats;    // 是否启用运行时统计
     
-    // 运行时统计相关
-    uint32_t totalRunTime;      // 总运行时间
-    uint32_t lastTotalRunTime;  // 上次记录的总运行时间
-    
     /**
      * @brief 获取任务状态字符串
      */
@@ -57,9 +54,14 @@ private:
     void printRuntimeStats();
     
     /**
-     * @brief 获取系统总运行时间
+     * @brief 采样并输出遥测快照，报告新出现的告警
+     */
+    void publishTelemetry();
+    
+    /**
+     * @brief 报告本次采样新出现的告警
      */
-    uint32_t getTotalRunTime();
+    void reportAlarms();
     
     /**
      * @brief 格式化百分比输出
@@ -69,7 +71,7 @@ private:
 public:
     /**
      * @brief 构造函数
-     * @param statsIntervalMs 统计信息打印间隔(毫秒)，0表示禁用
+     * @param statsIntervalMs 遥测输出周期(毫秒)，0表示禁用
      */
     TaskManager(uint32_t statsIntervalMs = 10000);
     
@@ -84,11 +86,16 @@ public:
     static TaskManager* getInstance();
     
     /**
-     * @brief 设置统计信息打印间隔
+     * @brief 设置遥测输出周期
      * @param intervalMs 间隔时间(毫秒)，0表示禁用
      */
     void setStatsInterval(uint32_t intervalMs);
     
+    /**
+     * @brief 遥测数据与告警阈值，缓冲区为静态分配
+     */
+    static TaskTelemetry& getTelemetry();
+    
     /**
      * @brief 启用/禁用运行时统计
      * @param enable true启用，false禁用
@@ -101,7 +108,7 @@ public:
     void triggerTaskList();
     
     /**
-     * @brief 手动触发打印运行时统计
+     * @brief 手动触发打印运行时统计（最近一个采样周期）
      */
     void triggerRuntimeStats();
     
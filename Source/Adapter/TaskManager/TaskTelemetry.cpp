@@ -0,0 +1,160 @@
+#include "TaskTelemetry.h"
+
+#include <cstring>
+
+#include "CrashLog.h"
+#include "LittleEndian.hpp"
+
+// 与 tasks.c 中的默认值一致
+#ifndef configIDLE_TASK_NAME
+#define configIDLE_TASK_NAME "IDLE"
+#endif
+
+using LittleEndian::putU16;
+using LittleEndian::putU32;
+
+namespace {
+
+// 运行时间占周期的比例，0.01%
+uint16_t share(uint32_t part, uint32_t total) {
+    if (total == 0) return 0;
+    uint64_t value = static_cast<uint64_t>(part) * 10000 / total;
+    return static_cast<uint16_t>(value > 10000 ? 10000 : value);
+}
+
+}    // namespace
+
+const TaskTelemetry::TaskSample* TaskTelemetry::previous(
+    uint16_t number) const {
+    if (!sampled) return nullptr;
+    const TaskSample* last = samples[current];
+    for (UBaseType_t i = 0; i < count; i++) {
+        if (last[i].number == number) return &last[i];
+    }
+    return nullptr;
+}
+
+bool TaskTelemetry::sample() {
+    uint32_t total = 0;
+    UBaseType_t n = 0;
+    if (uxTaskGetNumberOfTasks() <= TELEMETRY_MAX_TASKS) {
+        n = uxTaskGetSystemState(status, TELEMETRY_MAX_TASKS, &total);
+    }
+    if (n == 0 || total == 0) {
+        // 任务数超过缓冲区时 uxTaskGetSystemState 不填写任何内容
+        raised = (active & ALARM_OVERFLOW) ? 0 : ALARM_OVERFLOW;
+        active |= ALARM_OVERFLOW;
+        return false;
+    }
+    CrashLog::recordStacks(status, n);
+
+    // 写入另一组缓冲，完成后切换；其他任务读取时看到的总是完整的一组
+    interval = total - lastTotal;
+    lastTotal = total;
+
+    uint32_t idle = 0;
+    bool stackLow = false;
+    TaskSample* out = samples[current ^ 1];
+    for (UBaseType_t i = 0; i < n; i++) {
+        const TaskStatus_t& s = status[i];
+        TaskSample& t = out[i];
+        strncpy(t.name, s.pcTaskName, sizeof(t.name));
+        t.name[sizeof(t.name) - 1] = '\0';
+        t.number = static_cast<uint16_t>(s.xTaskNumber);
+        t.priority = static_cast<uint8_t>(s.uxCurrentPriority);
+        t.state = static_cast<uint8_t>(s.eCurrentState);
+        t.runTime = s.ulRunTimeCounter;
+        t.stackFree = static_cast<uint16_t>(s.usStackHighWaterMark);
+
+        // 本周期内新建的任务从 0 开始计时；首次采样为启动以来的累计值
+        const TaskSample* last = previous(t.number);
+        t.isNew = sampled && last == nullptr;
+        t.runDelta = t.runTime - (last != nullptr ? last->runTime : 0);
+        t.cpu = share(t.runDelta, interval);
+        t.stackTrend = last != nullptr
+                           ? static_cast<int16_t>(t.stackFree - last->stackFree)
+                           : 0;
+        t.stackLow = t.stackFree < thresholds.stackWords;
+        t.stackLowRaised = t.stackLow && (last == nullptr || !last->stackLow);
+        stackLow = stackLow || t.stackLow;
+
+        if (strcmp(t.name, configIDLE_TASK_NAME) == 0) {
+            idle += t.runDelta;
+        }
+    }
+
+    load = static_cast<uint16_t>(10000 - share(idle, interval));
+    uint32_t minEver = static_cast<uint32_t>(xPortGetMinimumEverFreeHeapSize());
+    heapMinDelta = sampled ? static_cast<int32_t>(minEver - heapMinEver) : 0;
+    heapMinEver = minEver;
+    heapFree = static_cast<uint32_t>(xPortGetFreeHeapSize());
+
+    uint8_t now = 0;
+    if (stackLow) now |= ALARM_STACK;
+    if (load >= thresholds.cpuLoad) now |= ALARM_CPU;
+    if (heapMinEver < thresholds.heapBytes) now |= ALARM_HEAP;
+    raised = now & ~active;
+    active = now;
+
+    taskENTER_CRITICAL();
+    count = n;
+    current ^= 1;
+    sampled = true;
+    taskEXIT_CRITICAL();
+    return true;
+}
+
+bool TaskTelemetry::publishNames(Logger& logger, Logger::Level level, bool all) {
+    uint8_t buf[2 + configMAX_TASK_NAME_LEN];
+    for (UBaseType_t i = 0; i < count; i++) {
+        const TaskSample& t = task(i);
+        if (!all && !t.isNew) continue;
+        size_t len = strnlen(t.name, sizeof(t.name));
+        putU16(buf, t.number);
+        memcpy(buf + 2, t.name, len);
+        if (!logger.writeData(level, LOG_DATA_TELEMETRY_TASK, buf, 2 + len)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * 快照格式（小端）：
+ *   0   u32  周期长度（us）
+ *   4   u32  当前空闲堆
+ *   8   u32  历史最小空闲堆
+ *   12  u16  非空闲 CPU 占用（0.01%）
+ *   14  u8   告警位（Alarm）
+ *   15  u8   任务数 n
+ *   16  n × { u16 任务编号, u8 优先级, u8 状态, u16 CPU 占用（0.01%），
+ *             u16 栈历史最小剩余（字） }
+ * 任务名称由 LOG_DATA_TELEMETRY_TASK 记录单独发送
+ */
+bool TaskTelemetry::publish(Logger::Level level) {
+    Logger* logger = Logger::getInstance();
+    if (logger == nullptr || !sampled) return false;
+
+    bool all = publishCount % TELEMETRY_NAME_PERIOD == 0;
+    publishCount++;
+    if (!publishNames(*logger, level, all)) return false;
+
+    uint8_t buf[HEADER_SIZE + TELEMETRY_MAX_TASKS * TASK_SIZE];
+    putU32(buf, interval);
+    putU32(buf + 4, heapFree);
+    putU32(buf + 8, heapMinEver);
+    putU16(buf + 12, load);
+    buf[14] = active;
+    buf[15] = static_cast<uint8_t>(count);
+    uint8_t* p = buf + HEADER_SIZE;
+    for (UBaseType_t i = 0; i < count; i++, p += TASK_SIZE) {
+        const TaskSample& t = task(i);
+        putU16(p, t.number);
+        p[2] = t.priority;
+        p[3] = t.state;
+        putU16(p + 4, t.cpu);
+        putU16(p + 6, t.stackFree);
+    }
+    return logger->writeData(level, LOG_DATA_TELEMETRY, buf,
+                             static_cast<size_t>(p - buf));
+}
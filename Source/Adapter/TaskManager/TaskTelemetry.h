@@ -0,0 +1,120 @@
+#pragma once
+#ifndef _TASK_TELEMETRY_H_
+#define _TASK_TELEMETRY_H_
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "Logger.h"
+
+// 预分配的任务数量，超出时采样失败
+#ifndef TELEMETRY_MAX_TASKS
+#define TELEMETRY_MAX_TASKS 24
+#endif
+// 告警阈值默认值
+#define TELEMETRY_STACK_ALARM_WORDS 64     // 栈历史最小剩余（字）
+#define TELEMETRY_CPU_ALARM_LOAD    9000   // 非空闲占用，0.01%
+#define TELEMETRY_HEAP_ALARM_BYTES  2048   // 堆历史最小剩余
+// 每隔多少个快照重发一次全部任务名称（新任务总是立即发送）
+#define TELEMETRY_NAME_PERIOD 10
+
+/**
+ * @brief 任务运行时遥测
+ *
+ * 把 uxTaskGetSystemState() 采样到预分配的缓冲区，按任务编号与上次
+ * 采样对齐，计算本周期内的 CPU 占用（而不是启动以来的累计值）、栈
+ * 水位变化和堆历史最小剩余，并检查告警阈值。publish() 以结构化数据
+ * 记录输出紧凑的二进制快照，由 Scripts/log_decoder.py 解析显示。
+ *
+ * 运行时间计数器为 1MHz 的 32 位值，采样间隔不能超过约 71 分钟。
+ */
+class TaskTelemetry {
+   public:
+    enum Alarm : uint8_t {
+        ALARM_STACK = 1 << 0,    // 有任务栈剩余低于阈值
+        ALARM_CPU = 1 << 1,      // 非空闲占用达到阈值
+        ALARM_HEAP = 1 << 2,     // 堆历史最小剩余低于阈值
+        ALARM_OVERFLOW = 1 << 3  // 任务数超过 TELEMETRY_MAX_TASKS
+    };
+
+    struct TaskSample {
+        char name[configMAX_TASK_NAME_LEN];
+        uint16_t number;        // uxTCBNumber，任务重建后会变化
+        uint8_t priority;
+        uint8_t state;          // eTaskState
+        uint32_t runTime;       // 累计运行时间（us）
+        uint32_t runDelta;      // 本周期运行时间（us）
+        uint16_t cpu;           // 本周期 CPU 占用，0.01%
+        uint16_t stackFree;     // 栈历史最小剩余（字）
+        int16_t stackTrend;     // 本周期栈历史最小剩余的变化（字）
+        bool isNew;             // 上次采样时不存在
+        bool stackLow;          // 栈剩余低于阈值
+        bool stackLowRaised;    // 本次采样新低于阈值
+    };
+
+    struct Thresholds {
+        uint16_t stackWords = TELEMETRY_STACK_ALARM_WORDS;
+        uint16_t cpuLoad = TELEMETRY_CPU_ALARM_LOAD;
+        uint32_t heapBytes = TELEMETRY_HEAP_ALARM_BYTES;
+    };
+
+    /**
+     * @brief 采样一次并计算本周期的增量和告警
+     * @return 任务数超过缓冲区或运行时统计不可用时返回 false
+     */
+    bool sample();
+
+    /**
+     * @brief 输出最近一次采样的二进制快照
+     * @return 日志未初始化或缓冲区已满时返回 false
+     */
+    bool publish(Logger::Level level = Logger::Level::INFO);
+
+    void setThresholds(const Thresholds& value) { thresholds = value; }
+    const Thresholds& getThresholds() const { return thresholds; }
+
+    UBaseType_t taskCount() const { return count; }
+    const TaskSample& task(UBaseType_t index) const {
+        return samples[current][index];
+    }
+
+    uint32_t intervalUs() const { return interval; }
+    uint16_t cpuLoad() const { return load; }    // 非空闲占用，0.01%
+    uint32_t freeHeap() const { return heapFree; }
+    uint32_t minFreeHeap() const { return heapMinEver; }
+    int32_t heapTrend() const { return heapMinDelta; }    // 本周期历史最小剩余的变化
+
+    // 当前告警（Alarm 位组合）与本次采样新出现的告警
+    uint8_t alarms() const { return active; }
+    uint8_t raisedAlarms() const { return raised; }
+
+   private:
+    // 快照格式：头部 16 字节 + 每任务 8 字节，见 publish()
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t TASK_SIZE = 8;
+    static_assert(HEADER_SIZE + TELEMETRY_MAX_TASKS * TASK_SIZE <=
+                      LogBinaryEncoder::DATA_MAX,
+                  "telemetry snapshot exceeds data record size");
+
+    const TaskSample* previous(uint16_t number) const;
+    bool publishNames(Logger& logger, Logger::Level level, bool all);
+
+    TaskStatus_t status[TELEMETRY_MAX_TASKS];
+    TaskSample samples[2][TELEMETRY_MAX_TASKS];    // 最近一次 / 正在写入，交替使用
+    uint8_t current = 0;
+    UBaseType_t count = 0;
+    bool sampled = false;
+
+    uint32_t lastTotal = 0;
+    uint32_t interval = 0;
+    uint16_t load = 0;
+    uint32_t heapFree = 0;
+    uint32_t heapMinEver = 0;
+    int32_t heapMinDelta = 0;
+
+    Thresholds thresholds;
+    uint8_t active = 0;
+    uint8_t raised = 0;
+    uint32_t publishCount = 0;
+};
+
+#endif
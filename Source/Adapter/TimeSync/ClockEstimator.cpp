@@ -0,0 +1,137 @@
+#include "ClockEstimator.h"
+
+#include <cmath>
+
+namespace {
+
+constexpr double Q32 = 4294967296.0;
+
+}    // namespace
+
+void ClockEstimator::reset() {
+    clearWindow();
+    current = ClockMapping();
+    mapped = false;
+    lastDelay = 0;
+    lastResidual = 0;
+}
+
+void ClockEstimator::clearWindow() {
+    head = 0;
+    count = 0;
+    rejects = 0;
+    locked = false;
+    minDelay = 0;
+}
+
+void ClockEstimator::push(const Sample& sample) {
+    samples[head] = sample;
+    head = static_cast<uint8_t>((head + 1) % CLOCK_ESTIMATOR_WINDOW);
+    if (count < CLOCK_ESTIMATOR_WINDOW) count++;
+
+    minDelay = sample.delay;
+    for (uint8_t i = 0; i < count; i++) {
+        if (at(i).delay < minDelay) minDelay = at(i).delay;
+    }
+}
+
+const ClockEstimator::Sample& ClockEstimator::at(uint8_t index) const {
+    uint8_t first = static_cast<uint8_t>(
+        (head + CLOCK_ESTIMATOR_WINDOW - count) % CLOCK_ESTIMATOR_WINDOW);
+    return samples[(first + index) % CLOCK_ESTIMATOR_WINDOW];
+}
+
+ClockEstimator::Result ClockEstimator::addExchange(uint64_t t1, uint64_t t2,
+                                                   uint64_t t3, uint64_t t4) {
+    if (t4 < t1 || t3 < t2) return Result::INVALID;
+
+    // 本地与主机计时的差异可能使延迟略小于 0
+    int64_t delay = static_cast<int64_t>(t4 - t1) - static_cast<int64_t>(t3 - t2);
+    if (delay < 0) delay = 0;
+    if (delay > static_cast<int64_t>(UINT32_MAX)) return Result::INVALID;
+
+    Sample sample;
+    sample.x = t1 + (t4 - t1) / 2;
+    sample.y2 = static_cast<int64_t>(t2 - t1) + static_cast<int64_t>(t3 - t4);
+    sample.delay = static_cast<uint32_t>(delay);
+    lastDelay = sample.delay;
+
+    if (count > 0 &&
+        sample.delay > 2 * static_cast<uint64_t>(minDelay) + config.delaySlackUs) {
+        if (++rejects < config.maxRejects) return Result::REJECTED_DELAY;
+        // 持续偏大：路径变化，以新的延迟水平重新估计
+        clearWindow();
+    }
+    rejects = 0;
+
+    Result result = Result::ACCEPTED;
+    lastResidual = 0;
+    if (mapped) {
+        int64_t predicted2 =
+            2 * static_cast<int64_t>(current.toMaster(sample.x) - sample.x);
+        lastResidual = (sample.y2 - predicted2) / 2;
+        int64_t limit = config.stepThresholdUs;
+        if (lastResidual > limit || lastResidual < -limit) {
+            clearWindow();
+            result = Result::STEPPED;
+        }
+    }
+
+    push(sample);
+    fit();
+    mapped = true;
+    locked = count >= config.minSamples;
+    return result;
+}
+
+double ClockEstimator::weight(uint32_t delay) const {
+    // 多出的延迟中最多一半计入偏差误差，按误差平方的倒数加权
+    double excess = (delay - minDelay) / 2.0 + config.weightFloorUs;
+    return 1.0 / (excess * excess);
+}
+
+void ClockEstimator::fit() {
+    const Sample& last = at(count - 1);
+
+    // 样本不足时沿用原有频率，只更新偏差
+    double rate = current.rateQ32 / Q32;
+    double offset2 = 0;
+    if (count >= config.minSamples) {
+        // 加权最小二乘：延迟越接近最小值，路径越对称，权重越大。
+        // 以最新样本为原点，数值都在 double 的精确范围内
+        double sw = 0, sx = 0, sy = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            double w = weight(at(i).delay);
+            sw += w;
+            sx += w * static_cast<int64_t>(at(i).x - last.x);
+            sy += w * (at(i).y2 - last.y2);
+        }
+        double mx = sx / sw;
+        double my = sy / sw;
+        double sxx = 0, sxy = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            double w = weight(at(i).delay);
+            double dx = static_cast<int64_t>(at(i).x - last.x) - mx;
+            double dy = (at(i).y2 - last.y2) - my;
+            sxx += w * dx * dx;
+            sxy += w * dx * dy;
+        }
+        if (sxx > 0) {
+            // y 为 2 倍偏差
+            rate = sxy / sxx / 2;
+            double limit = config.maxRatePpm * 1e-6;
+            if (rate > limit) rate = limit;
+            if (rate < -limit) rate = -limit;
+        }
+        // 回归直线在最新样本处的值
+        offset2 = my - 2 * rate * mx;
+    }
+
+    current.localRef = last.x;
+    current.offset = (last.y2 + static_cast<int64_t>(std::llround(offset2))) / 2;
+    current.rateQ32 = static_cast<int32_t>(std::llround(rate * Q32));
+}
+
+int32_t ClockEstimator::ratePpb() const {
+    return static_cast<int32_t>(std::llround(current.rateQ32 * 1e9 / Q32));
+}
@@ -0,0 +1,128 @@
+#pragma once
+#ifndef _CLOCK_ESTIMATOR_H_
+#define _CLOCK_ESTIMATOR_H_
+
+#include <cstdint>
+
+// 参与回归的最近样本数
+#ifndef CLOCK_ESTIMATOR_WINDOW
+#define CLOCK_ESTIMATOR_WINDOW 16
+#endif
+
+/**
+ * @brief 本地时钟到主时钟的线性映射
+ *
+ *   master = local + offset + (local - localRef) * rate
+ *
+ * rate 为 Q32 定点数（2^-32），即主时钟相对本地时钟的频率偏差。
+ * 只有加法和一次 64 位乘法，可以在中断中调用。
+ */
+struct ClockMapping {
+    uint64_t localRef = 0;    // 基准时刻（本地时钟，us）
+    int64_t offset = 0;       // 基准时刻的偏差：主时钟 - 本地时钟（us）
+    int32_t rateQ32 = 0;      // 频率偏差，Q32
+
+    uint64_t toMaster(uint64_t local) const {
+        int64_t dx = static_cast<int64_t>(local - localRef);
+        return local + offset + ((dx * rateQ32) >> 32);
+    }
+
+    // 反向换算，迭代两次求漂移项：剩余误差约 rate^3 * (local - localRef)，
+    // 500 ppm 下一小时不到 0.5us（一次迭代为 rate^2 倍，同条件下约 900us）
+    uint64_t toLocal(uint64_t master) const {
+        uint64_t base = master - offset;
+        int64_t dx = static_cast<int64_t>(base - localRef);
+        uint64_t approx = base - ((dx * rateQ32) >> 32);
+        dx = static_cast<int64_t>(approx - localRef);
+        return base - ((dx * rateQ32) >> 32);
+    }
+};
+
+/**
+ * @brief 时钟偏差与漂移估计
+ *
+ * 输入一次双向时间戳交换（本地 t1 发出请求，主机 t2 收到、t3 回复，
+ * 本地 t4 收到回复），按往返对称假设得到偏差
+ *     offset = ((t2 - t1) + (t3 - t4)) / 2
+ *     delay  = (t4 - t1) - (t3 - t2)
+ * 对最近 CLOCK_ESTIMATOR_WINDOW 个样本的偏差做加权最小二乘直线拟合
+ * （延迟越接近最小值权重越大），斜率即频率偏差，截距外推到最新样本
+ * 得到映射。
+ *
+ * 往返延迟明显大于窗口内最小值的样本（排队、调度造成的不对称延迟）
+ * 被丢弃；连续丢弃 maxRejects 次认为路径变化，重新开始估计。
+ * 偏差与预测相差超过 stepThresholdUs 时直接跳变（主机重启等）。
+ *
+ * 只依赖标准库，可在主机上用合成的时钟数据测试。
+ */
+class ClockEstimator {
+   public:
+    struct Config {
+        uint8_t minSamples = 4;            // 达到该样本数后估计频率并认为已锁定
+        uint32_t stepThresholdUs = 1000;   // 超过则跳变而不是平滑
+        uint32_t delaySlackUs = 100;       // 延迟上限 = 2 * 最小延迟 + slack
+        uint8_t maxRejects = 8;            // 连续丢弃次数上限
+        uint32_t maxRatePpm = 500;         // 频率偏差上限（晶振容差）
+        uint32_t weightFloorUs = 5;        // 最小延迟样本的误差估计，限制其权重
+    };
+
+    enum class Result : uint8_t {
+        ACCEPTED,        // 样本已用于估计
+        STEPPED,         // 偏差跳变，映射已重置到该样本
+        REJECTED_DELAY,  // 往返延迟过大
+        INVALID          // 时间戳顺序错误
+    };
+
+    ClockEstimator() = default;
+    explicit ClockEstimator(const Config& config) : config(config) {}
+
+    /**
+     * @brief 加入一次双向交换
+     * @param t1 请求发出时刻（本地）
+     * @param t2 主机收到请求时刻（主时钟）
+     * @param t3 主机发出回复时刻（主时钟）
+     * @param t4 收到回复时刻（本地）
+     */
+    Result addExchange(uint64_t t1, uint64_t t2, uint64_t t3, uint64_t t4);
+
+    // 清除样本和映射
+    void reset();
+
+    bool isLocked() const { return locked; }
+    const ClockMapping& mapping() const { return current; }
+
+    uint32_t lastDelayUs() const { return lastDelay; }
+    uint32_t minDelayUs() const { return minDelay; }
+    // 最近一个被接受样本的测量偏差减去加入前的预测值
+    int64_t lastResidualUs() const { return lastResidual; }
+    // 频率偏差，ppb
+    int32_t ratePpb() const;
+
+   private:
+    struct Sample {
+        uint64_t x;      // 交换中点（本地时钟）
+        int64_t y2;      // 2 * 偏差，保留半微秒
+        uint32_t delay;  // 往返延迟
+    };
+
+    void clearWindow();
+    void push(const Sample& sample);
+    const Sample& at(uint8_t index) const;    // 0 为最早
+    double weight(uint32_t delay) const;
+    void fit();
+
+    Config config;
+    Sample samples[CLOCK_ESTIMATOR_WINDOW];
+    uint8_t head = 0;     // 下一个写入位置
+    uint8_t count = 0;
+    uint8_t rejects = 0;
+    bool locked = false;
+    bool mapped = false;  // 至少接受过一个样本
+
+    ClockMapping current;
+    uint32_t lastDelay = 0;
+    uint32_t minDelay = 0;
+    int64_t lastResidual = 0;
+};
+
+#endif
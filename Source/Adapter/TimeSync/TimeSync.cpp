@@ -0,0 +1,177 @@
+#include "TimeSync.h"
+
+#include "FreeRTOS.h"
+#include "LittleEndian.hpp"
+#include "Logger.h"
+#include "hal_hptimer.hpp"
+#include "task.h"
+
+using LittleEndian::getU16;
+using LittleEndian::getU32;
+using LittleEndian::getU64;
+using LittleEndian::putU16;
+using LittleEndian::putU32;
+using LittleEndian::putU64;
+
+namespace {
+
+constexpr const char* TAG = "TimeSync";
+
+constexpr uint16_t MSG_MAGIC = 0x5354;    // "TS"
+constexpr uint8_t MSG_VERSION = 1;
+constexpr uint8_t MSG_REQUEST = 1;
+constexpr uint8_t MSG_RESPONSE = 2;
+
+struct Message {
+    uint8_t type;
+    uint32_t seq;
+    uint64_t t1;
+    uint64_t t2;
+    uint64_t t3;
+};
+
+TimeSync::Role s_role = TimeSync::Role::SLAVE;
+ClockEstimator s_estimator;
+
+// 发布给读者的映射；s_seq 为奇数时正在更新
+volatile uint32_t s_seq = 0;
+ClockMapping s_mapping;
+volatile bool s_locked = false;
+
+// 从机最近一次请求的序号，更早的回复作废
+uint32_t s_requestSeq = 0;
+
+size_t encode(const Message& msg, uint8_t* out, size_t capacity) {
+    if (capacity < TIME_SYNC_MSG_SIZE) return 0;
+    putU16(out, MSG_MAGIC);
+    out[2] = MSG_VERSION;
+    out[3] = msg.type;
+    putU32(out + 4, msg.seq);
+    putU64(out + 8, msg.t1);
+    putU64(out + 16, msg.t2);
+    putU64(out + 24, msg.t3);
+    return TIME_SYNC_MSG_SIZE;
+}
+
+bool decode(const uint8_t* in, size_t len, Message& msg) {
+    if (len < TIME_SYNC_MSG_SIZE || getU16(in) != MSG_MAGIC ||
+        in[2] != MSG_VERSION) {
+        return false;
+    }
+    msg.type = in[3];
+    msg.seq = getU32(in + 4);
+    msg.t1 = getU64(in + 8);
+    msg.t2 = getU64(in + 16);
+    msg.t3 = getU64(in + 24);
+    return true;
+}
+
+ClockMapping readMapping() {
+    ClockMapping mapping;
+    uint32_t seq;
+    do {
+        seq = s_seq;
+        __DMB();
+        mapping = s_mapping;
+        __DMB();
+        // 只有被写者任务抢占的读者任务会读到更新中的值，重读即可
+    } while ((seq & 1U) != 0 || seq != s_seq);
+    return mapping;
+}
+
+// 临界区屏蔽了可调用 FreeRTOS API 的中断，中断中的读者不会等待写者
+void publish(const ClockMapping& mapping, bool locked) {
+    taskENTER_CRITICAL();
+    s_seq = s_seq + 1;
+    __DMB();
+    s_mapping = mapping;
+    s_locked = locked;
+    __DMB();
+    s_seq = s_seq + 1;
+    taskEXIT_CRITICAL();
+}
+
+}    // namespace
+
+void TimeSync::setRole(Role role) {
+    s_role = role;
+    reset();
+}
+
+TimeSync::Role TimeSync::getRole() { return s_role; }
+
+uint64_t TimeSync::nowUs() { return toSyncUs(hal_hptimer_get_us64()); }
+
+uint64_t TimeSync::toSyncUs(uint64_t localUs) {
+    return readMapping().toMaster(localUs);
+}
+
+uint64_t TimeSync::toLocalUs(uint64_t syncUs) {
+    return readMapping().toLocal(syncUs);
+}
+
+void TimeSync::sleepUntilSyncUs(uint64_t syncUs) {
+    hal_hptimer_sleep_until_us(toLocalUs(syncUs));
+}
+
+bool TimeSync::isLocked() {
+    return s_role == Role::MASTER || s_locked;
+}
+
+size_t TimeSync::makeRequest(uint8_t* out, size_t capacity) {
+    Message msg = {};
+    msg.type = MSG_REQUEST;
+    msg.seq = ++s_requestSeq;
+    msg.t1 = hal_hptimer_get_us64();
+    return encode(msg, out, capacity);
+}
+
+size_t TimeSync::answerRequest(const uint8_t* in, size_t len, uint64_t rxUs,
+                               uint8_t* out, size_t capacity) {
+    Message msg;
+    if (!decode(in, len, msg) || msg.type != MSG_REQUEST) return 0;
+    msg.type = MSG_RESPONSE;
+    msg.t2 = toSyncUs(rxUs);
+    msg.t3 = nowUs();
+    return encode(msg, out, capacity);
+}
+
+bool TimeSync::handleResponse(const uint8_t* in, size_t len, uint64_t rxUs) {
+    Message msg;
+    if (!decode(in, len, msg) || msg.type != MSG_RESPONSE ||
+        msg.seq != s_requestSeq) {
+        return false;
+    }
+    addExchange(msg.t1, msg.t2, msg.t3, rxUs);
+    return true;
+}
+
+ClockEstimator::Result TimeSync::addExchange(uint64_t t1, uint64_t t2,
+                                             uint64_t t3, uint64_t t4) {
+    bool wasLocked = s_estimator.isLocked();
+    ClockEstimator::Result result = s_estimator.addExchange(t1, t2, t3, t4);
+    if (result == ClockEstimator::Result::ACCEPTED ||
+        result == ClockEstimator::Result::STEPPED) {
+        publish(s_estimator.mapping(), s_estimator.isLocked());
+    }
+
+    if (result == ClockEstimator::Result::STEPPED) {
+        LOGW(TAG, "clock stepped by %lld us",
+             static_cast<long long>(s_estimator.lastResidualUs()));
+    } else if (!wasLocked && s_estimator.isLocked()) {
+        LOGI(TAG, "locked, offset %lld us, rate %ld ppb, delay %lu us",
+             static_cast<long long>(s_estimator.mapping().offset),
+             static_cast<long>(s_estimator.ratePpb()),
+             static_cast<unsigned long>(s_estimator.minDelayUs()));
+    }
+    return result;
+}
+
+void TimeSync::reset() {
+    s_estimator.reset();
+    publish(ClockMapping(), false);
+}
+
+const ClockEstimator& TimeSync::estimator() { return s_estimator; }
+
+uint64_t now_sync_us() { return TimeSync::nowUs(); }
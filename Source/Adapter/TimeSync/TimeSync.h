@@ -0,0 +1,94 @@
+#pragma once
+#ifndef _TIME_SYNC_H_
+#define _TIME_SYNC_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ClockEstimator.h"
+
+// 同步报文长度：magic u16, 版本 u8, 类型 u8, 序号 u32, t1/t2/t3 各 u64
+#define TIME_SYNC_MSG_SIZE 32
+
+/**
+ * @brief 同步时钟
+ *
+ * 主机直接使用本地 hal_hptimer 时钟作为主时钟；从机通过与主机的
+ * 双向时间戳交换（UDP 或 UWB 数据通道，见 UdpTimeSync）估计偏差和
+ * 频率漂移（ClockEstimator），把本地时钟换算为主时钟。
+ *
+ * 映射以序号保护发布，读取无锁（序号变化时重读），nowUs() 可在任务
+ * 和优先级不高于 configMAX_SYSCALL_INTERRUPT_PRIORITY 的中断中调用，
+ * 直接用作日志和连续性检测的同步时间回调：
+ *
+ *     Log::setSyncTimestampCallback(now_sync_us);
+ *     collector.setSyncTimeCallback(now_sync_us);
+ *
+ * 报文的编解码与传输无关：从机 makeRequest() 生成请求，主机收到后
+ * answerRequest() 生成回复，从机收到回复后 handleResponse()。接收
+ * 时刻由调用者在收到数据后尽早读取 hal_hptimer_get_us64() 传入。
+ * 估计器只由一个传输任务更新。
+ */
+class TimeSync {
+   public:
+    enum class Role : uint8_t { MASTER, SLAVE };
+
+    static void setRole(Role role);
+    static Role getRole();
+
+    // 同步时间（us）；未锁定时按当前映射（初始为本地时钟）换算
+    static uint64_t nowUs();
+    static uint64_t toSyncUs(uint64_t localUs);
+    static uint64_t toLocalUs(uint64_t syncUs);
+
+    /**
+     * @brief 阻塞到同步时间的某一时刻
+     *
+     * 换算为本地时刻后由 hal_hptimer_sleep_until_us() 唤醒，各从机
+     * 可以在同一个同步时刻动作（精度取决于同步误差）。
+     */
+    static void sleepUntilSyncUs(uint64_t syncUs);
+
+    static bool isLocked();
+
+    /**
+     * @brief 生成请求报文（从机），t1 取当前本地时间
+     * @return 报文长度，缓冲区不足时返回 0
+     */
+    static size_t makeRequest(uint8_t* out, size_t capacity);
+
+    /**
+     * @brief 回复请求报文（主机）
+     * @param rxUs 收到请求的本地时刻，作为 t2
+     * @return 回复长度，报文无效或缓冲区不足时返回 0
+     */
+    static size_t answerRequest(const uint8_t* in, size_t len, uint64_t rxUs,
+                                uint8_t* out, size_t capacity);
+
+    /**
+     * @brief 处理回复报文（从机）
+     * @param rxUs 收到回复的本地时刻，作为 t4
+     * @return 回复与最近一次请求匹配时返回 true（样本可能因延迟过大
+     *         被估计器丢弃）；过期或无效的回复返回 false
+     */
+    static bool handleResponse(const uint8_t* in, size_t len, uint64_t rxUs);
+
+    /**
+     * @brief 直接加入一次交换，用于自带时间戳的传输
+     *
+     * 时间戳必须是 hal_hptimer_get_us64() 时钟（本地）和主机的同一时钟。
+     */
+    static ClockEstimator::Result addExchange(uint64_t t1, uint64_t t2,
+                                              uint64_t t3, uint64_t t4);
+
+    // 丢弃估计结果，恢复为本地时钟
+    static void reset();
+
+    // 估计状态，仅供统计显示；由传输任务更新，读取不加锁
+    static const ClockEstimator& estimator();
+};
+
+// 同步时间（us），用于 C 代码和回调
+uint64_t now_sync_us();
+
+#endif
@@ -0,0 +1,250 @@
+#include "Trace.h"
+
+#include <cstring>
+
+#include "FreeRTOS.h"
+#include "LittleEndian.hpp"
+#include "gd32f4xx.h"
+#include "hal_hptimer.hpp"
+#include "task.h"
+
+static_assert((TRACE_BUFFER_EVENTS & (TRACE_BUFFER_EVENTS - 1)) == 0,
+              "TRACE_BUFFER_EVENTS must be a power of two");
+static_assert(sizeof(TraceEvent) == 8, "trace event layout changed");
+
+using LittleEndian::putU16;
+using LittleEndian::putU32;
+
+namespace {
+
+// 转储格式版本，修改记录布局时递增
+constexpr uint8_t DUMP_VERSION = 1;
+// 每条事件块记录的事件数：4 字节序号 + 28 * 8 不超过 DATA_MAX
+constexpr uint32_t EVENTS_PER_RECORD = 28;
+static_assert(4 + EVENTS_PER_RECORD * sizeof(TraceEvent) <=
+                  LogBinaryEncoder::DATA_MAX,
+              "trace event record exceeds data record size");
+
+struct TaskName {
+    uint16_t number;
+    char name[configMAX_TASK_NAME_LEN];
+};
+
+TraceEvent s_events[TRACE_BUFFER_EVENTS];
+volatile uint32_t s_head = 0;    // 开始以来写入的事件数
+volatile bool s_running = false;
+Trace::Mode s_mode = Trace::Mode::RING;
+volatile uint32_t s_mask = TRACE_CLASS_ALL;
+
+// 任务名称在记录停止时也登记，转储时附带
+TaskName s_names[TRACE_TASK_SLOTS];
+uint32_t s_nameCount = 0;    // 累计登记数，取模得到槽位
+
+inline uint32_t now() {
+#if TRACE_USE_DWT
+    return DWT->CYCCNT;
+#else
+    return hal_hptimer_get_us();
+#endif
+}
+
+void record(uint32_t cls, uint8_t type, uint8_t info, uint16_t id) {
+    if (!s_running || (s_mask & cls) == 0) return;
+
+    // 关中断而不是 BASEPRI，高于 configMAX_SYSCALL 的中断也可以记录
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t head = s_head;
+    if (s_running) {
+        if (s_mode == Trace::Mode::ONE_SHOT && head >= TRACE_BUFFER_EVENTS) {
+            s_running = false;
+        } else {
+            TraceEvent& e = s_events[head & (TRACE_BUFFER_EVENTS - 1)];
+            e.timestamp = now();
+            e.type = type;
+            e.info = info;
+            e.id = id;
+            s_head = head + 1;
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+inline uint16_t queueId(const void* queue) {
+    return static_cast<uint16_t>(reinterpret_cast<uintptr_t>(queue) >> 2);
+}
+
+/**
+ * 停止记录后按 头部、任务名称、事件块、结束 的顺序生成记录，
+ * send(type, data, size) 返回 false 时中止
+ */
+template <typename Send>
+bool emitDump(Send send) {
+    Trace::stop();
+
+    uint32_t head = s_head;
+    uint32_t count = head < TRACE_BUFFER_EVENTS ? head : TRACE_BUFFER_EVENTS;
+    uint32_t first = head - count;
+    uint8_t buf[LogBinaryEncoder::DATA_MAX];
+
+    buf[0] = DUMP_VERSION;
+    buf[1] = sizeof(TraceEvent);
+    putU32(buf + 2, Trace::clockHz());
+    putU32(buf + 6, count);
+    putU32(buf + 10, Trace::lost());
+    if (!send(LOG_DATA_TRACE_BEGIN, buf, 14)) return false;
+
+    uint32_t names = s_nameCount < TRACE_TASK_SLOTS ? s_nameCount
+                                                    : TRACE_TASK_SLOTS;
+    for (uint32_t i = 0; i < names; i++) {
+        const TaskName& t = s_names[i];
+        size_t len = strnlen(t.name, sizeof(t.name));
+        putU16(buf, t.number);
+        memcpy(buf + 2, t.name, len);
+        if (!send(LOG_DATA_TRACE_TASK, buf, 2 + len)) return false;
+    }
+
+    for (uint32_t i = 0; i < count; i += EVENTS_PER_RECORD) {
+        uint32_t n = count - i;
+        if (n > EVENTS_PER_RECORD) n = EVENTS_PER_RECORD;
+        putU32(buf, i);
+        // 事件按内存布局（小端）原样发出，可能跨过缓冲区末尾
+        for (uint32_t k = 0; k < n; k++) {
+            const TraceEvent& e =
+                s_events[(first + i + k) & (TRACE_BUFFER_EVENTS - 1)];
+            memcpy(buf + 4 + k * sizeof(TraceEvent), &e, sizeof(TraceEvent));
+        }
+        if (!send(LOG_DATA_TRACE_EVENTS, buf, 4 + n * sizeof(TraceEvent))) {
+            return false;
+        }
+    }
+
+    putU32(buf, count);
+    return send(LOG_DATA_TRACE_END, buf, 4);
+}
+
+}    // namespace
+
+extern "C" {
+
+void trace_task_switched_in(uint32_t task) {
+    record(TRACE_CLASS_TASK, TRACE_EVT_TASK_SWITCHED_IN, 0,
+           static_cast<uint16_t>(task));
+}
+
+void trace_task_switched_out(uint32_t task) {
+    record(TRACE_CLASS_TASK, TRACE_EVT_TASK_SWITCHED_OUT, 0,
+           static_cast<uint16_t>(task));
+}
+
+void trace_task_ready(uint32_t task) {
+    record(TRACE_CLASS_TASK, TRACE_EVT_TASK_READY, 0,
+           static_cast<uint16_t>(task));
+}
+
+void trace_task_create(uint32_t task, const char* name) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    TaskName& slot = s_names[s_nameCount % TRACE_TASK_SLOTS];
+    s_nameCount++;
+    __set_PRIMASK(primask);
+
+    slot.number = static_cast<uint16_t>(task);
+    strncpy(slot.name, name, sizeof(slot.name));
+    record(TRACE_CLASS_TASK, TRACE_EVT_TASK_CREATE, 0,
+           static_cast<uint16_t>(task));
+}
+
+void trace_task_delete(uint32_t task) {
+    record(TRACE_CLASS_TASK, TRACE_EVT_TASK_DELETE, 0,
+           static_cast<uint16_t>(task));
+}
+
+void trace_queue_send(const void* queue, uint8_t kind) {
+    record(TRACE_CLASS_QUEUE, TRACE_EVT_QUEUE_SEND, kind, queueId(queue));
+}
+
+void trace_queue_receive(const void* queue, uint8_t kind) {
+    record(TRACE_CLASS_QUEUE, TRACE_EVT_QUEUE_RECEIVE, kind, queueId(queue));
+}
+
+void trace_queue_block(const void* queue, uint8_t kind) {
+    record(TRACE_CLASS_QUEUE, TRACE_EVT_QUEUE_BLOCK, kind, queueId(queue));
+}
+
+void trace_isr_enter(void) {
+    record(TRACE_CLASS_ISR, TRACE_EVT_ISR_ENTER, 0,
+           static_cast<uint16_t>(__get_IPSR()));
+}
+
+void trace_isr_exit(void) {
+    record(TRACE_CLASS_ISR, TRACE_EVT_ISR_EXIT, 0,
+           static_cast<uint16_t>(__get_IPSR()));
+}
+
+}    // extern "C"
+
+void Trace::start(Mode mode) {
+#if TRACE_USE_DWT
+    LogIsr::enableCycleCounter();
+#endif
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    s_mode = mode;
+    s_head = 0;
+    s_running = true;
+    __set_PRIMASK(primask);
+}
+
+void Trace::stop() { s_running = false; }
+
+bool Trace::isRunning() { return s_running; }
+
+void Trace::setMask(uint32_t mask) { s_mask = mask; }
+
+uint32_t Trace::count() {
+    uint32_t head = s_head;
+    return head < TRACE_BUFFER_EVENTS ? head : TRACE_BUFFER_EVENTS;
+}
+
+uint32_t Trace::lost() {
+    uint32_t head = s_head;
+    return head > TRACE_BUFFER_EVENTS ? head - TRACE_BUFFER_EVENTS : 0;
+}
+
+uint32_t Trace::clockHz() {
+#if TRACE_USE_DWT
+    return SystemCoreClock;
+#else
+    return 1000000;
+#endif
+}
+
+void Trace::mark(uint16_t id) {
+    record(TRACE_CLASS_MARK, TRACE_EVT_MARK, 0, id);
+}
+
+bool Trace::dump(Logger::Level level) {
+    Logger* logger = Logger::getInstance();
+    if (logger == nullptr) return false;
+
+    return emitDump([&](uint8_t type, const uint8_t* data, size_t size) {
+        for (int retries = 0; !logger->writeData(level, type, data, size);) {
+            if (++retries >= 100) return false;
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+        return true;
+    });
+}
+
+void Trace::dump(ILogSink& sink) {
+    uint8_t frame[LOG_BINARY_FRAME_MAX];
+    emitDump([&](uint8_t type, const uint8_t* data, size_t size) {
+        size_t len = LogBinaryEncoder::encodeData(
+            frame, sizeof(frame), static_cast<uint8_t>(Logger::Level::RAW),
+            type, hal_hptimer_get_us(), data, size);
+        sink.write(frame, len);
+        return true;
+    });
+    sink.flush();
+}
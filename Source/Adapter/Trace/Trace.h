@@ -0,0 +1,122 @@
+#pragma once
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+#include <stdint.h>
+
+// 事件缓冲容量（条），须为 2 的幂；每条 8 字节
+#ifndef TRACE_BUFFER_EVENTS
+#define TRACE_BUFFER_EVENTS 1024
+#endif
+// 记录的任务名称数量，超出后覆盖最早的记录
+#ifndef TRACE_TASK_SLOTS
+#define TRACE_TASK_SLOTS 24
+#endif
+// 时间戳来源：0 为 TIMER1 微秒计数，1 为 DWT 周期计数（分辨率高，
+// 但 240MHz 下约 17.9s 回绕一次，空闲时间长的记录上位机无法展开）
+#ifndef TRACE_USE_DWT
+#define TRACE_USE_DWT 0
+#endif
+
+// 事件类型，与 Scripts/trace_to_chrome.py 一致
+#define TRACE_EVT_TASK_SWITCHED_IN  1
+#define TRACE_EVT_TASK_SWITCHED_OUT 2
+#define TRACE_EVT_TASK_READY        3
+#define TRACE_EVT_TASK_CREATE       4
+#define TRACE_EVT_TASK_DELETE       5
+#define TRACE_EVT_QUEUE_SEND        6
+#define TRACE_EVT_QUEUE_RECEIVE     7
+#define TRACE_EVT_QUEUE_BLOCK       8
+#define TRACE_EVT_ISR_ENTER         9
+#define TRACE_EVT_ISR_EXIT          10
+#define TRACE_EVT_MARK              11
+
+// 事件类别，Trace::setMask() 按类别开关
+#define TRACE_CLASS_TASK  (1u << 0)    // 切换、就绪、创建、删除
+#define TRACE_CLASS_QUEUE (1u << 1)    // 队列、信号量、互斥量
+#define TRACE_CLASS_ISR   (1u << 2)
+#define TRACE_CLASS_MARK  (1u << 3)    // Trace::mark()
+#define TRACE_CLASS_ALL   0x0F
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 内核钩子，由 FreeRTOSConfig.h 中的 trace 宏调用
+void trace_task_switched_in(uint32_t task);
+void trace_task_switched_out(uint32_t task);
+void trace_task_ready(uint32_t task);
+void trace_task_create(uint32_t task, const char *name);
+void trace_task_delete(uint32_t task);
+void trace_queue_send(const void *queue, uint8_t kind);
+void trace_queue_receive(const void *queue, uint8_t kind);
+void trace_queue_block(const void *queue, uint8_t kind);
+void trace_isr_enter(void);
+void trace_isr_exit(void);
+
+#ifdef __cplusplus
+}
+
+#include "Logger.h"
+
+/**
+ * @brief 调度跟踪事件，8 字节
+ * 任务事件 id 为任务编号（uxTCBNumber），队列事件 id 为队列地址 >> 2
+ * 的低 16 位、info 为队列类型，中断事件 id 为异常号（IPSR）
+ */
+struct TraceEvent {
+    uint32_t timestamp;
+    uint8_t type;
+    uint8_t info;
+    uint16_t id;
+};
+
+/**
+ * @brief 调度跟踪
+ *
+ * 内核钩子把任务切换、就绪、队列收发和中断进出写入内存环形缓冲，
+ * 每个事件只有一次计数器读取和 8 字节写入（关中断保护，任意优先级的
+ * 中断都可以调用）。停止后用 dump() 以结构化数据记录经日志输出端发出，
+ * 由 Scripts/trace_to_chrome.py 转换为 Chrome trace / Perfetto 可以打开的
+ * JSON。
+ */
+class Trace {
+   public:
+    enum class Mode {
+        RING,        // 循环覆盖，保留停止前最近的事件
+        ONE_SHOT     // 写满后自动停止，保留开始后的事件
+    };
+
+    // 清空缓冲区并开始记录
+    static void start(Mode mode = Mode::RING);
+    static void stop();
+    static bool isRunning();
+
+    // 按 TRACE_CLASS_* 选择记录的事件类别
+    static void setMask(uint32_t mask);
+
+    // 缓冲区中的事件数 / 被覆盖或丢弃的事件数
+    static uint32_t count();
+    static uint32_t lost();
+
+    // 时间戳频率（Hz）
+    static uint32_t clockHz();
+
+    // 用户标记，在跟踪视图中显示为瞬时事件
+    static void mark(uint16_t id);
+
+    /**
+     * @brief 停止记录并把缓冲区内容经日志输出端发出
+     * 日志缓冲区满时等待日志任务，单条记录重试 100 次后放弃；
+     * 各输出端须接收 level 级别的记录
+     * @return 日志未初始化或中途放弃时返回 false
+     */
+    static bool dump(Logger::Level level = Logger::Level::RAW);
+
+    // 停止记录并直接写入 sink，用于日志任务不再运行时（如故障处理）
+    static void dump(ILogSink& sink);
+};
+
+#endif
+
+#endif
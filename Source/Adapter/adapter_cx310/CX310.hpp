@@ -63,13 +63,13 @@ class CX310 {
             while (interface.get_system_1ms_ticks() - start_tick < timeout_ms) {
                 update();
                 if (uwbs_sta == READY) {
-                    Log::t(TAG, "software reset successfully");
+                    LOGT(TAG, "software reset successfully");
                     return true;
                 }
             }
         }
-        Log::e(TAG, "software reset fail");
-        Log::e(TAG, "hardware reset start");
+        LOGE(TAG, "software reset fail");
+        LOGE(TAG, "hardware reset start");
 
         interface.generate_reset_signal();
         interface.delay_ms(100);
@@ -78,11 +78,11 @@ class CX310 {
         while (interface.get_system_1ms_ticks() - start_tick < timeout_ms) {
             update();
             if (uwbs_sta == READY) {
-                Log::t(TAG, "hardware reset successfully");
+                LOGT(TAG, "hardware reset successfully");
                 return true;
             }
         }
-        Log::e(TAG, "UWBS hardware reset failed");
+        LOGE(TAG, "UWBS hardware reset failed");
         return false;
     }
 
@@ -98,10 +98,10 @@ class CX310 {
             return uci_cmd.check_core_set_config_rsp(rsp);
         };
         if (__send_packet()) {
-            Log::t(TAG, "set channel %d", channel);
+            LOGT(TAG, "set channel %d", channel);
             return true;
         }
-        Log::e(TAG, "set channel fail");
+        LOGE(TAG, "set channel fail");
         return false;
     }
 
@@ -121,14 +121,14 @@ class CX310 {
         };
         if (__send_packet()) {
             if (param_id != PARAM_CHANNEL_NUMBER_ID) {
-                Log::e(TAG, "get config id %d", param_id);
+                LOGE(TAG, "get config id %d", param_id);
                 return false;
             } else {
-                Log::t(TAG, "get channel %d", channel);
+                LOGT(TAG, "get channel %d", channel);
                 return true;
             }
         }
-        Log::e(TAG, "get channel fail");
+        LOGE(TAG, "get channel fail");
         return false;
     }
 
@@ -143,10 +143,10 @@ class CX310 {
             return uci_cmd.check_core_set_config_rsp(rsp);
         };
         if (__send_packet()) {
-            Log::t(TAG, "set prf mode %d", prf_mode);
+            LOGT(TAG, "set prf mode %d", prf_mode);
             return true;
         }
-        Log::e(TAG, "set prf mode fail");
+        LOGE(TAG, "set prf mode fail");
         return false;
     }
 
@@ -166,14 +166,14 @@ class CX310 {
         };
         if (__send_packet()) {
             if (param_id != PARAM_PRF_MODE_ID) {
-                Log::e(TAG, "get config id %d", param_id);
+                LOGE(TAG, "get config id %d", param_id);
                 return false;
             } else {
-                Log::t(TAG, "get prf mode %d", prf_mode);
+                LOGT(TAG, "get prf mode %d", prf_mode);
                 return true;
             }
         }
-        Log::e(TAG, "get prf mode fail");
+        LOGE(TAG, "get prf mode fail");
         return false;
     }
 
@@ -189,10 +189,10 @@ class CX310 {
             return uci_cmd.check_core_set_config_rsp(rsp);
         };
         if (__send_packet()) {
-            Log::t(TAG, "set preamble length %d", preamble_length);
+            LOGT(TAG, "set preamble length %d", preamble_length);
             return true;
         }
-        Log::e(TAG, "set preamble length fail");
+        LOGE(TAG, "set preamble length fail");
         return false;
     }
 
@@ -212,14 +212,14 @@ class CX310 {
         };
         if (__send_packet()) {
             if (param_id != PARAM_PREAMBLE_LENGTH_ID) {
-                Log::e(TAG, "get config id %d", param_id);
+                LOGE(TAG, "get config id %d", param_id);
                 return false;
             } else {
-                Log::t(TAG, "get preamble length %d", preamble_length);
+                LOGT(TAG, "get preamble length %d", preamble_length);
                 return true;
             }
         }
-        Log::e(TAG, "get preamble length fail");
+        LOGE(TAG, "get preamble length fail");
         return false;
     }
 
@@ -235,10 +235,10 @@ class CX310 {
             return uci_cmd.check_core_set_config_rsp(rsp);
         };
         if (__send_packet()) {
-            Log::t(TAG, "set preamble index %d", preamble_index);
+            LOGT(TAG, "set preamble index %d", preamble_index);
             return true;
         }
-        Log::e(TAG, "set preamble index fail");
+        LOGE(TAG, "set preamble index fail");
         return false;
     }
 
@@ -258,14 +258,14 @@ class CX310 {
         };
         if (__send_packet()) {
             if (param_id != PARAM_PREAMBLE_CODE_INDEX_ID) {
-                Log::e(TAG, "get config id %d", param_id);
+                LOGE(TAG, "get config id %d", param_id);
                 return false;
             } else {
-                Log::t(TAG, "get preamble index %d", preamble_index);
+                LOGT(TAG, "get preamble index %d", preamble_index);
                 return true;
             }
         }
-        Log::e(TAG, "get preamble index fail");
+        LOGE(TAG, "get preamble index fail");
         return false;
     }
 
@@ -281,10 +281,10 @@ class CX310 {
             return uci_cmd.check_core_set_config_rsp(rsp);
         };
         if (__send_packet()) {
-            Log::t(TAG, "set psdu data rate %d", psdu_data_rate);
+            LOGT(TAG, "set psdu data rate %d", psdu_data_rate);
             return true;
         }
-        Log::e(TAG, "set psdu data rate fail");
+        LOGE(TAG, "set psdu data rate fail");
         return false;
     }
 
@@ -304,14 +304,14 @@ class CX310 {
         };
         if (__send_packet()) {
             if (param_id != PARAM_PSDU_DATA_RATE_ID) {
-                Log::e(TAG, "get config id %d", param_id);
+                LOGE(TAG, "get config id %d", param_id);
                 return false;
             } else {
-                Log::t(TAG, "get psdu data rate %d", psdu_data_rate);
+                LOGT(TAG, "get psdu data rate %d", psdu_data_rate);
                 return true;
             }
         }
-        Log::e(TAG, "get psdu data rate fail");
+        LOGE(TAG, "get psdu data rate fail");
         return false;
     }
 
@@ -326,10 +326,10 @@ class CX310 {
             return uci_cmd.check_core_set_config_rsp(rsp);
         };
         if (__send_packet()) {
-            Log::t(TAG, "set phr mode %d", phr_mode);
+            LOGT(TAG, "set phr mode %d", phr_mode);
             return true;
         }
-        Log::e(TAG, "set phr mode fail");
+        LOGE(TAG, "set phr mode fail");
         return false;
     }
     bool get_phr_mode(uint8_t& phr_mode) {
@@ -348,14 +348,14 @@ class CX310 {
         };
         if (__send_packet()) {
             if (param_id != PARAM_PHR_MODE_ID) {
-                Log::e(TAG, "get config id %d", param_id);
+                LOGE(TAG, "get config id %d", param_id);
                 return false;
             } else {
-                Log::t(TAG, "get phr mode %d", phr_mode);
+                LOGT(TAG, "get phr mode %d", phr_mode);
                 return true;
             }
         }
-        Log::e(TAG, "get phr mode fail");
+        LOGE(TAG, "get phr mode fail");
         return false;
     }
     bool set_sfd_id(uint8_t sfd_id) {
@@ -369,10 +369,10 @@ class CX310 {
             return uci_cmd.check_core_set_config_rsp(rsp);
         };
         if (__send_packet()) {
-            Log::t(TAG, "set sfd id %d", sfd_id);
+            LOGT(TAG, "set sfd id %d", sfd_id);
             return true;
         }
-        Log::e(TAG, "set sfd id fail");
+        LOGE(TAG, "set sfd id fail");
         return false;
     }
 
@@ -392,14 +392,14 @@ class CX310 {
         };
         if (__send_packet()) {
             if (param_id != PARAM_SFD_ID_ID) {
-                Log::e(TAG, "get config id %d", param_id);
+                LOGE(TAG, "get config id %d", param_id);
                 return false;
             } else {
-                Log::t(TAG, "get sfd id %d", sfd_id);
+                LOGT(TAG, "get sfd id %d", sfd_id);
                 return true;
             }
         }
-        Log::e(TAG, "get sfd id fail");
+        LOGE(TAG, "get sfd id fail");
         return false;
     }
 
@@ -414,10 +414,10 @@ class CX310 {
             return uci_cmd.check_core_set_config_rsp(rsp);
         };
         if (__send_packet()) {
-            Log::t(TAG, "set tx power %d", tx_power);
+            LOGT(TAG, "set tx power %d", tx_power);
             return true;
         }
-        Log::e(TAG, "set tx power fail");
+        LOGE(TAG, "set tx power fail");
         return false;
     }
 
@@ -430,10 +430,10 @@ class CX310 {
             return uci_cmd.check_cx_set_hprf_rsp(rsp);
         };
         if (__send_packet()) {
-            Log::t(TAG, "set hprf");
+            LOGT(TAG, "set hprf");
             return true;
         }
-        Log::e(TAG, "set hprf fail");
+        LOGE(TAG, "set hprf fail");
         return false;
     }
     bool set_nooploop() {
@@ -445,10 +445,10 @@ class CX310 {
             return uci_cmd.check_cx_nooploop_rsp(rsp);
         };
         if (__send_packet()) {
-            Log::t(TAG, "set nooploop");
+            LOGT(TAG, "set nooploop");
             return true;
         }
-        Log::e(TAG, "set nooploop fail");
+        LOGE(TAG, "set nooploop fail");
         return false;
     }
 
@@ -461,7 +461,7 @@ class CX310 {
      */
     bool get_dev_info() {
         if (uwbs_sta != READY) {
-            Log::e(TAG, "UWBS not ready");
+            LOGE(TAG, "UWBS not ready");
             return false;
         }
 
@@ -472,16 +472,16 @@ class CX310 {
         };
 
         if (__send_packet()) {
-            Log::t(TAG,
-                   "uci generic version = 0x%.4X, mac version = 0x%.4X, "
-                   "phy version = 0x%.4X , uci test version = 0x%.4X",
-                   dev_info.uci_ver, dev_info.mac_ver, dev_info.phy_ver,
-                   dev_info.uci_test_ver);
+            LOGT(TAG,
+                 "uci generic version = 0x%.4X, mac version = 0x%.4X, "
+                 "phy version = 0x%.4X , uci test version = 0x%.4X",
+                 dev_info.uci_ver, dev_info.mac_ver, dev_info.phy_ver,
+                 dev_info.uci_test_ver);
 
             // uint8_t vendor_len=;
             return true;
         }
-        Log::e(TAG, "get device info fail");
+        LOGE(TAG, "get device info fail");
         return false;
     }
 
@@ -505,10 +505,10 @@ class CX310 {
         };
 
         if (__send_packet()) {
-            Log::i(TAG, "data transmit");
+            LOGI(TAG, "data transmit");
             return true;
         }
-        Log::e(TAG, "data transmit fail");
+        LOGE(TAG, "data transmit fail");
         return false;
     }
     bool data_transmit_tx_test(std::vector<uint8_t> data, uint16_t pack_size,
@@ -559,8 +559,8 @@ class CX310 {
                     }
                 } else {
                     if (pack_id < recv_cnt) {
-                        Log::e(TAG, "pack id = %u, recv_cnt = %u", pack_id,
-                               recv_cnt);
+                        LOGE(TAG, "pack id = %u, recv_cnt = %u", pack_id,
+                             recv_cnt);
                         return false;
                     }
                     if (pack_id != recv_cnt) {
@@ -568,15 +568,15 @@ class CX310 {
                         recv_cnt = pack_id;
                     }
                     recv_cnt++;
-                    // Log::t("UWB: recv recv_cnt = %d", recv_cnt);
+                    // LOGT("UWB: recv recv_cnt = %d", recv_cnt);
                     if (recv_cnt == pack_num) {
                         time_ms = interface.get_system_1ms_ticks() - start_tick;
-                        Log::t(TAG,
-                               "data transmit rx test: transmit pack = "
-                               "%u, loss pack = %u, "
-                               "time = %ums, transmit data = %uB",
-                               pack_num, loss_pack, time_ms,
-                               pack_num * pack_size);
+                        LOGT(TAG,
+                             "data transmit rx test: transmit pack = "
+                             "%u, loss pack = %u, "
+                             "time = %ums, transmit data = %uB",
+                             pack_num, loss_pack, time_ms,
+                             pack_num * pack_size);
                         return true;
                     }
                 }
@@ -600,10 +600,10 @@ class CX310 {
         };
 
         if (__send_packet()) {
-            Log::i(TAG, "set recv mode");
+            LOGI(TAG, "set recv mode");
             return true;
         }
-        Log::e(TAG, "set recv mode fail");
+        LOGE(TAG, "set recv mode fail");
         return false;
     }
 
@@ -642,10 +642,10 @@ class CX310 {
             return uci_cmd.check_cx_app_data_stop_rx_rsp(rsp);
         };
         if (__send_packet()) {
-            Log::t(TAG, "stop recv");
+            LOGT(TAG, "stop recv");
             return true;
         }
-        Log::e(TAG, "stop recv fail");
+        LOGE(TAG, "stop recv fail");
         return false;
     }
 
@@ -685,17 +685,17 @@ class CX310 {
         if (uwbs_sta == READY) {
             return true;
         }
-        Log::e(TAG, "UWBS not ready");
+        LOGE(TAG, "UWBS not ready");
         return false;
     }
     void __uwbs_state_machine() {
         switch (uwbs_sta) {
             case BOOT: {
-                // Log::t("UWB: boot");
+                // LOGT("UWB: boot");
                 break;
             }
             case READY: {
-                // Log::t("UWB: ready");
+                // LOGT("UWB: ready");
                 break;
             }
             case ACTIVE: {
@@ -730,7 +730,7 @@ class CX310 {
                 }
             }
         }
-        Log::e(TAG, "wait rsp timeout");
+        LOGE(TAG, "wait rsp timeout");
         return false;
     }
 
@@ -743,7 +743,7 @@ class CX310 {
                 if (recv_packet.mt == MT_NTF) {
                     __notify_process();
                 } else {
-                    Log::e(TAG, "unexpected rsp packet");
+                    LOGE(TAG, "unexpected rsp packet");
                 }
             }
         }
@@ -758,14 +758,14 @@ class CX310 {
                     if (sta == DEVICE_STATE_READY) {
                         if (uwbs_sta == BOOT) {
                             uwbs_sta = READY;
-                            Log::t(TAG, "UWBS move to active state");
+                            LOGT(TAG, "UWBS move to active state");
                         }
                     }
                     break;
                 }
                 default: {
-                    Log::t(TAG, "undealed notify: gid=0x00, oid=0x%.2X",
-                           recv_packet.oid);
+                    LOGT(TAG, "undealed notify: gid=0x00, oid=0x%.2X",
+                         recv_packet.oid);
                     break;
                 }
             }
@@ -775,30 +775,30 @@ class CX310 {
                 case CX_APP_DATA_TX_NTF: {
                     if (uci_ntf.parse_cx_app_data_tx_ntf(recv_packet.packet) !=
                         STATUS_OK) {
-                        Log::e(TAG, "parse data tx ntf fail");
+                        LOGE(TAG, "parse data tx ntf fail");
                     }
                     break;
                 }
                 case CX_APP_DATA_RX_NTF: {
                     if (!uci_ntf.parse_cx_app_data_rx_ntf(recv_packet.packet)) {
-                        Log::e(TAG, "parse data rx ntf fail");
+                        LOGE(TAG, "parse data rx ntf fail");
                     }
 
                     if (recv_packet.packet.size() < 2) {
-                        Log::e(TAG, "rx payload size is too small");
+                        LOGE(TAG, "rx payload size is too small");
                         break;
                     }
                     for (auto it = recv_packet.packet.begin() + 2;
                          it != recv_packet.packet.end(); it++) {
                         transparent_data.push(*it);
                     }
-                    // Log::t("UWB: data receive, size=%u",
+                    // LOGT("UWB: data receive, size=%u",
                     //               rx_payload.size() - 2);
                     break;
                 }
                 default: {
-                    Log::t(TAG, "undealed notify: gid=0x03, oid=0x%.2X",
-                           recv_packet.oid);
+                    LOGT(TAG, "undealed notify: gid=0x03, oid=0x%.2X",
+                         recv_packet.oid);
                     break;
                 }
             }
@@ -837,18 +837,18 @@ class CX310 {
             update();
             if (interface.get_system_1ms_ticks() - start_tick > 1000) {
                 // 超时
-                Log::e(TAG, "init wait ready timeout");
+                LOGE(TAG, "init wait ready timeout");
                 break;
             }
         }
         if (uwbs_sta == READY) {
             if (reset(1000)) {
                 init_success = true;
-                Log::t(TAG, "UWBS init success");
+                LOGT(TAG, "UWBS init success");
                 return;
             }
         }
-        Log::e(TAG, "UWBS init fail");
+        LOGE(TAG, "UWBS init fail");
 
         // 复位指令
         // __delay_ms(500);
@@ -877,7 +877,7 @@ class CX310 {
                         break;
                     }
                 } else {
-                    Log::e(TAG, "rsp check fail");
+                    LOGE(TAG, "rsp check fail");
                     ret = false;
                     break;
                 }
@@ -5,7 +5,7 @@
 
 #include "../../../HAL/exti/hal_exti.hpp"
 #include "../../../HAL/gpio/hal_gpio.hpp"
-#include "../../../HAL/spi/hal_spi.hpp"
+#include "../../../HAL/spi/hal_spi_bus.hpp"
 #include "hal_uart.hpp"
 #include "CX310.hpp"
 #include "FreeRTOScpp.h"
@@ -25,15 +25,19 @@ class CX310_SlaveSpiAdapter : public ICX310 {
     }
 
    private:
-    Spi_PeriphConfig spi_cfg = {
-        .prescale = SPI_PSC_8,
-        .clock_polarity_phase = SPI_CK_PL_LOW_PH_1EDGE,
-        .frame_size = SPI_FRAMESIZE_8BIT,
-        .endian = SPI_ENDIAN_MSB,
+    // SPI3 与 DW1000 共用，经 SpiBus 仲裁
+    SpiDeviceConfig spi_cfg = {
+        .periph = {.prescale = SPI_PSC_8,
+                   .clock_polarity_phase = SPI_CK_PL_LOW_PH_1EDGE,
+                   .frame_size = SPI_FRAMESIZE_8BIT,
+                   .endian = SPI_ENDIAN_MSB},
+        .nss_port = GPIOE,
+        .nss_pin = GPIO_PIN_4,
+        .cs_setup_loops = 100,
+        .priority = 1,
     };
 
-    SpiDev<SpiMode::Master>* spi_dev;
-    std::vector<NSS_IO> nss_io = {{GPIOE, GPIO_PIN_4}};
+    SpiDevice* spi_dev = nullptr;
 
     GPIO* en_pin;
     GPIO* rst_pin;
@@ -53,33 +57,75 @@ class CX310_SlaveSpiAdapter : public ICX310 {
     uint8_t rx_buffer[1024];
     uint16_t revc_len;
     BinarySemaphore rx_semaphore = {"rx_semaphore"};
-    long waswoken = 0;
     bool irq_enable = false;
 
+    // 读取一帧：4字节头部，数据长度在头部收到后确定
+    SpiSegment rx_seg[2];
+    SpiTransaction rx_trans;
+
     void int_pin_irq_handler() {
         if (!irq_enable) {
             return;
         }
-        if (int_pin.input_bit_get() == RESET) {
-            spi_dev->nss_low();
-            int a = 100;
-            while (a--) {
-                __NOP();
-            }
-            if (!spi_dev->recv_open_loop(rx_buffer, 4, 0)) {
-                spi_dev->nss_high();
-                
-            }
-            revc_len = (((uint16_t)rx_buffer[2]) << 8) | rx_buffer[3];
-            if (!spi_dev->recv_open_loop(rx_buffer + 4, revc_len, 0)) {
-                spi_dev->nss_high();
+        // 上一帧尚未读完时由 rx_done 检查 INT 电平后补读
+        if (int_pin.input_bit_get() == RESET && !rx_trans.busy()) {
+            prepare_rx();
+            spi_dev->submit_ISR(rx_trans);
+        }
+    }
+
+    void prepare_rx() {
+        rx_seg[0] = {nullptr, rx_buffer, 4};
+        rx_seg[1] = {nullptr, rx_buffer + 4, 0};
+        rx_trans.seg = rx_seg;
+        rx_trans.count = 2;
+        rx_trans.priority = 2;
+        rx_trans.fill = 0;
+        rx_trans.on_phase = &CX310_SlaveSpiAdapter::rx_phase;
+        rx_trans.on_done = &CX310_SlaveSpiAdapter::rx_done;
+        rx_trans.arg = this;
+    }
+
+    static bool rx_phase(SpiTransaction& t, size_t index) {
+        CX310_SlaveSpiAdapter* self = static_cast<CX310_SlaveSpiAdapter*>(t.arg);
+        if (index == 1) {
+            uint16_t len =
+                (((uint16_t)self->rx_buffer[2]) << 8) | self->rx_buffer[3];
+            if (len > sizeof(self->rx_buffer) - 4) {
+                len = sizeof(self->rx_buffer) - 4;
             }
-            spi_dev->nss_high();
+            self->revc_len = len;
+            t.seg[1].len = len;
+        }
+        return true;
+    }
 
-            rx_semaphore.give_ISR(waswoken);
+    static void rx_done(SpiTransaction& t) {
+        CX310_SlaveSpiAdapter* self = static_cast<CX310_SlaveSpiAdapter*>(t.arg);
+        if (t.ok) {
+            self->rx_semaphore.give();
+        }
+        // 读取期间到来的下降沿不会再触发提交，INT 仍为低电平时继续读下一帧
+        if (self->int_pin.input_bit_get() == RESET) {
+            self->prepare_rx();
+            self->spi_dev->submit(t);
         }
     }
 
+    // 片选拉低后等待 RDY 变为低电平再发送，轮询间隔 1 tick
+    static bool wait_ready(SpiTransaction& t, size_t index) {
+        CX310_SlaveSpiAdapter* self = static_cast<CX310_SlaveSpiAdapter*>(t.arg);
+        uint32_t start_time = self->get_system_1ms_ticks();
+        while (self->rdy_pin.input_bit_get() == SET) {
+            if (self->get_system_1ms_ticks() - start_time > 1000) {
+                return false;
+            }
+            // 在总线任务中等待，让出CPU给低优先级任务
+            vTaskDelay(1);
+        }
+        return true;
+    }
+
    public:
     void reset_pin_init() override {
         rst_pin = new GPIO(GPIO::Port::E, GPIO::Pin::PIN_3, GPIO::Mode::OUTPUT);
@@ -88,22 +134,14 @@ class CX310_SlaveSpiAdapter : public ICX310 {
     void generate_reset_signal() override { rst_pin->bit_reset(); }
     void turn_of_reset_signal() override { rst_pin->bit_set(); }
     bool send(std::vector<uint8_t>& tx_data) override {
-        bool ret = false;
-
-        spi_dev->nss_low();
-
-        uint32_t start_time = get_system_1ms_ticks();
-        while (rdy_pin.input_bit_get() == SET) {
-            // 等待RDY引脚变为低电平
-            if (get_system_1ms_ticks() - start_time > 1000) {
-                // 超时处理，返回错误或其他适当的操作
-                spi_dev->nss_high();
-                return false;
-            }
-        }
-        ret = spi_dev->send(tx_data);
-        spi_dev->nss_high();
-        return ret;
+        SpiSegment seg = {tx_data.data(), nullptr, (uint32_t)tx_data.size()};
+        SpiTransaction t;
+        t.seg = &seg;
+        t.count = 1;
+        t.priority = spi_cfg.priority;
+        t.on_phase = &CX310_SlaveSpiAdapter::wait_ready;
+        t.arg = this;
+        return spi_dev->transact(t);
     }
 
     bool get_recv_data(std::queue<uint8_t>& rx_data) override {
@@ -118,8 +156,8 @@ class CX310_SlaveSpiAdapter : public ICX310 {
     }
 
     void commuication_peripheral_init() override {
-        spi_dev = new SpiDev<SpiMode::Master>(SPI3_E6MOSI_E5MISO_E2SCLK_E11NSS,
-                                              nss_io, spi_cfg);
+        // 总线任务以DMA传输长帧，等待期间CPU可运行UCI解析等任务
+        spi_dev = new SpiDevice(spi3_bus(), spi_cfg);
         // std::vector<uint8_t> tx_data = {0x00, 0x01, 0x02, 0x03};
         // spi_dev->send_open_loop(tx_data);
         irq_enable = true;
@@ -143,6 +181,6 @@ class CX310_SlaveSpiAdapter : public ICX310 {
         char buffer[256];
         vsnprintf(buffer, sizeof(buffer), format, args);
         va_end(args);
-        Log::d("UWB", buffer);
+        LOGD("UWB", buffer);
     }
 };
\ No newline at end of file
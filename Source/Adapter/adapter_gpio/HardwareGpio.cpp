@@ -4,23 +4,37 @@
 
 namespace Adapter {
 
+// 端口索引到GPIO基地址的映射（与 getPortFromPin 保持一致）
+static constexpr uint32_t PORT_BASE_TABLE[GPIO_PORT_COUNT] = {
+    GPIOA, GPIOB, GPIOC, GPIOD, GPIOE, GPIOF, GPIOG};
+
+// 将16位引脚掩码展开为32位寄存器中每引脚2位的字段（bit n -> bit 2n）
+static inline uint32_t spreadPinMask(uint16_t mask) {
+    uint32_t x = mask;
+    x = (x | (x << 8)) & 0x00FF00FFU;
+    x = (x | (x << 4)) & 0x0F0F0F0FU;
+    x = (x | (x << 2)) & 0x33333333U;
+    x = (x | (x << 1)) & 0x55555555U;
+    return x;
+}
+
 HardwareGpio::HardwareGpio() {
 }
 
 bool HardwareGpio::init(const GpioConfig &config) {
-    Log::t("HardwareGpio", "init pin: %d", config.pin);
+    LOGT("HardwareGpio", "init pin: %d", config.pin);
     GPIO::Port port = getPortFromPin(config.pin);
-    Log::t("HardwareGpio", "port: %d", port);
+    LOGT("HardwareGpio", "port: %d", port);
     GPIO::Pin pin = getPinFromPin(config.pin);
-    Log::t("HardwareGpio", "pin: %d", pin);
+    LOGT("HardwareGpio", "pin: %d", pin);
     GPIO::Mode mode = convertMode(config.mode);
-    Log::t("HardwareGpio", "mode: %d", mode);
+    LOGT("HardwareGpio", "mode: %d", mode);
     GPIO::PullUpDown pullUpDown = convertPullUpDown(config.mode);
-    Log::t("HardwareGpio", "pullUpDown: %d", pullUpDown);
+    LOGT("HardwareGpio", "pullUpDown: %d", pullUpDown);
 
     // 创建GPIO实例
     auto gpio = std::make_unique<GPIO>(port, pin, mode, pullUpDown);
-    Log::t("HardwareGpio", "gpio: %p", gpio.get());
+    LOGT("HardwareGpio", "gpio: %p", gpio.get());
 
     // 如果是输出模式，设置初始状态
     if (config.mode == GpioMode::OUTPUT) {
@@ -33,8 +47,8 @@ bool HardwareGpio::init(const GpioConfig &config) {
 
     // 存储GPIO实例
     gpioMap[config.pin] = std::move(gpio);
-    Log::t("HardwareGpio", "gpioMap[%d] = %p", config.pin,
-           gpioMap[config.pin].get());
+    LOGT("HardwareGpio", "gpioMap[%d] = %p", config.pin,
+         gpioMap[config.pin].get());
     return true;
 }
 
@@ -92,6 +106,61 @@ bool HardwareGpio::deinit(uint8_t pin) {
     return false;
 }
 
+bool HardwareGpio::readPortSnapshot(uint16_t *snapshot, uint8_t portCount) {
+    if (snapshot == nullptr || portCount > GPIO_PORT_COUNT) {
+        return false;
+    }
+
+    // 直接背靠背读取各端口 ISTAT 寄存器，使端口间采样偏差最小
+    for (uint8_t i = 0; i < portCount; i++) {
+        snapshot[i] = static_cast<uint16_t>(GPIO_ISTAT(PORT_BASE_TABLE[i]));
+    }
+    return true;
+}
+
+bool HardwareGpio::configurePort(uint8_t port, uint16_t pinMask,
+                                 GpioMode mode, GpioState initState) {
+    if (port >= GPIO_PORT_COUNT) {
+        return false;
+    }
+    if (pinMask == 0) {
+        return true;
+    }
+
+    uint32_t base = PORT_BASE_TABLE[port];
+    uint32_t spread = spreadPinMask(pinMask);
+    uint32_t fieldMask = spread * 3U;
+    uint32_t modeValue = static_cast<uint32_t>(convertMode(mode));
+    uint32_t pullValue = static_cast<uint32_t>(convertPullUpDown(mode));
+
+    // 定时扫描在 TIMER4 中断中调用，与任务中的配置可能改写同一端口寄存器，
+    // 读-改-写期间屏蔽中断（可在任务和中断中使用）
+    UBaseType_t irqMask = taskENTER_CRITICAL_FROM_ISR();
+    if ((enabledPortClocks & (1U << port)) == 0) {
+        rcu_periph_clock_enable(
+            GPIO::get_rcu_port(static_cast<GPIO::Port>(base)));
+        enabledPortClocks |= static_cast<uint8_t>(1U << port);
+    }
+
+    if (mode == GpioMode::OUTPUT) {
+        // 先确定输出电平，再设置推挽/速度，最后切换模式
+        if (initState == GpioState::HIGH) {
+            GPIO_BOP(base) = pinMask;
+        } else {
+            GPIO_BC(base) = pinMask;
+        }
+        GPIO_OMODE(base) &= ~static_cast<uint32_t>(pinMask);
+        GPIO_OSPD(base) =
+            (GPIO_OSPD(base) & ~fieldMask) | (spread * GPIO_OSPEED_50MHZ);
+    }
+
+    // 每个寄存器一次读-改-写
+    GPIO_PUD(base) = (GPIO_PUD(base) & ~fieldMask) | (spread * pullValue);
+    GPIO_CTL(base) = (GPIO_CTL(base) & ~fieldMask) | (spread * modeValue);
+    taskEXIT_CRITICAL_FROM_ISR(irqMask);
+    return true;
+}
+
 // 私有辅助函数实现
 GPIO::Mode HardwareGpio::convertMode(GpioMode mode) {
     switch (mode) {
@@ -25,11 +25,17 @@ class HardwareGpio : public IGpio {
     std::vector<GpioState> readMultiple(
         const std::vector<uint8_t> &pins) override;
     bool deinit(uint8_t pin) override;
+    bool readPortSnapshot(uint16_t *snapshot, uint8_t portCount) override;
+    bool configurePort(uint8_t port, uint16_t pinMask, GpioMode mode,
+                       GpioState initState = GpioState::LOW) override;
 
    private:
     // 存储GPIO实例的映射
     std::map<uint8_t, std::unique_ptr<GPIO>> gpioMap;
 
+    // 已通过批量配置使能时钟的端口（bit n 对应端口 n）
+    uint8_t enabledPortClocks = 0;
+
     // 辅助函数：将接口枚举转换为hal_gpio枚举
     GPIO::Mode convertMode(GpioMode mode);
     GPIO::PullUpDown convertPullUpDown(GpioMode mode);
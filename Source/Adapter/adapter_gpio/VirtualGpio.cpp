@@ -64,4 +64,39 @@ bool VirtualGpio::deinit(uint8_t pin) {
     return false;
 }
 
+bool VirtualGpio::readPortSnapshot(uint16_t *snapshot, uint8_t portCount) {
+    if (snapshot == nullptr || portCount > GPIO_PORT_COUNT) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < portCount; i++) {
+        snapshot[i] = 0;
+    }
+
+    // 与 read() 语义一致：只有已初始化且为高电平的引脚置位
+    for (const auto &entry : pinMap) {
+        uint8_t port = entry.first / GPIO_PINS_PER_PORT;
+        if (port < portCount && entry.second.initialized &&
+            entry.second.state == GpioState::HIGH) {
+            snapshot[port] |= static_cast<uint16_t>(
+                1U << (entry.first % GPIO_PINS_PER_PORT));
+        }
+    }
+    return true;
+}
+
+bool VirtualGpio::configurePort(uint8_t port, uint16_t pinMask, GpioMode mode,
+                                GpioState initState) {
+    if (port >= GPIO_PORT_COUNT) {
+        return false;
+    }
+
+    for (uint8_t bit = 0; bit < GPIO_PINS_PER_PORT; bit++) {
+        if (pinMask & (1U << bit)) {
+            init(GpioConfig(port * GPIO_PINS_PER_PORT + bit, mode, initState));
+        }
+    }
+    return true;
+}
+
 } // namespace Adapter 
\ No newline at end of file
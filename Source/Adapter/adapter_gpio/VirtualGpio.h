@@ -21,6 +21,9 @@ class VirtualGpio : public IGpio {
     bool setMode(uint8_t pin, GpioMode mode) override;
     std::vector<GpioState> readMultiple(const std::vector<uint8_t> &pins) override;
     bool deinit(uint8_t pin) override;
+    bool readPortSnapshot(uint16_t *snapshot, uint8_t portCount) override;
+    bool configurePort(uint8_t port, uint16_t pinMask, GpioMode mode,
+                       GpioState initState = GpioState::LOW) override;
 
   private:
     struct PinInfo {
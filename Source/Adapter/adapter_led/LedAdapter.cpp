@@ -210,7 +210,7 @@ bool LedAdapter::setPhysicalState(LedType type, bool on) {
     }
     
     GpioState state = on ? GpioState::HIGH : GpioState::LOW;
-    // Log::d("LedAdapter", "setPhysicalState: pin=%d, state=%d", it->second.pin, state);
+    // LOGD("LedAdapter", "setPhysicalState: pin=%d, state=%d", it->second.pin, state);
     return gpio->write(it->second.pin, state);
 }
 
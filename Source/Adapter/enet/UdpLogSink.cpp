@@ -0,0 +1,63 @@
+#include "UdpLogSink.h"
+
+#include <cstring>
+
+#include "lwip/api.h"
+
+UdpLogSink::UdpLogSink() : destPort(LOG_UDP_PORT) {
+    IP_ADDR4(&destAddr, IP_S_ADDR0, IP_S_ADDR1, IP_S_ADDR2, IP_S_ADDR3);
+}
+
+UdpLogSink::UdpLogSink(const char *host, uint16_t port) : destPort(port) {
+    if (!ipaddr_aton(host, &destAddr)) {
+        ip_addr_set_zero(&destAddr);
+    }
+}
+
+UdpLogSink::~UdpLogSink() { close(); }
+
+bool UdpLogSink::open() {
+    if (conn != nullptr) {
+        return true;
+    }
+    conn = netconn_new(NETCONN_UDP);
+    return conn != nullptr;
+}
+
+void UdpLogSink::close() {
+    if (conn != nullptr) {
+        netconn_delete(conn);
+        conn = nullptr;
+    }
+    fill = 0;
+}
+
+void UdpLogSink::write(const uint8_t *data, size_t len) {
+    if (conn == nullptr) {
+        return;
+    }
+    if (fill + len > LOG_UDP_PAYLOAD) {
+        flush();
+    }
+    if (len > LOG_UDP_PAYLOAD) {
+        len = LOG_UDP_PAYLOAD;
+    }
+    memcpy(datagram + fill, data, len);
+    fill += len;
+}
+
+void UdpLogSink::flush() {
+    if (fill == 0) {
+        return;
+    }
+    if (conn != nullptr) {
+        // netconn_sendto 在 tcpip 线程处理完后返回，引用的缓存可立即复用
+        struct netbuf buf;
+        memset(&buf, 0, sizeof(buf));
+        if (netbuf_ref(&buf, datagram, fill) == ERR_OK) {
+            netconn_sendto(conn, &buf, &destAddr, destPort);
+        }
+        netbuf_free(&buf);
+    }
+    fill = 0;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#ifndef UDP_LOG_SINK_H
+#define UDP_LOG_SINK_H
+
+#include "LogSink.h"
+#include "lwip/ip_addr.h"
+#include "netcfg.h"
+
+struct netconn;
+
+// 默认发往 netcfg.h 中的远端地址，端口同 syslog
+#define LOG_UDP_PORT 514
+// 单个数据报的最大负载：以太网 MTU 1500 - IP 头 20 - UDP 头 8
+#define LOG_UDP_PAYLOAD 1472
+
+/**
+ * @brief UDP 输出端
+ *
+ * 多条记录合并为一个不超过 MTU 的数据报，缓存写满或 flush() 时发送。
+ * 上位机可用 `nc -ul 514` 查看文本日志，二进制格式用
+ * `nc -ul 514 | log_decoder.py firmware.elf -` 解析。
+ * 在 LwIP 初始化完成后调用 open()；未打开或发送失败时丢弃记录。
+ */
+class UdpLogSink : public ILogSink {
+   public:
+    UdpLogSink();
+    UdpLogSink(const char* host, uint16_t port = LOG_UDP_PORT);
+    ~UdpLogSink() override;
+
+    UdpLogSink(const UdpLogSink&) = delete;
+    UdpLogSink& operator=(const UdpLogSink&) = delete;
+
+    bool open();
+    void close();
+    bool isOpen() const { return conn != nullptr; }
+
+    void write(const uint8_t* data, size_t len) override;
+    void flush() override;
+
+   private:
+    struct netconn* conn = nullptr;
+    ip_addr_t destAddr;
+    uint16_t destPort;
+    uint8_t datagram[LOG_UDP_PAYLOAD];
+    size_t fill = 0;
+};
+
+#endif /* UDP_LOG_SINK_H */
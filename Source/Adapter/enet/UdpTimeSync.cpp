@@ -0,0 +1,135 @@
+#include "UdpTimeSync.h"
+
+#include <cstring>
+
+#include "Logger.h"
+#include "hal_hptimer.hpp"
+#include "lwip/api.h"
+
+static constexpr const char* TAG = "UdpTimeSync";
+
+UdpTimeSync::UdpTimeSync(TimeSync::Role role, uint16_t port)
+    : TaskClassS<TIME_SYNC_TASK_DEPTH>("TimeSync", TaskPrio_High),
+      role(role),
+      port(port) {
+    IP_ADDR4(&masterAddr, IP_S_ADDR0, IP_S_ADDR1, IP_S_ADDR2, IP_S_ADDR3);
+    TimeSync::setRole(role);
+    // 调度器已运行时由最终的构造函数启动任务
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+        this->give();
+    }
+}
+
+UdpTimeSync::UdpTimeSync(const char* masterHost, uint16_t port)
+    : TaskClassS<TIME_SYNC_TASK_DEPTH>("TimeSync", TaskPrio_High),
+      role(TimeSync::Role::SLAVE),
+      port(port) {
+    if (!ipaddr_aton(masterHost, &masterAddr)) {
+        ip_addr_set_zero(&masterAddr);
+    }
+    TimeSync::setRole(role);
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+        this->give();
+    }
+}
+
+UdpTimeSync::~UdpTimeSync() {
+    if (conn != nullptr) {
+        netconn_delete(conn);
+        conn = nullptr;
+    }
+}
+
+void UdpTimeSync::task() {
+    conn = netconn_new(NETCONN_UDP);
+    if (conn == nullptr) {
+        LOGE(TAG, "netconn_new failed");
+        return;
+    }
+
+    // 从机绑定任意端口，回复发回请求的源端口
+    err_t err = netconn_bind(conn, IP_ADDR_ANY,
+                             role == TimeSync::Role::MASTER ? port : 0);
+    if (err != ERR_OK) {
+        LOGE(TAG, "bind port %u failed: %d", port, err);
+        return;
+    }
+
+    if (role == TimeSync::Role::MASTER) {
+        serve();
+    } else {
+        poll();
+    }
+}
+
+void UdpTimeSync::serve() {
+    LOGI(TAG, "serving on port %u", port);
+    uint8_t in[TIME_SYNC_MSG_SIZE];
+    uint8_t out[TIME_SYNC_MSG_SIZE];
+    for (;;) {
+        struct netbuf* buf = nullptr;
+        if (netconn_recv(conn, &buf) != ERR_OK) {
+            continue;
+        }
+        // 接收时刻越早越准，在解析之前读取
+        uint64_t rxUs = hal_hptimer_get_us64();
+        uint16_t len = netbuf_copy(buf, in, sizeof(in));
+        ip_addr_t from = *netbuf_fromaddr(buf);
+        uint16_t fromPort = netbuf_fromport(buf);
+        netbuf_delete(buf);
+
+        size_t n = TimeSync::answerRequest(in, len, rxUs, out, sizeof(out));
+        if (n == 0) {
+            continue;
+        }
+        struct netbuf reply;
+        memset(&reply, 0, sizeof(reply));
+        if (netbuf_ref(&reply, out, static_cast<u16_t>(n)) == ERR_OK) {
+            netconn_sendto(conn, &reply, &from, fromPort);
+            exchangeCount++;
+        }
+        netbuf_free(&reply);
+    }
+}
+
+void UdpTimeSync::poll() {
+    LOGI(TAG, "syncing to %s:%u", ipaddr_ntoa(&masterAddr), port);
+    netconn_set_recvtimeout(conn, TIME_SYNC_REPLY_TIMEOUT_MS);
+
+    TickType_t wake = xTaskGetTickCount();
+    for (;;) {
+        if (exchange()) {
+            exchangeCount++;
+        }
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(TIME_SYNC_PERIOD_MS));
+    }
+}
+
+bool UdpTimeSync::exchange() {
+    uint8_t msg[TIME_SYNC_MSG_SIZE];
+    size_t n = TimeSync::makeRequest(msg, sizeof(msg));
+
+    struct netbuf request;
+    memset(&request, 0, sizeof(request));
+    bool sent = netbuf_ref(&request, msg, static_cast<u16_t>(n)) == ERR_OK &&
+                netconn_sendto(conn, &request, &masterAddr, port) == ERR_OK;
+    netbuf_free(&request);
+    if (!sent) {
+        return false;
+    }
+
+    // 之前超时的回复可能晚到，序号不符的由 TimeSync 丢弃，继续等待
+    for (;;) {
+        struct netbuf* buf = nullptr;
+        if (netconn_recv(conn, &buf) != ERR_OK) {
+            timeoutCount++;
+            return false;
+        }
+        uint64_t rxUs = hal_hptimer_get_us64();
+        uint16_t len = netbuf_copy(buf, msg, sizeof(msg));
+        netbuf_delete(buf);
+        if (TimeSync::handleResponse(msg, len, rxUs)) {
+            return true;
+        }
+    }
+}
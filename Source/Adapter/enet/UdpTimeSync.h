@@ -0,0 +1,59 @@
+#pragma once
+#ifndef UDP_TIME_SYNC_H
+#define UDP_TIME_SYNC_H
+
+#include "TaskCPP.h"
+#include "TimeSync.h"
+#include "lwip/ip_addr.h"
+#include "netcfg.h"
+
+struct netconn;
+
+// 主机监听的端口（PTP 事件端口）
+#define TIME_SYNC_UDP_PORT 319
+// 从机请求周期
+#define TIME_SYNC_PERIOD_MS 1000
+// 从机等待回复的超时，超时的交换直接放弃
+#define TIME_SYNC_REPLY_TIMEOUT_MS 50
+#define TIME_SYNC_TASK_DEPTH 512
+
+/**
+ * @brief UDP 时间同步
+ *
+ * 主机任务回复收到的每个请求；从机任务每 TIME_SYNC_PERIOD_MS 向主机
+ * 发送一次请求，收到回复后交给 TimeSync 估计。
+ *
+ * 时间戳在 netconn 层读取，包含 tcpip 线程的调度延迟；本任务优先级
+ * 较高，不对称的排队延迟由估计器按往返延迟筛除。在 LwIP 初始化完成
+ * 后创建。
+ */
+class UdpTimeSync : public TaskClassS<TIME_SYNC_TASK_DEPTH> {
+   public:
+    // 从机默认向 netcfg.h 中的远端地址请求
+    explicit UdpTimeSync(TimeSync::Role role,
+                         uint16_t port = TIME_SYNC_UDP_PORT);
+    UdpTimeSync(const char* masterHost, uint16_t port = TIME_SYNC_UDP_PORT);
+    ~UdpTimeSync() override;
+
+    UdpTimeSync(const UdpTimeSync&) = delete;
+    UdpTimeSync& operator=(const UdpTimeSync&) = delete;
+
+    void task() override;
+
+    uint32_t exchanges() const { return exchangeCount; }
+    uint32_t timeouts() const { return timeoutCount; }
+
+   private:
+    void serve();
+    void poll();
+    bool exchange();
+
+    TimeSync::Role role;
+    struct netconn* conn = nullptr;
+    ip_addr_t masterAddr;
+    uint16_t port;
+    uint32_t exchangeCount = 0;
+    uint32_t timeoutCount = 0;
+};
+
+#endif /* UDP_TIME_SYNC_H */
@@ -55,29 +55,29 @@ int EthDevice::init() {
         /* configure ethernet (GPIOs, clocks, MAC, DMA) */
         ret = Enet::enet_system_setup();
         if (0 != ret) {
-            Log::e("ETH", "enet_system_setup failed, exiting eth_device_init");
+            LOGE("ETH", "enet_system_setup failed, exiting eth_device_init");
             return 1;
         }
-        Log::t("ETH", "ethernet initialized");
+        LOGT("ETH", "ethernet initialized");
 
         /* initilaize the LwIP stack */
         lwip_stack_init();
-        Log::t("ETH", "lwip stack initialized");
+        LOGT("ETH", "lwip stack initialized");
         initialized = true;
     }
     return 0;
 }
 
 void EthDevice::lwip_netif_status_callback(struct netif *netif) {
-    // Log::t("LWIP", "netif status changed: %d", netif->flags);
+    // LOGT("LWIP", "netif status changed: %d", netif->flags);
     // // logd addr
-    // Log::t("LWIP", "netif addr: %d.%d.%d.%d", ip4_addr1_16(&netif->ip_addr),
-    //       ip4_addr2_16(&netif->ip_addr), ip4_addr3_16(&netif->ip_addr),
-    //       ip4_addr4_16(&netif->ip_addr));
+    // LOGT("LWIP", "netif addr: %d.%d.%d.%d", ip4_addr1_16(&netif->ip_addr),
+    //     ip4_addr2_16(&netif->ip_addr), ip4_addr3_16(&netif->ip_addr),
+    //     ip4_addr4_16(&netif->ip_addr));
     // if (((netif->flags & NETIF_FLAG_UP) != 0) && (0 != netif->ip_addr.addr))
     // {
     //     /* initilaize the udp: echo 1025 */
-    //     Log::t("LWIP", "udp echo initialized");
+    //     LOGT("LWIP", "udp echo initialized");
     // }
 }
 
@@ -94,32 +94,32 @@ void EthDevice::lwip_stack_init(void) {
 
     /* create tcp_ip stack thread */
     tcpip_init(NULL, NULL);
-    Log::t("LWIP", "tcpip_init initialized");
+    LOGT("LWIP", "tcpip_init initialized");
 
     /* IP address setting */
     IP4_ADDR(&ipaddr, IP_ADDR0, IP_ADDR1, IP_ADDR2, IP_ADDR3);
-    Log::t("LWIP", "static ip address set to %d.%d.%d.%d", ip4_addr1_16(&ipaddr),
-          ip4_addr2_16(&ipaddr), ip4_addr3_16(&ipaddr), ip4_addr4_16(&ipaddr));
+    LOGT("LWIP", "static ip address set to %d.%d.%d.%d", ip4_addr1_16(&ipaddr),
+        ip4_addr2_16(&ipaddr), ip4_addr3_16(&ipaddr), ip4_addr4_16(&ipaddr));
     IP4_ADDR(&netmask, NETMASK_ADDR0, NETMASK_ADDR1, NETMASK_ADDR2,
              NETMASK_ADDR3);
-    Log::t("LWIP", "netmask set to %d.%d.%d.%d", ip4_addr1_16(&netmask),
-          ip4_addr2_16(&netmask), ip4_addr3_16(&netmask),
-          ip4_addr4_16(&netmask));
+    LOGT("LWIP", "netmask set to %d.%d.%d.%d", ip4_addr1_16(&netmask),
+        ip4_addr2_16(&netmask), ip4_addr3_16(&netmask),
+        ip4_addr4_16(&netmask));
     IP4_ADDR(&gw, GW_ADDR0, GW_ADDR1, GW_ADDR2, GW_ADDR3);
-    Log::t("LWIP", "gateway set to %d.%d.%d.%d", ip4_addr1_16(&gw),
-          ip4_addr2_16(&gw), ip4_addr3_16(&gw), ip4_addr4_16(&gw));
+    LOGT("LWIP", "gateway set to %d.%d.%d.%d", ip4_addr1_16(&gw),
+        ip4_addr2_16(&gw), ip4_addr3_16(&gw), ip4_addr4_16(&gw));
 
     netif_add(&g_mynetif, &ipaddr, &netmask, &gw, NULL, &ethernetif_init,
               &tcpip_input);
-    Log::t("LWIP", "ethernet interface added");
+    LOGT("LWIP", "ethernet interface added");
 
     /* registers the default network interface */
     netif_set_default(&g_mynetif);
-    Log::t("LWIP", "default network interface set");
+    LOGT("LWIP", "default network interface set");
     netif_set_status_callback(&g_mynetif, lwip_netif_status_callback);
-    Log::t("LWIP", "network interface status callback set");
+    LOGT("LWIP", "network interface status callback set");
 
     /* when the netif is fully configured this function must be called */
     netif_set_up(&g_mynetif);
-    Log::t("LWIP", "network interface set up");
+    LOGT("LWIP", "network interface set up");
 }
@@ -150,8 +150,11 @@ extern void vAssertCalled(const char *file, int line);
 /* Each task has an array of task notifications.
  * configTASK_NOTIFICATION_ARRAY_ENTRIES sets the number of indexes in the
  * array. See https://www.freertos.org/RTOS-task-notifications.html  Defaults to
- * 1 if left undefined. */
-#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+ * 1 if left undefined. Index 1 is reserved for SPI DMA completion
+ * (SPI_DMA_NOTIFY_INDEX), index 2 for UART TX/RX (UART_NOTIFY_INDEX), index 3
+ * for timed scan completion (SCAN_NOTIFY_INDEX) and the last index for
+ * hal_hptimer_sleep_until_us(). */
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 5
 
 /* configQUEUE_REGISTRY_SIZE sets the maximum number of queues and semaphores
  * that can be referenced from the queue registry.  Only required when using a
@@ -401,6 +404,53 @@ extern unsigned long getRunTimeCounterValue(void);
  * undefined. */
 #define configUSE_TRACE_FACILITY 1
 
+/* 调度跟踪钩子：任务切换、就绪、队列收发和中断进出写入内存环形缓冲，
+ * 实现见 Adapter/Trace。钩子在 Trace::start() 之前只检查一次标志。
+ * 定义为 0 时不编译进内核。 */
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+
+#if TRACE_ENABLED
+extern void trace_task_switched_in(uint32_t task);
+extern void trace_task_switched_out(uint32_t task);
+extern void trace_task_ready(uint32_t task);
+extern void trace_task_create(uint32_t task, const char *name);
+extern void trace_task_delete(uint32_t task);
+extern void trace_queue_send(const void *queue, uint8_t kind);
+extern void trace_queue_receive(const void *queue, uint8_t kind);
+extern void trace_queue_block(const void *queue, uint8_t kind);
+extern void trace_isr_enter(void);
+extern void trace_isr_exit(void);
+
+/* 以下宏在 tasks.c / queue.c 中展开，可以直接访问 TCB 和队列结构 */
+#define traceTASK_SWITCHED_IN()  trace_task_switched_in(pxCurrentTCB->uxTCBNumber)
+#define traceTASK_SWITCHED_OUT() trace_task_switched_out(pxCurrentTCB->uxTCBNumber)
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB) \
+    trace_task_ready((pxTCB)->uxTCBNumber)
+#define traceTASK_CREATE(pxNewTCB) \
+    trace_task_create((pxNewTCB)->uxTCBNumber, (pxNewTCB)->pcTaskName)
+#define traceTASK_DELETE(pxTCB) trace_task_delete((pxTCB)->uxTCBNumber)
+
+#define traceQUEUE_SEND(pxQueue) \
+    trace_queue_send((pxQueue), (pxQueue)->ucQueueType)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) \
+    trace_queue_send((pxQueue), (pxQueue)->ucQueueType)
+#define traceQUEUE_RECEIVE(pxQueue) \
+    trace_queue_receive((pxQueue), (pxQueue)->ucQueueType)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) \
+    trace_queue_receive((pxQueue), (pxQueue)->ucQueueType)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) \
+    trace_queue_block((pxQueue), (pxQueue)->ucQueueType)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) \
+    trace_queue_block((pxQueue), (pxQueue)->ucQueueType)
+
+/* SysTick 由移植层调用；其他中断在入口/出口调用 traceISR_ENTER()/traceISR_EXIT() */
+#define traceISR_ENTER()             trace_isr_enter()
+#define traceISR_EXIT()              trace_isr_exit()
+#define traceISR_EXIT_TO_SCHEDULER() trace_isr_exit()
+#endif
+
 /* Set to 1 to include the vTaskList() and vTaskGetRunTimeStats() functions in
  * the build.  Set to 0 to exclude these functions from the build.  These two
  * functions introduce a dependency on string formatting functions that would
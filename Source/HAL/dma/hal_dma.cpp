@@ -0,0 +1,93 @@
+#include "hal_dma.hpp"
+
+#define DMA_CONTROLLER_NUM 2
+#define DMA_CHANNEL_NUM    8
+
+typedef struct {
+    hal_dma_cb_t cb;
+    void *arg;
+} dma_handler_t;
+
+static dma_handler_t s_handlers[DMA_CONTROLLER_NUM][DMA_CHANNEL_NUM];
+
+static const IRQn_Type s_irqn[DMA_CONTROLLER_NUM][DMA_CHANNEL_NUM] = {
+    {DMA0_Channel0_IRQn, DMA0_Channel1_IRQn, DMA0_Channel2_IRQn,
+     DMA0_Channel3_IRQn, DMA0_Channel4_IRQn, DMA0_Channel5_IRQn,
+     DMA0_Channel6_IRQn, DMA0_Channel7_IRQn},
+    {DMA1_Channel0_IRQn, DMA1_Channel1_IRQn, DMA1_Channel2_IRQn,
+     DMA1_Channel3_IRQn, DMA1_Channel4_IRQn, DMA1_Channel5_IRQn,
+     DMA1_Channel6_IRQn, DMA1_Channel7_IRQn},
+};
+
+static int controller_index(uint32_t dma_periph)
+{
+    if (dma_periph == DMA0) {
+        return 0;
+    }
+    if (dma_periph == DMA1) {
+        return 1;
+    }
+    return -1;
+}
+
+int hal_dma_irqn(uint32_t dma_periph, dma_channel_enum channel)
+{
+    int index = controller_index(dma_periph);
+    if (index < 0 || (uint32_t)channel >= DMA_CHANNEL_NUM) {
+        return -1;
+    }
+    return s_irqn[index][channel];
+}
+
+bool hal_dma_register(uint32_t dma_periph, dma_channel_enum channel,
+                      hal_dma_cb_t cb, void *arg, uint8_t pre_priority)
+{
+    int index = controller_index(dma_periph);
+    if (index < 0 || (uint32_t)channel >= DMA_CHANNEL_NUM || cb == nullptr) {
+        return false;
+    }
+
+    s_handlers[index][channel].arg = arg;
+    s_handlers[index][channel].cb = cb;
+    nvic_irq_enable(s_irqn[index][channel], pre_priority, 0);
+    return true;
+}
+
+void hal_dma_unregister(uint32_t dma_periph, dma_channel_enum channel)
+{
+    int index = controller_index(dma_periph);
+    if (index < 0 || (uint32_t)channel >= DMA_CHANNEL_NUM) {
+        return;
+    }
+
+    nvic_irq_disable(s_irqn[index][channel]);
+    s_handlers[index][channel].cb = nullptr;
+    s_handlers[index][channel].arg = nullptr;
+}
+
+static inline void dispatch(int index, uint32_t dma_periph, dma_channel_enum channel)
+{
+    const dma_handler_t *handler = &s_handlers[index][channel];
+    if (handler->cb != nullptr) {
+        handler->cb(dma_periph, channel, handler->arg);
+    }
+}
+
+extern "C" {
+void DMA0_Channel0_IRQHandler(void) { dispatch(0, DMA0, DMA_CH0); }
+void DMA0_Channel1_IRQHandler(void) { dispatch(0, DMA0, DMA_CH1); }
+void DMA0_Channel2_IRQHandler(void) { dispatch(0, DMA0, DMA_CH2); }
+void DMA0_Channel3_IRQHandler(void) { dispatch(0, DMA0, DMA_CH3); }
+void DMA0_Channel4_IRQHandler(void) { dispatch(0, DMA0, DMA_CH4); }
+void DMA0_Channel5_IRQHandler(void) { dispatch(0, DMA0, DMA_CH5); }
+void DMA0_Channel6_IRQHandler(void) { dispatch(0, DMA0, DMA_CH6); }
+void DMA0_Channel7_IRQHandler(void) { dispatch(0, DMA0, DMA_CH7); }
+void DMA1_Channel0_IRQHandler(void) { dispatch(1, DMA1, DMA_CH0); }
+void DMA1_Channel1_IRQHandler(void) { dispatch(1, DMA1, DMA_CH1); }
+void DMA1_Channel2_IRQHandler(void) { dispatch(1, DMA1, DMA_CH2); }
+void DMA1_Channel3_IRQHandler(void) { dispatch(1, DMA1, DMA_CH3); }
+void DMA1_Channel4_IRQHandler(void) { dispatch(1, DMA1, DMA_CH4); }
+void DMA1_Channel5_IRQHandler(void) { dispatch(1, DMA1, DMA_CH5); }
+void DMA1_Channel6_IRQHandler(void) { dispatch(1, DMA1, DMA_CH6); }
+void DMA1_Channel7_IRQHandler(void) { dispatch(1, DMA1, DMA_CH7); }
+}
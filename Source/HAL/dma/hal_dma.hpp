@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "gd32f4xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief DMA interrupt dispatch HAL
+ *
+ * Owns the DMA0/DMA1 channel interrupt vectors and forwards each one to the
+ * callback registered for that channel. Drivers (UART, SPI, ...) register a
+ * handler instead of defining the vector themselves, so several drivers can
+ * share the DMA controllers without conflicting IRQ handler definitions.
+ *
+ * The callback runs in interrupt context and is responsible for reading and
+ * clearing the channel's interrupt flags.
+ */
+
+/**
+ * @brief DMA channel interrupt callback
+ */
+typedef void (*hal_dma_cb_t)(uint32_t dma_periph, dma_channel_enum channel, void *arg);
+
+/**
+ * @brief Register an interrupt handler for a DMA channel and enable its IRQ
+ *
+ * @param dma_periph   DMA0 or DMA1
+ * @param channel      DMA channel
+ * @param cb           Callback invoked from the channel interrupt
+ * @param arg          User argument passed to the callback
+ * @param pre_priority NVIC pre-emption priority for the channel IRQ
+ * @return true on success, false if the channel is invalid
+ */
+bool hal_dma_register(uint32_t dma_periph, dma_channel_enum channel,
+                      hal_dma_cb_t cb, void *arg, uint8_t pre_priority);
+
+/**
+ * @brief Remove the handler of a DMA channel and disable its IRQ
+ */
+void hal_dma_unregister(uint32_t dma_periph, dma_channel_enum channel);
+
+/**
+ * @brief Get the NVIC interrupt number of a DMA channel
+ *
+ * @return IRQ number, or -1 for an invalid channel
+ */
+int hal_dma_irqn(uint32_t dma_periph, dma_channel_enum channel);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2169,7 +2169,7 @@ void _dwt_loaducodefromrom(void)
     // Kick off the LDE load
     dwt_write16bitoffsetreg(OTP_IF_ID, OTP_CTRL, OTP_CTRL_LDELOAD); // Set load LDE kick bit
 
-    deca_sleep(1); // Allow time for code to upload (should take up to 120 us)
+    deca_usleep(150); // Allow time for code to upload (should take up to 120 us)
 
     // Default clocks (ENABLE_ALL_SEQ)
     _dwt_enableclocks(ENABLE_ALL_SEQ); // Enable clocks for sequencing
@@ -2333,9 +2333,22 @@ void decamutexoff(decaIrqStatus_t s);
  */
 void deca_sleep(unsigned int time_ms);
 
-extern uint32_t dw1000_spi;
-extern uint32_t dw1000_spi_nss_port;
-extern uint32_t dw1000_spi_nss_pin;
+/*!
+ * ------------------------------------------------------------------------------------------------------------------
+ * @fn deca_usleep()
+ *
+ * @brief Wait for a given amount of time in microseconds.
+ * NB: The body of this function is defined in deca_sleep.c and is platform
+ * specific
+ *
+ * input parameters:
+ * @param time_us - time to wait in microseconds
+ *
+ * output parameters
+ *
+ * no return value
+ */
+void deca_usleep(unsigned int time_us);
 
 #ifdef __cplusplus
 }
@@ -9,13 +9,18 @@
 #include "TaskCPP.h"
 #include "deca_device_api.h"
 #include "deca_regs.h"
+#include "deca_spi.h"
 #include "gd32f4xx.h"
 #include "gd32f4xx_usart.h"
+#include "hal_spi_bus.hpp"
 
 class DW1000 {
    public:
     DW1000() : _is_initialized(false), _rx_enabled(false) {}
-    ~DW1000() {}
+    ~DW1000() {
+        deca_spi_attach(nullptr);
+        delete _spi;
+    }
     
     bool init() {
         __spi3_init();         // 初始化SPI3
@@ -26,7 +31,7 @@ class DW1000 {
         
         // 初始化DW1000
         if (dwt_initialise(DWT_LOADNONE) == DWT_ERROR) {
-            Log::e("DW1000", "Init Failed");
+            LOGE("DW1000", "Init Failed");
             return false;
         }
         
@@ -37,7 +42,7 @@ class DW1000 {
         dwt_configure(&_config);
         
         _is_initialized = true;
-        Log::i("DW1000", "Init Success");
+        LOGI("DW1000", "Init Success");
         return true;
     }
 
@@ -150,6 +155,18 @@ class DW1000 {
    private:
     bool _is_initialized;
     bool _rx_enabled;
+    SpiDevice* _spi = nullptr;
+
+    SpiDeviceConfig _spi_cfg = {
+        .periph = {.prescale = SPI_PSC_128,
+                   .clock_polarity_phase = SPI_CK_PL_LOW_PH_1EDGE,
+                   .frame_size = SPI_FRAMESIZE_8BIT,
+                   .endian = SPI_ENDIAN_MSB},
+        .nss_port = GPIOE,
+        .nss_pin = GPIO_PIN_4,
+        .cs_setup_loops = 0,
+        .priority = 1,
+    };
     
     // DW1000配置结构体
     dwt_config_t _config = {
@@ -165,79 +182,21 @@ class DW1000 {
         (1025 + 64 - 32) /* SFD timeout (preamble length + 1 + SFD length - PAC size). Used in RX only. */
     };
     
+    // SPI3 与 CX310 共用，经 SpiBus 仲裁；片选 PE4
     void __spi3_init() {
-        dw1000_spi = SPI3;
-        dw1000_spi_nss_pin = GPIO_PIN_4;    // PE4 NSS
-        dw1000_spi_nss_port = GPIOE;
-
-        rcu_periph_clock_enable(RCU_GPIOE);
-        rcu_periph_clock_enable(RCU_SPI3);
-        spi_parameter_struct spi_init_struct;
-
-        // PE2 CLK  PE4 NSS  PE5 MISO   PE6 MOSI
-        gpio_af_set(GPIOE, GPIO_AF_5, GPIO_PIN_2 | GPIO_PIN_5 | GPIO_PIN_6);
-        gpio_mode_set(GPIOE, GPIO_MODE_AF, GPIO_PUPD_NONE,
-                      GPIO_PIN_2 | GPIO_PIN_5 | GPIO_PIN_6);
-        gpio_output_options_set(GPIOE, GPIO_OTYPE_PP, GPIO_OSPEED_50MHZ,
-                                GPIO_PIN_2 | GPIO_PIN_5 | GPIO_PIN_6);
-
-        gpio_mode_set(GPIOE, GPIO_MODE_OUTPUT, GPIO_PUPD_NONE,
-                      GPIO_PIN_4);    // NSS
-        gpio_output_options_set(GPIOE, GPIO_OTYPE_PP, GPIO_OSPEED_50MHZ,
-                                GPIO_PIN_4);
-
-        gpio_mode_set(GPIOE, GPIO_MODE_OUTPUT, GPIO_PUPD_NONE,
-                      GPIO_PIN_3);    // RST
-        gpio_output_options_set(GPIOE, GPIO_OTYPE_PP, GPIO_OSPEED_50MHZ,
-                                GPIO_PIN_3);
-
-        gpio_bit_set(GPIOE, GPIO_PIN_4);
-
-        spi_init_struct.trans_mode = SPI_TRANSMODE_FULLDUPLEX;
-        spi_init_struct.device_mode = SPI_MASTER;
-        spi_init_struct.frame_size = SPI_FRAMESIZE_8BIT;
-        spi_init_struct.clock_polarity_phase = SPI_CK_PL_LOW_PH_1EDGE;
-        spi_init_struct.nss = SPI_NSS_SOFT;
-        spi_init_struct.prescale = SPI_PSC_128;
-        spi_init_struct.endian = SPI_ENDIAN_MSB;
-        spi_init(SPI3, &spi_init_struct);
-
-        spi_nss_output_disable(SPI3);
-        spi_enable(SPI3);
+        if (_spi == nullptr) {
+            _spi = new SpiDevice(spi3_bus(), _spi_cfg);
+            deca_spi_attach(_spi);
+        }
     }
 
+    // 设置只影响本设备的事务，总线在切换设备时重新配置
     void __port_set_dw1000_slowrate_spi3(void) {
-        spi_disable(SPI3);
-
-        spi_parameter_struct spi_init_struct;
-        spi_struct_para_init(&spi_init_struct);
-        spi_init_struct.device_mode = SPI_MASTER;
-        spi_init_struct.trans_mode = SPI_TRANSMODE_FULLDUPLEX;
-        spi_init_struct.frame_size = SPI_FRAMESIZE_8BIT;
-        spi_init_struct.endian = SPI_ENDIAN_MSB;
-        spi_init_struct.nss = SPI_NSS_SOFT;
-        spi_init_struct.clock_polarity_phase = SPI_CK_PL_LOW_PH_1EDGE;
-        spi_init_struct.prescale = SPI_PSC_128;  // 慢速初始化
-        spi_init(SPI3, &spi_init_struct);
-
-        spi_enable(SPI3);
+        _spi->set_prescale(SPI_PSC_128);  // 慢速初始化
     }
 
     void __port_set_dw1000_fastrate_spi3(void) {
-        spi_disable(SPI3);
-
-        spi_parameter_struct spi_init_struct;
-        spi_struct_para_init(&spi_init_struct);
-        spi_init_struct.device_mode = SPI_MASTER;
-        spi_init_struct.trans_mode = SPI_TRANSMODE_FULLDUPLEX;
-        spi_init_struct.frame_size = SPI_FRAMESIZE_8BIT;
-        spi_init_struct.endian = SPI_ENDIAN_MSB;
-        spi_init_struct.nss = SPI_NSS_SOFT;
-        spi_init_struct.clock_polarity_phase = SPI_CK_PL_LOW_PH_1EDGE;
-        spi_init_struct.prescale = SPI_PSC_16;  // 高速运行
-        spi_init(SPI3, &spi_init_struct);
-
-        spi_enable(SPI3);
+        _spi->set_prescale(SPI_PSC_16);  // 高速运行
     }
 
     void __hardware_reset() {
@@ -17,7 +17,7 @@ void dw1000_tx_example() {
     
     // 初始化DW1000
     if (!dw1000.init()) {
-        Log::e("DW1000_TX", "Failed to initialize DW1000");
+        LOGE("DW1000_TX", "Failed to initialize DW1000");
         return;
     }
     
@@ -27,9 +27,9 @@ void dw1000_tx_example() {
     while (true) {
         // 发送数据
         if (dw1000.data_transmit(tx_data)) {
-            Log::i("DW1000_TX", "Data sent successfully");
+            LOGI("DW1000_TX", "Data sent successfully");
         } else {
-            Log::e("DW1000_TX", "Failed to send data");
+            LOGE("DW1000_TX", "Failed to send data");
         }
         
         // 等待1秒后再次发送
@@ -48,29 +48,29 @@ void dw1000_rx_example() {
     
     // 初始化DW1000
     if (!dw1000.init()) {
-        Log::e("DW1000_RX", "Failed to initialize DW1000");
+        LOGE("DW1000_RX", "Failed to initialize DW1000");
         return;
     }
     
     // 启动接收模式
     if (!dw1000.set_recv_mode()) {
-        Log::e("DW1000_RX", "Failed to set receive mode");
+        LOGE("DW1000_RX", "Failed to set receive mode");
         return;
     }
     
-    Log::i("DW1000_RX", "Receiver started, waiting for data...");
+    LOGI("DW1000_RX", "Receiver started, waiting for data...");
     
     std::vector<uint8_t> rx_data;
     
     while (true) {
         // 检查是否有数据接收
         if (dw1000.get_recv_data(rx_data)) {
-            Log::i("DW1000_RX", "Received %d bytes", rx_data.size());
+            LOGI("DW1000_RX", "Received %d bytes", rx_data.size());
             
             // 打印接收到的数据（作为字符串）
             if (rx_data.size() > 0) {
                 std::string received_str(rx_data.begin(), rx_data.end());
-                Log::i("DW1000_RX", "Data: %s", received_str.c_str());
+                LOGI("DW1000_RX", "Data: %s", received_str.c_str());
             }
         }
         
@@ -87,7 +87,7 @@ void dw1000_duplex_example() {
     DW1000 dw1000;
     
     if (!dw1000.init()) {
-        Log::e("DW1000_DUPLEX", "Failed to initialize DW1000");
+        LOGE("DW1000_DUPLEX", "Failed to initialize DW1000");
         return;
     }
     
@@ -101,11 +101,11 @@ void dw1000_duplex_example() {
     while (true) {
         // 检查接收
         if (dw1000.get_recv_data(rx_data)) {
-            Log::i("DW1000_DUPLEX", "Received message, sending response");
+            LOGI("DW1000_DUPLEX", "Received message, sending response");
             
             // 收到数据后发送响应
             if (dw1000.data_transmit(tx_data)) {
-                Log::i("DW1000_DUPLEX", "Response sent");
+                LOGI("DW1000_DUPLEX", "Response sent");
             }
             
             // 重新启动接收
@@ -117,7 +117,7 @@ void dw1000_duplex_example() {
         if (current_time - last_tx_time > 5000) {
             std::vector<uint8_t> heartbeat = {'H', 'E', 'A', 'R', 'T', 'B', 'E', 'A', 'T'};
             if (dw1000.data_transmit(heartbeat)) {
-                Log::i("DW1000_DUPLEX", "Heartbeat sent");
+                LOGI("DW1000_DUPLEX", "Heartbeat sent");
             }
             dw1000.set_recv_mode();  // 发送后重新启动接收
             last_tx_time = current_time;
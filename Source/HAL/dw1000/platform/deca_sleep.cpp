@@ -13,11 +13,21 @@
 
 #include "deca_device_api.h"
 #include "sleep.h"
-#include "TaskCPP.h"
+#include "hal_hptimer.hpp"
 
 /* Wrapper function to be used by decadriver. Declared in deca_device_api.h */
+/* A tick delay of n can end just after the next tick, i.e. in less than n ms;
+ * the microsecond timer always waits at least the requested time. */
 void deca_sleep(unsigned int time_ms)
 {
-	TaskBase::delay(time_ms);
+	hal_hptimer_init(); /* no-op once initialized; the driver may run first */
+	hal_hptimer_sleep_us(time_ms * 1000U);
+}
+
+/* Wrapper function to be used by decadriver. Declared in deca_device_api.h */
+void deca_usleep(unsigned int time_us)
+{
+	hal_hptimer_init();
+	hal_hptimer_sleep_us(time_us);
 }
 
@@ -0,0 +1,65 @@
+/*! ----------------------------------------------------------------------------
+ * @file    deca_spi.cpp
+ * @brief   SPI access functions
+ *
+ * @attention
+ *
+ * Copyright 2015 (c) DecaWave Ltd, Dublin, Ireland.
+ *
+ * All rights reserved.
+ *
+ * @author DecaWave
+ */
+
+#include "deca_spi.h"
+
+#include "deca_device_api.h"
+#include "hal_spi_bus.hpp"
+
+// 由 DW1000::init() 挂到共享总线上
+static SpiDevice *s_dw1000_spi = nullptr;
+
+void deca_spi_attach(SpiDevice *dev) { s_dw1000_spi = dev; }
+
+// 初始化在 DW1000::init() 中执行，此处留空
+int openspi(/*SPI_TypeDef* SPIx*/) { return 0; }
+
+int closespi(void) { return 0; }
+
+/*
+header 与 body 作为同一事务的两段，片选只拉低一次，全部传输结束后再拉高；
+事务由总线任务执行，与同一总线上的其他设备互斥。
+只能在任务上下文调用：中断里 SpiBus::transact 直接失败，DW1000 中断应通知任务执行 dwt_isr()
+*/
+int writetospi(uint16_t headerLength, const uint8_t *headerBuffer,
+               uint32_t bodyLength, const uint8_t *bodyBuffer) {
+    configASSERT(xPortIsInsideInterrupt() == pdFALSE);
+    if (s_dw1000_spi == nullptr) {
+        return DWT_ERROR;
+    }
+    SpiSegment seg[2] = {{headerBuffer, nullptr, headerLength},
+                         {bodyBuffer, nullptr, bodyLength}};
+
+    decaIrqStatus_t stat = decamutexon();
+    bool ok = s_dw1000_spi->transact(seg, 2);
+    decamutexoff(stat);
+    return ok ? DWT_SUCCESS : DWT_ERROR;
+}
+
+/*
+读数据时向从机发送 0xFF，调用上下文限制同 writetospi
+*/
+int readfromspi(uint16_t headerLength, const uint8_t *headerBuffer,
+                uint32_t readlength, uint8_t *readBuffer) {
+    configASSERT(xPortIsInsideInterrupt() == pdFALSE);
+    if (s_dw1000_spi == nullptr) {
+        return DWT_ERROR;
+    }
+    SpiSegment seg[2] = {{headerBuffer, nullptr, headerLength},
+                         {nullptr, readBuffer, readlength}};
+
+    decaIrqStatus_t stat = decamutexon();
+    bool ok = s_dw1000_spi->transact(seg, 2, 0xFF);
+    decamutexoff(stat);
+    return ok ? DWT_SUCCESS : DWT_ERROR;
+}
@@ -40,6 +40,20 @@ int closespi(void) ;
 
 #ifdef __cplusplus
 }
+
+class SpiDevice;
+
+/*! ------------------------------------------------------------------------------------------------------------------
+ * Function: deca_spi_attach()
+ *
+ * Route writetospi()/readfromspi() through a device on a shared SpiBus, so the DW1000 can share the bus with other
+ * devices. Must be called before dwt_initialise().
+ *
+ * Bus transactions block on the bus task, so every decadriver call that touches the SPI, dwt_isr() included, must run
+ * in task context. Service the DW1000 IRQ by notifying a task that calls dwt_isr(); do not call it from the EXTI
+ * handler (port_set_deca_isr() style). ISR callers trip configASSERT() and get DWT_ERROR.
+ */
+void deca_spi_attach(SpiDevice *dev);
 #endif
 
 #endif /* _DECA_SPI_H_ */
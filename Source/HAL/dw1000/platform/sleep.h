@@ -28,6 +28,15 @@ extern "C" {
  */
 void deca_sleep(unsigned int time_ms);
 
+/*! ------------------------------------------------------------------------------------------------------------------
+ * Function: deca_usleep()
+ *
+ * Wait for a given amount of time, blocking the calling task on the microsecond timer.
+ *
+ * param  time_us  time to wait in microseconds
+ */
+void deca_usleep(unsigned int time_us);
+
 #ifdef __cplusplus
 }
 #endif
@@ -48,21 +48,21 @@ __IO uint32_t Enet::enet_init_status = 0;
 */
 int Enet::enet_system_setup(void) {
     nvic_configuration();
-    Log::t("ENET", "nvic_configuration done");
+    LOGT("ENET", "nvic_configuration done");
 
     enet_gpio_config();
-    Log::t("ENET", "enet_gpio_config done");
+    LOGT("ENET", "enet_gpio_config done");
 
     enet_mac_dma_config();
     if (0 == enet_init_status) {
-        Log::e("ENET", "enet_mac_dma_config failed, exiting enet_system_setup");
+        LOGE("ENET", "enet_mac_dma_config failed, exiting enet_system_setup");
         return 1;
     }
-    Log::t("ENET", "enet_mac_dma_config done");
+    LOGT("ENET", "enet_mac_dma_config done");
 
     enet_interrupt_enable(ENET_DMA_INT_NIE);
     enet_interrupt_enable(ENET_DMA_INT_RIE);
-    Log::t("ENET", "enet_interrupt_enable done");
+    LOGT("ENET", "enet_interrupt_enable done");
     return 0;
 }
 
@@ -82,12 +82,12 @@ void Enet::enet_mac_dma_config(void) {
 
     /* reset ethernet on AHB bus */
     enet_deinit();
-    Log::t("ENET", "enet_deinit done");
+    LOGT("ENET", "enet_deinit done");
 
     reval_state = enet_software_reset();
-    Log::t("ENET", "enet_software_reset reval_state= %d\n", reval_state);
+    LOGT("ENET", "enet_software_reset reval_state= %d\n", reval_state);
     if (ERROR == reval_state) {
-        Log::e("ENET", "enet_software_reset ERROR");
+        LOGE("ENET", "enet_software_reset ERROR");
         enet_init_status = 0;    // 标记初始化失败
         return;                  // 退出 enet_mac_dma_config 函数
     }
@@ -101,7 +101,7 @@ void Enet::enet_mac_dma_config(void) {
     enet_init_status =
         enet_init(ENET_AUTO_NEGOTIATION, ENET_AUTOCHECKSUM_DROP_FAILFRAMES,
                   ENET_BROADCAST_FRAMES_PASS);
-    Log::t("ENET", "enet_init reval_state= %d\n", enet_init_status);
+    LOGT("ENET", "enet_init reval_state= %d\n", enet_init_status);
 }
 
 /*!
@@ -189,5 +189,5 @@ void Enet::enet_gpio_config(void) {
     gpio_af_set(GPIOC, GPIO_AF_11, GPIO_PIN_1);
     gpio_af_set(GPIOC, GPIO_AF_11, GPIO_PIN_4);
     gpio_af_set(GPIOC, GPIO_AF_11, GPIO_PIN_5);
-    Log::d("ENET", "enet_gpio_config ok");
+    LOGD("ENET", "enet_gpio_config ok");
 }
@@ -92,6 +92,36 @@ const Spi_PeriphConfig SPI_CFG1 = {
     .frame_size = SPI_FRAMESIZE_8BIT,
     .endian = SPI_ENDIAN_MSB,
 };
+
+// 每个DMA通道同一时刻只能服务一个外设：SPI1 与 USART2/UART3、SPI2 与 UART7
+// 的DMA通道重叠，不能同时使能DMA；SPI3 与串口不冲突
+const Spi_DmaConfig SPI1_DMA0_CH4TX_CH3RX = {
+    .rcu_dma_periph = RCU_DMA0,
+    .dma_periph = DMA0,
+    .dma_sub_per = DMA_SUBPERI0,
+    .dma_tx_channel = DMA_CH4,
+    .dma_rx_channel = DMA_CH3,
+    .nvic_irq_pre_priority = 6,
+};
+
+const Spi_DmaConfig SPI2_DMA0_CH5TX_CH0RX = {
+    .rcu_dma_periph = RCU_DMA0,
+    .dma_periph = DMA0,
+    .dma_sub_per = DMA_SUBPERI0,
+    .dma_tx_channel = DMA_CH5,
+    .dma_rx_channel = DMA_CH0,
+    .nvic_irq_pre_priority = 6,
+};
+
+const Spi_DmaConfig SPI3_DMA1_CH1TX_CH0RX = {
+    .rcu_dma_periph = RCU_DMA1,
+    .dma_periph = DMA1,
+    .dma_sub_per = DMA_SUBPERI4,
+    .dma_tx_channel = DMA_CH1,
+    .dma_rx_channel = DMA_CH0,
+    .nvic_irq_pre_priority = 6,
+};
+
 extern "C" {
 void SPI1_IRQHandler(void) {
     if (RESET != spi_i2s_flag_get(SPI1, SPI_FLAG_RBNE)) {
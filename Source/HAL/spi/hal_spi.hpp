@@ -5,12 +5,25 @@
 #include <vector>
 
 #include "QueueCpp.h"
+#include "hal_dma.hpp"
 #include "hal_gpio.hpp"
 #include "gd32f4xx.h"
+#include "gd32f4xx_dma.h"
 #include "gd32f4xx_misc.h"
 #include "gd32f4xx_spi.h"
 #include "task.h"
 
+// 短于此长度的传输轮询完成：DMA配置和任务切换的开销比传输本身更大
+#define SPI_DMA_MIN_LEN 16
+// DMA单次传输的最大字节数，更长的段分块传输
+#define SPI_DMA_MAX_CHUNK 65535
+// DMA完成使用的任务通知索引；索引 0 留给 UART、扫描引擎、SpiBus 等使用
+// ulTaskNotifyTake() 的驱动，最后一个索引留给 hal_hptimer_sleep_until_us()
+#define SPI_DMA_NOTIFY_INDEX 1
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES < 3
+#error "hal_spi needs a dedicated task notification index"
+#endif
+
 typedef struct {
     uint32_t spi_periph;
     rcu_periph_enum spi_periph_clock;
@@ -45,12 +58,32 @@ typedef struct {
     uint32_t endian;
 } Spi_PeriphConfig;
 
+typedef struct {
+    rcu_periph_enum rcu_dma_periph;        // DMA时钟
+    uint32_t dma_periph;                   // DMA外设
+    dma_subperipheral_enum dma_sub_per;    // DMA子通道
+    dma_channel_enum dma_tx_channel;       // DMA发送通道
+    dma_channel_enum dma_rx_channel;       // DMA接收通道
+    uint8_t nvic_irq_pre_priority;         // 接收完成中断优先级
+} Spi_DmaConfig;
+
+// 一段传输，类似 UartIoVec：tx 为空时发送填充字节，rx 为空时丢弃接收数据
+typedef struct {
+    const uint8_t* tx;
+    uint8_t* rx;
+    uint32_t len;
+} SpiSegment;
+
 extern const Spi_IOConfig SPI1_C1MOSI_C2MISO_B10SCLK_B12NSS;
 extern const Spi_IOConfig SPI1_C1MOSI_C2MISO_C7SCLK_B12NSS;
 extern const Spi_IOConfig SPI3_E6MOSI_E5MISO_E2SCLK_E11NSS;
 
 extern const Spi_PeriphConfig SPI_CFG1;
 
+extern const Spi_DmaConfig SPI1_DMA0_CH4TX_CH3RX;
+extern const Spi_DmaConfig SPI2_DMA0_CH5TX_CH0RX;
+extern const Spi_DmaConfig SPI3_DMA1_CH1TX_CH0RX;
+
 typedef struct {
     uint32_t nss_port;
     uint32_t nss_pin;
@@ -170,8 +203,21 @@ class SpiMaster : private SpiDevBase {
         __miso.af_set(__cfg.miso_func_num);
         __sclk.af_set(__cfg.sclk_func_num);
 
-        spi_parameter_struct spi_init_struct;
         rcu_periph_clock_enable(__cfg.spi_periph_clock);
+        reconfigure(spi_cfg);
+    }
+    ~SpiMaster() {
+        if (__dma_enabled) {
+            hal_dma_unregister(__dma_cfg.dma_periph, __dma_cfg.dma_rx_channel);
+        }
+    };
+
+    void nss_high(uint8_t nss_index = 0) { __nss[nss_index].bit_set(); }
+    void nss_low(uint8_t nss_index = 0) { __nss[nss_index].bit_reset(); }
+
+    // 切换分频、极性相位等设置，调用时总线必须空闲；DMA请求位不受影响
+    void reconfigure(const Spi_PeriphConfig& spi_cfg) {
+        spi_parameter_struct spi_init_struct;
         spi_init_struct.trans_mode = SPI_TRANSMODE_FULLDUPLEX;
         spi_init_struct.device_mode = SPI_MASTER;
         spi_init_struct.frame_size = spi_cfg.frame_size;
@@ -179,61 +225,112 @@ class SpiMaster : private SpiDevBase {
         spi_init_struct.nss = SPI_NSS_SOFT;
         spi_init_struct.prescale = spi_cfg.prescale;
         spi_init_struct.endian = spi_cfg.endian;
+        spi_disable(__cfg.spi_periph);
         spi_init(__cfg.spi_periph, &spi_init_struct);
         spi_enable(__cfg.spi_periph);
-        // spi_init();
     }
-    ~SpiMaster() {};
 
-    void nss_high(uint8_t nss_index = 0) { __nss[nss_index].bit_set(); }
-    void nss_low(uint8_t nss_index = 0) { __nss[nss_index].bit_reset(); }
+    /**
+     * @brief 使能DMA传输
+     * 长度不小于 min_len 的段由DMA全双工传输，等待的任务挂起直到接收完成
+     * 中断通知，期间CPU可以运行其他任务。短段、中断中、临界区内或调度器
+     * 未运行时仍然轮询。DMA不能访问 TCM RAM，位于 .tcmram 的缓冲区同样轮询。
+     * @return 通道无效时返回 false
+     */
+    bool dma_enable(const Spi_DmaConfig& dma,
+                    uint32_t min_len = SPI_DMA_MIN_LEN) {
+        rcu_periph_clock_enable(dma.rcu_dma_periph);
+        // 接收优先于发送，避免接收数据来不及搬走而溢出
+        __dma_init_channel(dma, dma.dma_rx_channel, DMA_PERIPH_TO_MEMORY,
+                           DMA_PRIORITY_ULTRA_HIGH);
+        __dma_init_channel(dma, dma.dma_tx_channel, DMA_MEMORY_TO_PERIPH,
+                           DMA_PRIORITY_HIGH);
+
+        // 接收通道最后完成，其完成中断即整个传输结束
+        dma_interrupt_flag_clear(dma.dma_periph, dma.dma_rx_channel,
+                                 DMA_INT_FLAG_FTF);
+        dma_interrupt_enable(dma.dma_periph, dma.dma_rx_channel, DMA_INT_FTF);
+        if (!hal_dma_register(dma.dma_periph, dma.dma_rx_channel,
+                              &SpiMaster::__dma_rx_irq, this,
+                              dma.nvic_irq_pre_priority)) {
+            return false;
+        }
+        __dma_cfg = dma;
+        __dma_min_len = min_len;
+        __dma_enabled = true;
+        return true;
+    }
 
-    bool send(std::vector<uint8_t> tx_data, uint16_t timeout_ms = 1000,
-              uint8_t nss_index = 0) {
-        uint32_t timeout_tick = pdMS_TO_TICKS(timeout_ms);
-        uint32_t txcount = 0;
-        // nss_low(nss_index);
+    /**
+     * @brief 全双工传输一段，不操作片选
+     * @param tx 发送数据，为空时发送 fill
+     * @param rx 接收缓冲，为空时丢弃接收数据
+     */
+    bool transfer(const uint8_t* tx, uint8_t* rx, uint32_t len,
+                  uint16_t timeout_ms = 1000, uint8_t fill = 0xFF) {
+        SpiSegment seg = {tx, rx, len};
+        return transfer(&seg, 1, timeout_ms, fill);
+    }
 
-        uint32_t tickstart = xTaskGetTickCount();
-        while (txcount < tx_data.size()) {
-            if (SET == spi_i2s_flag_get(__cfg.spi_periph, SPI_FLAG_TBE)) {
-                spi_i2s_data_transmit(__cfg.spi_periph, tx_data[txcount++]);
-            }
+    /**
+     * @brief 依次传输多个段，不操作片选
+     * 每段按长度选择DMA或轮询，timeout_ms 为所有段的总超时
+     */
+    bool transfer(const SpiSegment* seg, size_t count,
+                  uint16_t timeout_ms = 1000, uint8_t fill = 0xFF) {
+        uint32_t timeout_tick = pdMS_TO_TICKS(timeout_ms);
+        uint32_t tickstart = __tick_now();
 
-            if (xTaskGetTickCount() - tickstart > timeout_tick) {
-                // nss_high(nss_index);
-                spi_i2s_data_receive(__cfg.spi_periph);
+        // 丢弃上一次遗留的接收数据，并清除溢出标志
+        spi_i2s_data_receive(__cfg.spi_periph);
+        spi_i2s_flag_get(__cfg.spi_periph, SPI_FLAG_RXORERR);
 
+        for (size_t i = 0; i < count; i++) {
+            if (seg[i].len == 0) {
+                continue;
+            }
+            bool ok = __use_dma(seg[i])
+                          ? __dma_transfer(seg[i], fill, tickstart,
+                                           timeout_tick)
+                          : __poll_transfer(seg[i], fill, tickstart,
+                                            timeout_tick);
+            if (!ok) {
                 return false;
             }
         }
         while (SET == spi_i2s_flag_get(__cfg.spi_periph, SPI_STAT_TRANS)) {
-            if (xTaskGetTickCount() - tickstart > timeout_tick) {
-                // nss_high(nss_index);
-                spi_i2s_data_receive(__cfg.spi_periph);
-
+            if (__tick_now() - tickstart > timeout_tick) {
                 return false;
             }
         }
-        // nss_high(nss_index);
-        spi_i2s_data_receive(__cfg.spi_periph);
         return true;
     }
 
-    bool send_open_loop(std::vector<uint8_t> tx_data) {
-        uint32_t txcount = 0;
-        // nss_low();
-        while (txcount < tx_data.size()) {
-            while (RESET == spi_i2s_flag_get(__cfg.spi_periph, SPI_FLAG_TBE));
-            spi_i2s_data_transmit(__cfg.spi_periph, tx_data[txcount++]);
-        }
-        while (SET == spi_i2s_flag_get(__cfg.spi_periph, SPI_STAT_TRANS));
-        spi_i2s_data_receive(__cfg.spi_periph);
-        // nss_high();
-        return true;
+    /**
+     * @brief 片选事务：拉低片选后依次传输各段（如命令+数据），最后释放片选
+     * 片选只切换一次，段之间不释放总线
+     */
+    bool transaction(const SpiSegment* seg, size_t count, uint8_t nss_index = 0,
+                     uint16_t timeout_ms = 1000, uint8_t fill = 0xFF) {
+        nss_low(nss_index);
+        bool ok = transfer(seg, count, timeout_ms, fill);
+        nss_high(nss_index);
+        return ok;
+    }
+
+    bool send(const std::vector<uint8_t>& tx_data, uint16_t timeout_ms = 1000,
+              uint8_t nss_index = 0) {
+        // nss_low(nss_index);
+        bool ok = transfer(tx_data.data(), nullptr, tx_data.size(), timeout_ms);
+        // nss_high(nss_index);
+        return ok;
     }
 
-    bool send_open_loop(uint8_t* tx_buffer, uint32_t tx_len) {
+    bool send_open_loop(const std::vector<uint8_t>& tx_data) {
+        return send_open_loop(tx_data.data(), tx_data.size());
+    }
+
+    bool send_open_loop(const uint8_t* tx_buffer, uint32_t tx_len) {
         uint32_t txcount = 0;
         // nss_low();
         while (txcount < tx_len) {
@@ -281,90 +378,185 @@ class SpiMaster : private SpiDevBase {
 
     bool recv(uint32_t rx_len, uint16_t timeout_ms = 1000,
               uint8_t nss_index = 0) {
-        uint32_t timeout_tick = pdMS_TO_TICKS(timeout_ms);
-        uint32_t rxcount = 0;
-        uint8_t txallowed = 1;
-        rx_buffer.clear();
-        if (rx_len > rx_buffer.capacity()) {
-            rx_buffer.reserve(rx_len);
-        }
+        rx_buffer.resize(rx_len);
         // nss_low(nss_index);
-        uint32_t tickstart = xTaskGetTickCount();
-        while (rxcount < rx_len) {
-            if (txallowed) {
-                txallowed = 0;
-                spi_i2s_data_transmit(__cfg.spi_periph, 0xFF);
-            }
-            if (RESET != spi_i2s_flag_get(__cfg.spi_periph, SPI_FLAG_RBNE)) {
-                rx_buffer.push_back(spi_i2s_data_receive(__cfg.spi_periph));
-                rxcount++;
-                txallowed = 1;
-            }
-            if (xTaskGetTickCount() - tickstart > timeout_tick) {
-                // nss_high(nss_index);
-                return false;
-            }
-        }
-
-        while (SET == spi_i2s_flag_get(__cfg.spi_periph, SPI_STAT_TRANS)) {
-            if (xTaskGetTickCount() - tickstart > timeout_tick) {
-                // nss_high(nss_index);
-                return false;
-            }
-        }
-
+        bool ok = transfer(nullptr, rx_buffer.data(), rx_len, timeout_ms);
         // nss_high(nss_index);
-        return true;
+        return ok;
     }
-    bool send_recv(std::vector<uint8_t> tx_data, uint32_t rx_len,
+
+    // 时钟数取两者较大值，rx_buffer 为前 rx_len 个时钟收到的数据
+    bool send_recv(const std::vector<uint8_t>& tx_data, uint32_t rx_len,
                    uint16_t timeout_ms = 1000, uint8_t nss_index = 0) {
-        uint32_t tx_size = tx_data.size() > rx_len ? tx_data.size() : rx_len;
-        uint32_t txcount = 0;
-        uint32_t rxcount = 0;
-        uint8_t txallowed = 1;
-        uint32_t timeout_tick = pdMS_TO_TICKS(timeout_ms);
-        rx_buffer.clear();
-        if (rx_len > rx_buffer.capacity()) {
-            rx_buffer.reserve(rx_len);
+        uint32_t tx_len = tx_data.size();
+        rx_buffer.resize(rx_len);
+        SpiSegment seg[2];
+        if (tx_len >= rx_len) {
+            seg[0] = {tx_data.data(), rx_buffer.data(), rx_len};
+            seg[1] = {tx_data.data() + rx_len, nullptr, tx_len - rx_len};
+        } else {
+            seg[0] = {tx_data.data(), rx_buffer.data(), tx_len};
+            seg[1] = {nullptr, rx_buffer.data() + tx_len, rx_len - tx_len};
         }
-
         // nss_low(nss_index);
-        uint32_t tickstart = xTaskGetTickCount();
-        while ((txcount < tx_size) || (rxcount < rx_len)) {
-            if (txallowed) {
-                txallowed = 0;
-                if (txcount < tx_data.size()) {
-                    spi_i2s_data_transmit(__cfg.spi_periph, tx_data[txcount]);
-                } else {
-                    spi_i2s_data_transmit(__cfg.spi_periph, 0xFF);
+        bool ok = transfer(seg, 2, timeout_ms);
+        // nss_high(nss_index);
+        return ok;
+    }
+
+   private:
+    Spi_DmaConfig __dma_cfg;
+    bool __dma_enabled = false;
+    uint32_t __dma_min_len = SPI_DMA_MIN_LEN;
+    volatile bool __dma_busy = false;
+    volatile TaskHandle_t __dma_task = nullptr;
+    uint8_t __dma_fill = 0xFF;    // tx 为空时发送的字节，地址不递增
+    uint8_t __dma_sink;           // rx 为空时接收的去处，地址不递增
+
+    static uint32_t __tick_now() {
+        return xPortIsInsideInterrupt() == pdTRUE ? xTaskGetTickCountFromISR()
+                                                  : xTaskGetTickCount();
+    }
+
+    // TCM RAM 只连接到CPU总线，DMA无法访问
+    static bool __dma_accessible(const void* p) {
+        uintptr_t addr = (uintptr_t)p;
+        return addr < 0x10000000U || addr >= 0x10010000U;
+    }
+
+    bool __use_dma(const SpiSegment& seg) const {
+        return __dma_enabled && seg.len >= __dma_min_len &&
+               __dma_accessible(seg.tx) && __dma_accessible(seg.rx) &&
+               xPortIsInsideInterrupt() == pdFALSE && __get_PRIMASK() == 0 &&
+               __get_BASEPRI() == 0 &&
+               xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+    }
+
+    // 逐字节收发，每个字节收到后才发送下一个，被中断打断也不会溢出
+    bool __poll_transfer(const SpiSegment& seg, uint8_t fill,
+                         uint32_t tickstart, uint32_t timeout_tick) {
+        for (uint32_t i = 0; i < seg.len; i++) {
+            while (RESET == spi_i2s_flag_get(__cfg.spi_periph, SPI_FLAG_TBE)) {
+                if (__tick_now() - tickstart > timeout_tick) {
+                    return false;
                 }
-                txcount++;
             }
-            if (RESET != spi_i2s_flag_get(__cfg.spi_periph, SPI_FLAG_RBNE) &&
-                rxcount < rx_len) {
-                rx_buffer.push_back(spi_i2s_data_receive(__cfg.spi_periph));
-                rxcount++;
-                txallowed = 1;
+            spi_i2s_data_transmit(__cfg.spi_periph,
+                                  seg.tx != nullptr ? seg.tx[i] : fill);
+            while (RESET ==
+                   spi_i2s_flag_get(__cfg.spi_periph, SPI_FLAG_RBNE)) {
+                if (__tick_now() - tickstart > timeout_tick) {
+                    return false;
+                }
             }
-            if (rxcount >= rx_len &&
-                SET == spi_i2s_flag_get(__cfg.spi_periph, SPI_FLAG_TBE)) {
-                txallowed = 1;
+            uint8_t data = spi_i2s_data_receive(__cfg.spi_periph);
+            if (seg.rx != nullptr) {
+                seg.rx[i] = data;
             }
+        }
+        return true;
+    }
 
-            if (xTaskGetTickCount() - tickstart > timeout_tick) {
-                // nss_high(nss_index);
-                return false;
+    bool __dma_transfer(const SpiSegment& seg, uint8_t fill,
+                        uint32_t tickstart, uint32_t timeout_tick) {
+        uint32_t dma = __dma_cfg.dma_periph;
+        uint32_t done = 0;
+        __dma_fill = fill;
+        while (done < seg.len) {
+            uint32_t len = seg.len - done;
+            if (len > SPI_DMA_MAX_CHUNK) {
+                len = SPI_DMA_MAX_CHUNK;
             }
-        }
-        while (SET == spi_i2s_flag_get(__cfg.spi_periph, SPI_STAT_TRANS)) {
-            if (xTaskGetTickCount() - tickstart > timeout_tick) {
-                // nss_high(nss_index);
+            __dma_load(__dma_cfg.dma_rx_channel,
+                       seg.rx != nullptr ? (uintptr_t)(seg.rx + done)
+                                         : (uintptr_t)&__dma_sink,
+                       seg.rx != nullptr, len);
+            __dma_load(__dma_cfg.dma_tx_channel,
+                       seg.tx != nullptr ? (uintptr_t)(seg.tx + done)
+                                         : (uintptr_t)&__dma_fill,
+                       seg.tx != nullptr, len);
+
+            __dma_task = xTaskGetCurrentTaskHandle();
+            __dma_busy = true;
+            dma_channel_enable(dma, __dma_cfg.dma_rx_channel);
+            dma_channel_enable(dma, __dma_cfg.dma_tx_channel);
+            // 先使能接收请求，发送请求使能后开始传输
+            spi_dma_enable(__cfg.spi_periph, SPI_DMA_RECEIVE);
+            spi_dma_enable(__cfg.spi_periph, SPI_DMA_TRANSMIT);
+
+            while (__dma_busy) {
+                uint32_t elapsed = xTaskGetTickCount() - tickstart;
+                if (elapsed > timeout_tick) {
+                    break;
+                }
+                ulTaskNotifyTakeIndexed(SPI_DMA_NOTIFY_INDEX, pdTRUE,
+                                        timeout_tick - elapsed + 1);
+            }
+            __dma_task = nullptr;
+            spi_dma_disable(__cfg.spi_periph, SPI_DMA_TRANSMIT);
+            spi_dma_disable(__cfg.spi_periph, SPI_DMA_RECEIVE);
+
+            if (__dma_busy) {
+                // 超时：停止两个通道，放弃剩余数据
+                dma_channel_disable(dma, __dma_cfg.dma_tx_channel);
+                dma_channel_disable(dma, __dma_cfg.dma_rx_channel);
+                __dma_busy = false;
                 return false;
             }
+            done += len;
         }
-        // nss_high(nss_index);
         return true;
     }
+
+    void __dma_load(dma_channel_enum channel, uint32_t memory, bool increase,
+                    uint32_t len) {
+        uint32_t dma = __dma_cfg.dma_periph;
+        dma_channel_disable(dma, channel);
+        dma_flag_clear(dma, channel,
+                       DMA_FLAG_FEE | DMA_FLAG_SDE | DMA_FLAG_TAE |
+                           DMA_FLAG_HTF | DMA_FLAG_FTF);
+        dma_memory_address_config(dma, channel, DMA_MEMORY_0, memory);
+        dma_memory_address_generation_config(
+            dma, channel,
+            increase ? DMA_MEMORY_INCREASE_ENABLE : DMA_MEMORY_INCREASE_DISABLE);
+        dma_transfer_number_config(dma, channel, len);
+    }
+
+    void __dma_init_channel(const Spi_DmaConfig& dma, dma_channel_enum channel,
+                            uint32_t direction, uint32_t priority) {
+        dma_single_data_parameter_struct dmaInitStruct;
+        dma_deinit(dma.dma_periph, channel);
+        dmaInitStruct.direction = direction;
+        dmaInitStruct.memory0_addr = (uintptr_t) nullptr;
+        dmaInitStruct.memory_inc = DMA_MEMORY_INCREASE_ENABLE;
+        dmaInitStruct.periph_memory_width = DMA_PERIPH_WIDTH_8BIT;
+        dmaInitStruct.circular_mode = DMA_CIRCULAR_MODE_DISABLE;
+        dmaInitStruct.number = 0;
+        dmaInitStruct.periph_addr = (uintptr_t)&SPI_DATA(__cfg.spi_periph);
+        dmaInitStruct.periph_inc = DMA_PERIPH_INCREASE_DISABLE;
+        dmaInitStruct.priority = priority;
+        dma_single_data_mode_init(dma.dma_periph, channel, &dmaInitStruct);
+        dma_channel_subperipheral_select(dma.dma_periph, channel,
+                                         dma.dma_sub_per);
+        dma_channel_disable(dma.dma_periph, channel);
+    }
+
+    static void __dma_rx_irq(uint32_t dma_periph, dma_channel_enum channel,
+                             void* arg) {
+        if (SET == dma_interrupt_flag_get(dma_periph, channel,
+                                          DMA_INT_FLAG_FTF)) {
+            dma_interrupt_flag_clear(dma_periph, channel, DMA_INT_FLAG_FTF);
+            SpiMaster* self = static_cast<SpiMaster*>(arg);
+            self->__dma_busy = false;
+            TaskHandle_t task = self->__dma_task;
+            if (task != nullptr) {
+                BaseType_t woken = pdFALSE;
+                vTaskNotifyGiveIndexedFromISR(task, SPI_DMA_NOTIFY_INDEX,
+                                              &woken);
+                portYIELD_FROM_ISR(woken);
+            }
+        }
+    }
 };
 
 class SpiSlave : private SpiDevBase {
@@ -427,18 +619,20 @@ class SpiSlave : private SpiDevBase {
         user_callback_arg = arg;
     }
 
-    bool send(uint8_t* tx_data, uint16_t len, uint16_t timeout_ms = 1000) {
+    bool send(const uint8_t* tx_data, uint16_t len,
+              uint16_t timeout_ms = 1000) {
         __load_tx_data(tx_data, len);
         return __check_tx_done(timeout_ms);
     }
 
-    bool send(std::vector<uint8_t> tx_data, uint16_t timeout_ms = 1000) {
+    bool send(const std::vector<uint8_t>& tx_data,
+              uint16_t timeout_ms = 1000) {
         __load_tx_data(tx_data.data(), tx_data.size());
         return __check_tx_done(timeout_ms);
     }
 
    private:
-    void __load_tx_data(uint8_t* tx_data, uint16_t len) {
+    void __load_tx_data(const uint8_t* tx_data, uint16_t len) {
         __tx_count = 0;
         while (__tx_count < len) {
             if (__tx_count == 0 &&
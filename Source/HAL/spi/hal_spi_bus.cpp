@@ -0,0 +1,247 @@
+#include "hal_spi_bus.hpp"
+
+#include <new>
+
+static bool same_periph_config(const Spi_PeriphConfig& a,
+                               const Spi_PeriphConfig& b) {
+    return a.prescale == b.prescale &&
+           a.clock_polarity_phase == b.clock_polarity_phase &&
+           a.frame_size == b.frame_size && a.endian == b.endian;
+}
+
+SpiBus::SpiBus(const Spi_IOConfig& io_cfg, const Spi_DmaConfig* dma,
+               const char* name)
+    : TaskClassS<SPI_BUS_TASK_DEPTH>(name, TaskPrio_High),
+      __master(io_cfg, SPI_CFG1, {}),
+      __active(SPI_CFG1) {
+    if (dma != nullptr) {
+        __master.dma_enable(*dma);
+    }
+    // 调度器已运行时由最终的构造函数启动任务
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+        this->give();
+    }
+}
+
+void SpiBus::task() {
+    for (;;) {
+        SpiTransaction* t = pop();
+        if (t == nullptr) {
+            // 提交事务时通知，唤醒后重新检查队列
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+        execute(*t);
+        finish(*t);
+    }
+}
+
+bool SpiBus::transact(SpiDevice& dev, SpiTransaction& t, TickType_t timeout) {
+    if (xPortIsInsideInterrupt() == pdTRUE || t.busy()) {
+        return false;
+    }
+    // 调度器启动前只有一个执行流；总线任务自身（on_done 中）不能等待自己
+    if (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING ||
+        xTaskGetCurrentTaskHandle() == getTaskHandle()) {
+        t.dev = &dev;
+        t.state = SpiTransaction::State::RUNNING;
+        execute(t);
+        t.state = SpiTransaction::State::DONE;
+        return t.ok;
+    }
+
+    t.waiter = xTaskGetCurrentTaskHandle();
+    if (!submit(dev, t)) {
+        t.waiter = nullptr;
+        return false;
+    }
+    TickType_t start = xTaskGetTickCount();
+    while (t.state != SpiTransaction::State::DONE) {
+        TickType_t wait = portMAX_DELAY;
+        if (timeout != portMAX_DELAY) {
+            TickType_t elapsed = xTaskGetTickCount() - start;
+            if (elapsed >= timeout) {
+                if (cancel(t)) {
+                    t.waiter = nullptr;
+                    return false;
+                }
+                // 已经开始执行，等待结束
+                timeout = portMAX_DELAY;
+                continue;
+            }
+            wait = timeout - elapsed;
+        }
+        ulTaskNotifyTake(pdTRUE, wait);
+    }
+    t.waiter = nullptr;
+    return t.ok;
+}
+
+bool SpiBus::submit(SpiDevice& dev, SpiTransaction& t) {
+    bool queued = false;
+    taskENTER_CRITICAL();
+    if (!t.busy()) {
+        t.dev = &dev;
+        t.state = SpiTransaction::State::QUEUED;
+        insert_locked(t);
+        queued = true;
+    }
+    taskEXIT_CRITICAL();
+    if (queued) {
+        this->give();
+    }
+    return queued;
+}
+
+bool SpiBus::submit_ISR(SpiDevice& dev, SpiTransaction& t) {
+    bool queued = false;
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    if (!t.busy()) {
+        t.dev = &dev;
+        t.waiter = nullptr;
+        t.state = SpiTransaction::State::QUEUED;
+        insert_locked(t);
+        queued = true;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+    if (queued) {
+        BaseType_t woken = pdFALSE;
+        this->give_ISR(woken);
+        portYIELD_FROM_ISR(woken);
+    }
+    return queued;
+}
+
+bool SpiBus::cancel(SpiTransaction& t) {
+    bool removed = false;
+    taskENTER_CRITICAL();
+    if (t.state == SpiTransaction::State::QUEUED) {
+        SpiTransaction** link = &__head;
+        while (*link != nullptr && *link != &t) {
+            link = &(*link)->next;
+        }
+        if (*link == &t) {
+            *link = t.next;
+        }
+        t.next = nullptr;
+        t.state = SpiTransaction::State::IDLE;
+        removed = true;
+    }
+    taskEXIT_CRITICAL();
+    return removed;
+}
+
+// 插到所有优先级不低于它的事务之后，同优先级保持提交顺序
+void SpiBus::insert_locked(SpiTransaction& t) {
+    SpiTransaction** link = &__head;
+    while (*link != nullptr && (*link)->priority >= t.priority) {
+        link = &(*link)->next;
+    }
+    t.next = *link;
+    *link = &t;
+}
+
+SpiTransaction* SpiBus::pop() {
+    taskENTER_CRITICAL();
+    SpiTransaction* t = __head;
+    if (t != nullptr) {
+        __head = t->next;
+        t->next = nullptr;
+        t->state = SpiTransaction::State::RUNNING;
+    }
+    taskEXIT_CRITICAL();
+    return t;
+}
+
+void SpiBus::execute(SpiTransaction& t) {
+    SpiDevice& dev = *t.dev;
+    select(dev.__cfg.periph);
+
+    dev.__nss.bit_reset();
+    for (uint16_t n = dev.__cfg.cs_setup_loops; n > 0; n--) {
+        __NOP();
+    }
+    bool ok = true;
+    for (size_t i = 0; i < t.count && ok; i++) {
+        if (t.on_phase != nullptr && !t.on_phase(t, i)) {
+            ok = false;
+            break;
+        }
+        ok = __master.transfer(&t.seg[i], 1, SPI_BUS_XFER_TIMEOUT_MS, t.fill);
+    }
+    dev.__nss.bit_set();
+
+    t.ok = ok;
+    __transactions++;
+}
+
+void SpiBus::finish(SpiTransaction& t) {
+    TaskHandle_t waiter = t.waiter;
+    SpiDoneCallback cb = t.on_done;
+    // DONE 之后阻塞的提交者可能立即返回并释放 t，不能再访问
+    t.state = SpiTransaction::State::DONE;
+    if (waiter != nullptr) {
+        xTaskNotifyGive(waiter);
+    } else if (cb != nullptr) {
+        cb(t);
+    }
+}
+
+void SpiBus::select(const Spi_PeriphConfig& cfg) {
+    if (same_periph_config(cfg, __active)) {
+        return;
+    }
+    __master.reconfigure(cfg);
+    __active = cfg;
+    __reconfigs++;
+}
+
+SpiDevice::SpiDevice(SpiBus& bus, const SpiDeviceConfig& cfg)
+    : __bus(bus),
+      __cfg(cfg),
+      __nss((GPIO::Port)cfg.nss_port, (GPIO::Pin)cfg.nss_pin,
+            GPIO::Mode::OUTPUT, GPIO::PullUpDown::NONE, GPIO::OType::PP,
+            GPIO::Speed::SPEED_50MHZ) {
+    __nss.bit_set();
+}
+
+bool SpiDevice::transact(SpiSegment* seg, size_t count, uint8_t fill,
+                         TickType_t timeout) {
+    SpiTransaction t;
+    t.seg = seg;
+    t.count = count;
+    t.priority = __cfg.priority;
+    t.fill = fill;
+    return transact(t, timeout);
+}
+
+bool SpiDevice::write(const uint8_t* cmd, size_t cmd_len, const uint8_t* data,
+                      size_t data_len) {
+    SpiSegment seg[2] = {{cmd, nullptr, (uint32_t)cmd_len},
+                         {data, nullptr, (uint32_t)data_len}};
+    return transact(seg, 2);
+}
+
+bool SpiDevice::read(const uint8_t* cmd, size_t cmd_len, uint8_t* data,
+                     size_t data_len, uint8_t fill) {
+    SpiSegment seg[2] = {{cmd, nullptr, (uint32_t)cmd_len},
+                         {nullptr, data, (uint32_t)data_len}};
+    return transact(seg, 2, fill);
+}
+
+SpiBus& spi3_bus() {
+    // 编译选项 -fno-threadsafe-statics 下局部静态对象的构造没有保护，CX310 与
+    // DW1000 在不同任务中初始化时可能同时构造出两条总线；挂起调度器后再检查
+    // 并构造，保证只有一个总线任务和一组DMA中断
+    alignas(SpiBus) static uint8_t storage[sizeof(SpiBus)];
+    static SpiBus* volatile bus = nullptr;
+    if (bus == nullptr) {
+        vTaskSuspendAll();
+        if (bus == nullptr) {
+            bus = new (storage) SpiBus(SPI3_E6MOSI_E5MISO_E2SCLK_E11NSS,
+                                       &SPI3_DMA1_CH1TX_CH0RX, "Spi3Bus");
+        }
+        xTaskResumeAll();
+    }
+    return *bus;
+}
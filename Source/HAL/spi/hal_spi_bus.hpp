@@ -0,0 +1,162 @@
+#ifndef HAL_SPI_BUS_HPP
+#define HAL_SPI_BUS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "TaskCPP.h"
+#include "hal_gpio.hpp"
+#include "hal_spi.hpp"
+
+#define SPI_BUS_TASK_DEPTH 384
+// 单个事务的传输超时
+#define SPI_BUS_XFER_TIMEOUT_MS 100
+
+typedef struct {
+    Spi_PeriphConfig periph;    // 分频、极性相位、帧长、字节序
+    uint32_t nss_port;          // 片选端口
+    uint32_t nss_pin;           // 片选引脚
+    uint16_t cs_setup_loops;    // 片选拉低后到第一个时钟之间的空循环数
+    uint8_t priority;           // transact() 的默认优先级，越大越先执行
+} SpiDeviceConfig;
+
+class SpiBus;
+class SpiDevice;
+struct SpiTransaction;
+
+// 片选拉低后、第 index 段开始前在总线任务中调用，可以修改后续段（如按命令
+// 阶段收到的长度设置数据阶段）；返回 false 时中止事务。不能在其中提交事务
+typedef bool (*SpiPhaseCallback)(SpiTransaction& t, size_t index);
+// 异步事务结束（成功、失败或中止）后在总线任务中调用
+typedef void (*SpiDoneCallback)(SpiTransaction& t);
+
+/**
+ * @brief SPI 事务：一次片选内依次传输的多个段（如命令+数据）
+ *
+ * 描述符由提交者持有，排队时不分配内存。异步提交的事务在 on_done 返回
+ * （未设置 on_done 时 state 变为 DONE）之前必须保持有效。
+ */
+struct SpiTransaction {
+    enum class State : uint8_t { IDLE, QUEUED, RUNNING, DONE };
+
+    SpiSegment* seg = nullptr;
+    size_t count = 0;
+    uint8_t priority = 0;    // 越大越先执行，同优先级先到先执行
+    uint8_t fill = 0xFF;     // tx 为空的段发送的字节
+    SpiPhaseCallback on_phase = nullptr;
+    SpiDoneCallback on_done = nullptr;
+    void* arg = nullptr;
+    bool ok = false;
+    volatile State state = State::IDLE;
+
+    bool busy() const {
+        return state == State::QUEUED || state == State::RUNNING;
+    }
+
+   private:
+    friend class SpiBus;
+    SpiDevice* dev = nullptr;
+    SpiTransaction* next = nullptr;
+    TaskHandle_t waiter = nullptr;
+};
+
+/**
+ * @brief SPI 总线仲裁
+ *
+ * 总线任务独占 SpiMaster，按优先级依次执行挂在总线上的各设备提交的事务。
+ * 一个事务执行期间片选保持拉低，不会插入其他设备的传输；只有下一个事务
+ * 的设备设置（分频、极性相位、帧长、字节序）与当前不同时才重新配置外设，
+ * 各设备可以用各自的最高时钟共享总线，不需要额外的互斥量。
+ *
+ * 事务按优先级插入有序链表，队列由临界区保护，可以在任务和优先级不高于
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY 的中断中提交。
+ */
+class SpiBus : public TaskClassS<SPI_BUS_TASK_DEPTH> {
+   public:
+    SpiBus(const Spi_IOConfig& io_cfg, const Spi_DmaConfig* dma = nullptr,
+           const char* name = "SpiBus");
+
+    SpiBus(const SpiBus&) = delete;
+    SpiBus& operator=(const SpiBus&) = delete;
+
+    void task() override;
+
+    uint32_t transactions() const { return __transactions; }
+    uint32_t reconfigs() const { return __reconfigs; }
+
+   private:
+    friend class SpiDevice;
+
+    bool transact(SpiDevice& dev, SpiTransaction& t, TickType_t timeout);
+    bool submit(SpiDevice& dev, SpiTransaction& t);
+    bool submit_ISR(SpiDevice& dev, SpiTransaction& t);
+    bool cancel(SpiTransaction& t);
+
+    void insert_locked(SpiTransaction& t);
+    SpiTransaction* pop();
+    void execute(SpiTransaction& t);
+    void finish(SpiTransaction& t);
+    void select(const Spi_PeriphConfig& cfg);
+
+    SpiMaster __master;
+    Spi_PeriphConfig __active;
+    SpiTransaction* __head = nullptr;
+    uint32_t __transactions = 0;
+    uint32_t __reconfigs = 0;
+};
+
+/**
+ * @brief 挂在 SpiBus 上的设备，持有自己的片选和总线设置
+ */
+class SpiDevice {
+   public:
+    SpiDevice(SpiBus& bus, const SpiDeviceConfig& cfg);
+
+    SpiDevice(const SpiDevice&) = delete;
+    SpiDevice& operator=(const SpiDevice&) = delete;
+
+    /**
+     * @brief 阻塞事务，返回时已经结束
+     * 在任务中调用；调度器启动前或在总线任务中（on_done）直接执行。
+     * 不调用 on_done。
+     * @param timeout 排队等待的超时，超时的事务从队列移除；已经开始的事务
+     *                总会等到结束
+     */
+    bool transact(SpiTransaction& t, TickType_t timeout = portMAX_DELAY) {
+        return __bus.transact(*this, t, timeout);
+    }
+    bool transact(SpiSegment* seg, size_t count, uint8_t fill = 0xFF,
+                  TickType_t timeout = portMAX_DELAY);
+
+    // 命令阶段 + 数据阶段
+    bool write(const uint8_t* cmd, size_t cmd_len, const uint8_t* data,
+               size_t data_len);
+    bool read(const uint8_t* cmd, size_t cmd_len, uint8_t* data,
+              size_t data_len, uint8_t fill = 0xFF);
+
+    /**
+     * @brief 异步提交，立即返回，结束后在总线任务中调用 on_done
+     * @return 事务尚未结束（已在队列中或正在执行）时返回 false
+     */
+    bool submit(SpiTransaction& t) { return __bus.submit(*this, t); }
+    bool submit_ISR(SpiTransaction& t) { return __bus.submit_ISR(*this, t); }
+
+    // 移除尚未开始的事务，已开始的返回 false
+    bool cancel(SpiTransaction& t) { return __bus.cancel(t); }
+
+    // 修改时钟分频，从下一个事务开始生效
+    void set_prescale(uint32_t prescale) { __cfg.periph.prescale = prescale; }
+    const SpiDeviceConfig& config() const { return __cfg; }
+
+   private:
+    friend class SpiBus;
+    SpiBus& __bus;
+    SpiDeviceConfig __cfg;
+    GPIO __nss;
+};
+
+// SPI3（PE2/PE5/PE6，DMA1 CH0/CH1）上的共享总线，CX310 与 DW1000 共用；
+// 首次调用时创建，多个任务同时首次调用也只创建一次
+SpiBus& spi3_bus();
+
+#endif
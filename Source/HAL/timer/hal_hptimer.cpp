@@ -18,11 +18,39 @@ extern "C" {
 #define HP_TIMER_RCU            RCU_TIMER1
 
 // Timer configuration
-#define HP_TIMER_PRESCALER      119      // APB1 clock (60MHz) / (59+1) = 1MHz (1μs resolution)
+#define HP_TIMER_PRESCALER      119      // APB1 timer clock (120MHz) / (119+1) = 1MHz (1μs resolution)
 #define HP_TIMER_PERIOD         0xFFFFFFFF  // 32-bit timer, maximum period
+#define HP_TIMER_IRQ            TIMER1_IRQn
+#define HP_TIMER_IRQ_PRIORITY   1        // Must not be above configMAX_SYSCALL_INTERRUPT_PRIORITY
+
+// Alarm service: CH0 compare fires at the earliest queued deadline
+#define HP_TIMER_ALARM_CH       TIMER_CH_0
+#define HP_TIMER_ALARM_INT      TIMER_INT_CH0
+#define HP_TIMER_ALARM_FLAG     TIMER_INT_FLAG_CH0
+
+// Waits shorter than this spin instead of blocking: a block/wake round trip
+// costs two context switches, a few microseconds at 240MHz
+#define HP_TIMER_SLEEP_MIN_US   20
+
+// Notification index used by hal_hptimer_sleep_until_us(); the last one, so
+// index 0 stays free for drivers that use ulTaskNotifyTake()
+#define HP_TIMER_NOTIFY_INDEX   (configTASK_NOTIFICATION_ARRAY_ENTRIES - 1)
 
 static volatile bool s_initialized = false;
 
+// Upper 32 bits of the 64-bit microsecond clock, incremented on each counter overflow
+static volatile uint32_t s_overflows = 0;
+
+// DWT cycle counter anchored to the microsecond clock, see hal_hptimer_get_cycles64()
+static uint32_t s_cycles_per_us = 0;
+static volatile uint32_t s_cycle_offset = 0;
+
+// Armed alarms sorted by deadline, earliest first. Protected by masking
+// interrupts up to configMAX_SYSCALL_INTERRUPT_PRIORITY (includes TIMER1).
+static hal_hptimer_alarm_t *s_alarms = nullptr;
+
+static void alarm_program_locked(void);
+
 bool hal_hptimer_init(void)
 {
     if (s_initialized) {
@@ -52,14 +80,79 @@ bool hal_hptimer_init(void)
     
     // Enable auto-reload shadow register
     timer_auto_reload_shadow_enable(HP_TIMER);
-    
+
+    // CH0 in timing mode only raises the compare flag; no shadow register so
+    // a new deadline takes effect immediately
+    timer_channel_output_mode_config(HP_TIMER, HP_TIMER_ALARM_CH, TIMER_OC_MODE_TIMING);
+    timer_channel_output_shadow_config(HP_TIMER, HP_TIMER_ALARM_CH, TIMER_OC_SHADOW_DISABLE);
+
+    // Count overflows into the upper word. timer_init() sets the update flag
+    // when it loads the prescaler, so clear it before enabling the interrupt.
+    s_overflows = 0;
+    timer_interrupt_flag_clear(HP_TIMER, TIMER_INT_FLAG_UP | HP_TIMER_ALARM_FLAG);
+    timer_interrupt_enable(HP_TIMER, TIMER_INT_UP);
+    nvic_irq_enable(HP_TIMER_IRQ, HP_TIMER_IRQ_PRIORITY, 0);
+
     // Start the timer
     timer_enable(HP_TIMER);
-    
+
+    // The cycle counter and TIMER1 share the PLL, so one microsecond is
+    // always the same number of cycles
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    s_cycles_per_us = SystemCoreClock / 1000000U;
+
     s_initialized = true;
+    hal_hptimer_calibrate_cycles();
     return true;
 }
 
+extern "C" void TIMER1_IRQHandler(void)
+{
+    traceISR_ENTER();
+    if (SET == timer_interrupt_flag_get(HP_TIMER, TIMER_INT_FLAG_UP)) {
+        // Between clearing the flag and counting the epoch a reader sees
+        // neither, so a higher priority ISR preempting here would read time
+        // 2^32 us in the past; mask everything for these two stores
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        timer_interrupt_flag_clear(HP_TIMER, TIMER_INT_FLAG_UP);
+        s_overflows = s_overflows + 1;
+        __set_PRIMASK(primask);
+    }
+
+    // Also entered when the interrupt is pended by software for a deadline
+    // that had already passed when it was programmed
+    timer_interrupt_flag_clear(HP_TIMER, HP_TIMER_ALARM_FLAG);
+    for (;;) {
+        UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+        hal_hptimer_alarm_t *alarm = s_alarms;
+        uint64_t now = hal_hptimer_get_us64();
+        if (alarm == nullptr || alarm->deadline > now) {
+            alarm_program_locked();
+            taskEXIT_CRITICAL_FROM_ISR(mask);
+            break;
+        }
+
+        s_alarms = alarm->next;
+        alarm->next = nullptr;
+        alarm->armed = false;
+        if (alarm->period != 0) {
+            // Keep the phase; skip periods missed while interrupts were masked
+            uint64_t deadline = alarm->deadline + alarm->period;
+            if (deadline <= now) {
+                deadline += (now - deadline) / alarm->period * alarm->period + alarm->period;
+            }
+            hal_hptimer_alarm_start_at(alarm, deadline, alarm->period);
+        }
+        taskEXIT_CRITICAL_FROM_ISR(mask);
+
+        // The callback may restart or cancel this or any other alarm
+        alarm->callback(alarm->arg);
+    }
+    traceISR_EXIT();
+}
+
 uint32_t hal_hptimer_get_us(void)
 {
     if (!s_initialized) {
@@ -71,7 +164,8 @@ uint32_t hal_hptimer_get_us(void)
 
 uint32_t hal_hptimer_get_ms(void)
 {
-    return hal_hptimer_get_us() / 1000;
+    // Derived from the 64-bit clock so it wraps at 2^32 ms like the tick count
+    return (uint32_t)(hal_hptimer_get_us64() / 1000U);
 }
 
 uint64_t hal_hptimer_get_us64(void)
@@ -79,41 +173,227 @@ uint64_t hal_hptimer_get_us64(void)
     if (!s_initialized) {
         return 0;
     }
-    
-    // Get FreeRTOS tick count (milliseconds)
-    TickType_t tick_count = xTaskGetTickCount();
-    
-    // Get current microsecond counter
-    uint32_t us_counter = hal_hptimer_get_us();
-    
-    // Combine to create 64-bit timestamp
-    // Note: This assumes timer wraps less frequently than FreeRTOS tick updates
-    uint64_t total_us = (uint64_t)tick_count * 1000ULL + (us_counter % 1000);
-    
-    return total_us;
+
+    uint32_t high;
+    uint32_t low;
+    bool pending;
+    do {
+        high = s_overflows;
+        low = TIMER_CNT(HP_TIMER);
+        pending = (TIMER_INTF(HP_TIMER) & TIMER_INTF_UPIF) != 0U;
+        // Retry if the overflow interrupt ran between the two reads of the epoch
+    } while (high != s_overflows);
+
+    // With interrupts masked (critical section, higher priority ISR) the
+    // overflow can be pending but not yet counted. A small counter value
+    // was read after that wrap; a large one was read just before it.
+    if (pending && low < 0x80000000U) {
+        high++;
+    }
+
+    return ((uint64_t)high << 32) | low;
 }
 
-void hal_hptimer_delay_us(uint32_t us)
+uint32_t hal_hptimer_get_cycles(void)
 {
-    if (!s_initialized || us == 0) {
+    return DWT->CYCCNT;
+}
+
+uint32_t hal_hptimer_cycles_per_us(void)
+{
+    return s_cycles_per_us;
+}
+
+void hal_hptimer_calibrate_cycles(void)
+{
+    if (!s_initialized) {
         return;
     }
-    
-    uint32_t start_time = hal_hptimer_get_us();
-    
-    // For very short delays, use busy wait
-    if (us < 1000) {
-        while (hal_hptimer_elapsed_us(start_time) < us) {
-            // Busy wait
-        }
-    } else {
-        // For longer delays, yield to other tasks periodically
-        while (hal_hptimer_elapsed_us(start_time) < us) {
-            if (hal_hptimer_elapsed_us(start_time) % 100 == 0) {
-                taskYIELD();
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    // Sample right after a counter edge so the offset carries no fraction
+    // of a microsecond, only the few cycles of the reads below
+    uint32_t start = TIMER_CNT(HP_TIMER);
+    while (TIMER_CNT(HP_TIMER) == start) {
+    }
+    uint64_t us = hal_hptimer_get_us64();
+    uint32_t cycles = DWT->CYCCNT;
+    s_cycle_offset = cycles - (uint32_t)(us * s_cycles_per_us);
+    __set_PRIMASK(primask);
+}
+
+uint64_t hal_hptimer_get_cycles64(void)
+{
+    if (!s_initialized) {
+        return 0;
+    }
+
+    // The microsecond clock supplies the upper bits, CYCCNT the exact low
+    // bits. Both count the same time, so the cycle count lies within one
+    // microsecond (plus the few cycles between the reads) of the estimate.
+    uint64_t estimate = hal_hptimer_get_us64() * s_cycles_per_us;
+    uint32_t cycles = DWT->CYCCNT - s_cycle_offset;
+    int32_t delta = (int32_t)(cycles - (uint32_t)estimate);
+
+    // CYCCNT stops while the core is halted by a debugger and TIMER1 does
+    // not; re-anchor when the two have drifted apart
+    if (delta < -(int32_t)s_cycles_per_us || delta > 2 * (int32_t)s_cycles_per_us) {
+        hal_hptimer_calibrate_cycles();
+        return estimate;
+    }
+
+    return estimate + delta;
+}
+
+// Program CH0 for the head of the queue; caller holds the interrupt mask
+static void alarm_program_locked(void)
+{
+    if (s_alarms == nullptr) {
+        timer_interrupt_disable(HP_TIMER, HP_TIMER_ALARM_INT);
+        return;
+    }
+
+    // Only the low 32 bits are compared. A deadline more than one counter
+    // period ahead matches early; the handler finds nothing due and
+    // reprograms, so it costs one spurious interrupt per ~71 minutes.
+    uint64_t deadline = s_alarms->deadline;
+    TIMER_CH0CV(HP_TIMER) = (uint32_t)deadline;
+    timer_interrupt_enable(HP_TIMER, HP_TIMER_ALARM_INT);
+
+    // A match needs the counter to reach the value after it was written;
+    // if the deadline is (nearly) due already, run the handler directly
+    if (deadline <= hal_hptimer_get_us64() + 1) {
+        NVIC_SetPendingIRQ(HP_TIMER_IRQ);
+    }
+}
+
+void hal_hptimer_alarm_init(hal_hptimer_alarm_t *alarm, hal_hptimer_cb_t callback, void *arg)
+{
+    alarm->deadline = 0;
+    alarm->period = 0;
+    alarm->callback = callback;
+    alarm->arg = arg;
+    alarm->next = nullptr;
+    alarm->armed = false;
+}
+
+bool hal_hptimer_alarm_start_at(hal_hptimer_alarm_t *alarm, uint64_t deadline_us, uint32_t period_us)
+{
+    if (!s_initialized || alarm == nullptr || alarm->callback == nullptr) {
+        return false;
+    }
+
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    hal_hptimer_alarm_cancel(alarm);
+
+    alarm->deadline = deadline_us;
+    alarm->period = period_us;
+
+    // Insert after alarms with the same deadline so they fire in start order
+    hal_hptimer_alarm_t **link = &s_alarms;
+    while (*link != nullptr && (*link)->deadline <= deadline_us) {
+        link = &(*link)->next;
+    }
+    alarm->next = *link;
+    *link = alarm;
+    alarm->armed = true;
+
+    if (s_alarms == alarm) {
+        alarm_program_locked();
+    }
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+    return true;
+}
+
+bool hal_hptimer_alarm_start(hal_hptimer_alarm_t *alarm, uint32_t delay_us, uint32_t period_us)
+{
+    return hal_hptimer_alarm_start_at(alarm, hal_hptimer_get_us64() + delay_us, period_us);
+}
+
+bool hal_hptimer_alarm_cancel(hal_hptimer_alarm_t *alarm)
+{
+    if (alarm == nullptr) {
+        return false;
+    }
+
+    bool removed = false;
+    UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+    if (alarm->armed) {
+        for (hal_hptimer_alarm_t **link = &s_alarms; *link != nullptr; link = &(*link)->next) {
+            if (*link == alarm) {
+                *link = alarm->next;
+                removed = true;
+                break;
             }
         }
+        alarm->next = nullptr;
+        alarm->armed = false;
+        // A later deadline leaves CH0 matching early; the handler reprograms
+        // it, so only an empty queue needs the interrupt turned off here
+        if (s_alarms == nullptr) {
+            alarm_program_locked();
+        }
     }
+    taskEXIT_CRITICAL_FROM_ISR(mask);
+    return removed;
+}
+
+bool hal_hptimer_alarm_is_armed(const hal_hptimer_alarm_t *alarm)
+{
+    return alarm != nullptr && alarm->armed;
+}
+
+// Blocking is only possible from a task with interrupts unmasked
+static bool can_block(void)
+{
+    return __get_IPSR() == 0U && __get_PRIMASK() == 0U && __get_BASEPRI() == 0U &&
+           xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+}
+
+static void wake_task(void *arg)
+{
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveIndexedFromISR((TaskHandle_t)arg, HP_TIMER_NOTIFY_INDEX, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void hal_hptimer_sleep_until_us(uint64_t deadline_us)
+{
+    if (!s_initialized) {
+        return;
+    }
+
+    uint64_t now = hal_hptimer_get_us64();
+    if (deadline_us > now + HP_TIMER_SLEEP_MIN_US && can_block()) {
+        hal_hptimer_alarm_t alarm;
+        hal_hptimer_alarm_init(&alarm, wake_task, xTaskGetCurrentTaskHandle());
+
+        // Drop a notification left over from an earlier wait
+        ulTaskNotifyTakeIndexed(HP_TIMER_NOTIFY_INDEX, pdTRUE, 0);
+        hal_hptimer_alarm_start_at(&alarm, deadline_us, 0);
+        while (hal_hptimer_alarm_is_armed(&alarm)) {
+            ulTaskNotifyTakeIndexed(HP_TIMER_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+        }
+    }
+
+    // Short waits, ISRs and critical sections spin; after a wake this only
+    // covers the interrupt latency
+    while (hal_hptimer_get_us64() < deadline_us) {
+    }
+}
+
+void hal_hptimer_sleep_us(uint32_t us)
+{
+    if (us == 0) {
+        return;
+    }
+    hal_hptimer_sleep_until_us(hal_hptimer_get_us64() + us);
+}
+
+void hal_hptimer_delay_us(uint32_t us)
+{
+    hal_hptimer_sleep_us(us);
 }
 
 bool hal_hptimer_is_timeout_us(uint32_t ref_time, uint32_t timeout_us)
@@ -32,26 +32,143 @@ bool hal_hptimer_init(void);
 uint32_t hal_hptimer_get_us(void);
 
 /**
- * @brief Get current timestamp in milliseconds with microsecond precision
+ * @brief Get current timestamp in milliseconds
  * 
- * @return Current timestamp in milliseconds (fractional part discarded)
+ * @return Current timestamp in milliseconds (32-bit, wraps around after ~49 days)
  */
 uint32_t hal_hptimer_get_ms(void);
 
 /**
- * @brief Get high precision timestamp combining FreeRTOS tick and microseconds
- * 
- * @return 64-bit timestamp in microseconds since system start
+ * @brief Get 64-bit monotonic microsecond timestamp
+ *
+ * TIMER1 supplies the lower 32 bits and an overflow interrupt counts the
+ * upper 32 bits. The read is lock-free (retried if an overflow is counted
+ * meanwhile) and stays correct with interrupts masked, so it can be called
+ * from tasks, critical sections and ISRs of any priority.
+ *
+ * @return Microseconds since hal_hptimer_init(), never wraps in practice
  */
 uint64_t hal_hptimer_get_us64(void);
 
+/**
+ * @brief Get raw DWT cycle counter (CPU clock, wraps every ~17.9s at 240MHz)
+ */
+uint32_t hal_hptimer_get_cycles(void);
+
+/**
+ * @brief Get 64-bit monotonic CPU cycle timestamp
+ *
+ * Extends DWT CYCCNT with the upper bits of hal_hptimer_get_us64(), so it
+ * needs no periodic polling. The value is on the same time base as the
+ * microsecond clock: hal_hptimer_get_cycles64() / hal_hptimer_cycles_per_us()
+ * equals hal_hptimer_get_us64() to within a microsecond.
+ *
+ * @return CPU cycles since hal_hptimer_init()
+ */
+uint64_t hal_hptimer_get_cycles64(void);
+
+/**
+ * @brief CPU cycles per microsecond (SystemCoreClock / 1MHz)
+ */
+uint32_t hal_hptimer_cycles_per_us(void);
+
+/**
+ * @brief Re-anchor the cycle counter to the microsecond clock
+ *
+ * Called by hal_hptimer_init() and automatically when the two counters
+ * drift apart (e.g. CYCCNT stopped while a debugger halted the core).
+ * Call it after changing the system clock.
+ */
+void hal_hptimer_calibrate_cycles(void);
+
 /**
  * @brief Delay for specified microseconds
- * 
+ *
+ * Same as hal_hptimer_sleep_us(): blocks the calling task instead of
+ * spinning when it can.
+ *
  * @param us Microseconds to delay (blocking)
  */
 void hal_hptimer_delay_us(uint32_t us);
 
+/**
+ * @brief Alarm callback, invoked from the TIMER1 interrupt
+ *
+ * Runs at interrupt priority 1 (inside configMAX_SYSCALL_INTERRUPT_PRIORITY),
+ * so it may use FreeRTOS *FromISR APIs and restart or cancel alarms.
+ */
+typedef void (*hal_hptimer_cb_t)(void *arg);
+
+/**
+ * @brief Alarm, owned by the caller and linked into the deadline queue
+ *
+ * Initialize with hal_hptimer_alarm_init(); fields are private. The alarm
+ * must stay valid while armed.
+ */
+typedef struct hal_hptimer_alarm {
+    uint64_t deadline;                 // Absolute hal_hptimer_get_us64() time
+    uint32_t period;                   // 0 for one-shot
+    hal_hptimer_cb_t callback;
+    void *arg;
+    struct hal_hptimer_alarm *next;
+    volatile bool armed;
+} hal_hptimer_alarm_t;
+
+/**
+ * @brief Initialize an alarm (not armed)
+ */
+void hal_hptimer_alarm_init(hal_hptimer_alarm_t *alarm, hal_hptimer_cb_t callback, void *arg);
+
+/**
+ * @brief Arm an alarm at an absolute time
+ *
+ * Alarms are kept in a list sorted by deadline; TIMER1 CH0 compares against
+ * the earliest one. A deadline in the past fires immediately. Restarting an
+ * armed alarm moves it. Callable from tasks and ISRs (up to priority 1).
+ *
+ * @param alarm       Initialized alarm
+ * @param deadline_us Absolute time in hal_hptimer_get_us64() microseconds
+ * @param period_us   Reload period for periodic alarms, 0 for one-shot.
+ *                    Periods missed while interrupts were masked are skipped.
+ * @return false if the timer is not initialized or the alarm has no callback
+ */
+bool hal_hptimer_alarm_start_at(hal_hptimer_alarm_t *alarm, uint64_t deadline_us, uint32_t period_us);
+
+/**
+ * @brief Arm an alarm @p delay_us from now, see hal_hptimer_alarm_start_at()
+ */
+bool hal_hptimer_alarm_start(hal_hptimer_alarm_t *alarm, uint32_t delay_us, uint32_t period_us);
+
+/**
+ * @brief Disarm an alarm
+ *
+ * @return true if the alarm was armed
+ */
+bool hal_hptimer_alarm_cancel(hal_hptimer_alarm_t *alarm);
+
+/**
+ * @brief Check whether an alarm is armed (a fired one-shot is not)
+ */
+bool hal_hptimer_alarm_is_armed(const hal_hptimer_alarm_t *alarm);
+
+/**
+ * @brief Block the calling task until an absolute time
+ *
+ * Arms a one-shot alarm that wakes the task through task notification
+ * index configTASK_NOTIFICATION_ARRAY_ENTRIES - 1, then spins out the
+ * remaining interrupt latency, so the wake-up is accurate to a few
+ * microseconds without tick granularity. Waits under 20us, calls from ISRs,
+ * critical sections or before the scheduler starts busy-wait instead.
+ *
+ * @param deadline_us Absolute time in hal_hptimer_get_us64() microseconds
+ */
+void hal_hptimer_sleep_until_us(uint64_t deadline_us);
+
+/**
+ * @brief Block the calling task for @p us microseconds, see hal_hptimer_sleep_until_us()
+ */
+void hal_hptimer_sleep_us(uint32_t us);
+
 /**
  * @brief Check if specified microseconds have elapsed since reference time
  * 
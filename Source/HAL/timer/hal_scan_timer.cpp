@@ -0,0 +1,92 @@
+#include "hal_scan_timer.hpp"
+
+#include "gd32f4xx.h"
+
+// Use TIMER4 for scan timing
+// TIMER4 is a 32-bit general-purpose timer; TIMER1 is reserved for hal_hptimer
+#define SCAN_TIMER              TIMER4
+#define SCAN_TIMER_RCU          RCU_TIMER4
+#define SCAN_TIMER_RST          RCU_TIMER4RST
+#define SCAN_TIMER_IRQ          TIMER4_IRQn
+
+// Timer configuration
+#define SCAN_TIMER_PRESCALER    119      // Same 1MHz time base as hal_hptimer
+#define SCAN_TIMER_IRQ_PRIORITY 2        // Must not be above configMAX_SYSCALL_INTERRUPT_PRIORITY
+
+static hal_scan_timer_cb_t s_on_update = nullptr;
+static hal_scan_timer_cb_t s_on_compare = nullptr;
+static void *s_arg = nullptr;
+static volatile bool s_running = false;
+
+bool hal_scan_timer_start(uint32_t period_us, uint32_t settle_us,
+                          hal_scan_timer_cb_t on_update,
+                          hal_scan_timer_cb_t on_compare, void *arg)
+{
+    if (s_running || period_us < 2 || settle_us == 0 || settle_us >= period_us) {
+        return false;
+    }
+
+    s_on_update = on_update;
+    s_on_compare = on_compare;
+    s_arg = arg;
+
+    // Enable and reset timer
+    rcu_periph_clock_enable(SCAN_TIMER_RCU);
+    rcu_periph_reset_enable(SCAN_TIMER_RST);
+    rcu_periph_reset_disable(SCAN_TIMER_RST);
+
+    timer_parameter_struct timer_init_struct;
+    timer_struct_para_init(&timer_init_struct);
+
+    timer_init_struct.prescaler = SCAN_TIMER_PRESCALER;
+    timer_init_struct.alignedmode = TIMER_COUNTER_EDGE;
+    timer_init_struct.counterdirection = TIMER_COUNTER_UP;
+    timer_init_struct.period = period_us - 1;
+    timer_init_struct.clockdivision = TIMER_CKDIV_DIV1;
+    timer_init_struct.repetitioncounter = 0;
+    timer_init(SCAN_TIMER, &timer_init_struct);
+
+    // CH0 in timing mode: only raises the compare flag, no pin output
+    timer_channel_output_mode_config(SCAN_TIMER, TIMER_CH_0, TIMER_OC_MODE_TIMING);
+    timer_channel_output_pulse_value_config(SCAN_TIMER, TIMER_CH_0, settle_us);
+
+    timer_counter_value_config(SCAN_TIMER, 0);
+    timer_interrupt_flag_clear(SCAN_TIMER, TIMER_INT_FLAG_UP | TIMER_INT_FLAG_CH0);
+    timer_interrupt_enable(SCAN_TIMER, TIMER_INT_UP | TIMER_INT_CH0);
+    nvic_irq_enable(SCAN_TIMER_IRQ, SCAN_TIMER_IRQ_PRIORITY, 0);
+
+    s_running = true;
+    timer_enable(SCAN_TIMER);
+    return true;
+}
+
+void hal_scan_timer_stop(void)
+{
+    timer_disable(SCAN_TIMER);
+    timer_interrupt_disable(SCAN_TIMER, TIMER_INT_UP | TIMER_INT_CH0);
+    timer_interrupt_flag_clear(SCAN_TIMER, TIMER_INT_FLAG_UP | TIMER_INT_FLAG_CH0);
+    s_running = false;
+}
+
+bool hal_scan_timer_is_running(void)
+{
+    return s_running;
+}
+
+extern "C" void TIMER4_IRQHandler(void)
+{
+    // Compare first: within one period it always precedes the update event
+    if (SET == timer_interrupt_flag_get(SCAN_TIMER, TIMER_INT_FLAG_CH0)) {
+        timer_interrupt_flag_clear(SCAN_TIMER, TIMER_INT_FLAG_CH0);
+        if (s_running && s_on_compare != nullptr) {
+            s_on_compare(s_arg);
+        }
+    }
+
+    if (SET == timer_interrupt_flag_get(SCAN_TIMER, TIMER_INT_FLAG_UP)) {
+        timer_interrupt_flag_clear(SCAN_TIMER, TIMER_INT_FLAG_UP);
+        if (s_running && s_on_update != nullptr) {
+            s_on_update(s_arg);
+        }
+    }
+}
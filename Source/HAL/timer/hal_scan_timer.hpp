@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Scan Timer HAL
+ *
+ * Drives periodic, two-phase scans from TIMER4 (32-bit, 1MHz).
+ * Each period raises two interrupt events:
+ *   - compare (CH0) at @p settle_us after the period start: sample inputs
+ *   - update at the end of the period: drive the next step
+ * The caller drives the first step itself before starting the timer.
+ */
+
+/**
+ * @brief Event callback, invoked from the TIMER4 interrupt
+ */
+typedef void (*hal_scan_timer_cb_t)(void *arg);
+
+/**
+ * @brief Start the scan timer
+ *
+ * @param period_us  Period between two steps in microseconds
+ * @param settle_us  Delay from period start to the compare event (0 < settle_us < period_us)
+ * @param on_update  Called at the end of every period (may be NULL)
+ * @param on_compare Called settle_us after every period start (may be NULL)
+ * @param arg        User argument passed to both callbacks
+ * @return true if the timer was started, false on invalid parameters
+ */
+bool hal_scan_timer_start(uint32_t period_us, uint32_t settle_us,
+                          hal_scan_timer_cb_t on_update,
+                          hal_scan_timer_cb_t on_compare, void *arg);
+
+/**
+ * @brief Stop the scan timer and disable its interrupts
+ *
+ * Safe to call from the timer callbacks.
+ */
+void hal_scan_timer_stop(void);
+
+/**
+ * @brief Check whether the scan timer is running
+ */
+bool hal_scan_timer_is_running(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,156 @@
+#ifndef HAL_RING_BUFFER_HPP
+#define HAL_RING_BUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// 头尾索引对齐宽度：Cortex-M4 无数据缓存，32 字节足够；主机上按 64 字节缓存行
+#ifndef SPSC_RING_ALIGN
+#if defined(__arm__)
+#define SPSC_RING_ALIGN 32
+#else
+#define SPSC_RING_ALIGN 64
+#endif
+#endif
+
+/**
+ * @brief 无锁单生产者/单消费者环形缓冲
+ *
+ * 生产者（如串口中断）只写 head_，消费者（任务）只写 tail_，
+ * 双方通过 acquire/release 原子操作交接数据，不需要关中断或内核临界区。
+ * 容量 N 必须为 2 的幂，索引自由递增，用掩码取模，满/空不需要预留空位。
+ *
+ * 除逐个 push/pop 外，提供批量 write/read 以及零拷贝的连续区段
+ * （writeSpan/commitWrite、readSpan/commitRead）。
+ */
+template <typename T, size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "capacity must be power of two");
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "element must be trivially copyable");
+
+   public:
+    // 连续区段
+    struct Span {
+        T *data;
+        size_t len;
+    };
+
+    static constexpr size_t capacity() { return N; }
+
+    // 已缓存元素数量（任一端调用均可，结果可能立即过时）
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) -
+               tail_.load(std::memory_order_acquire);
+    }
+    size_t free() const { return N - size(); }
+    bool empty() const { return size() == 0; }
+    bool full() const { return size() == N; }
+
+    // ---------- 生产者端 ----------
+
+    bool push(const T &value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == N) {
+            return false;
+        }
+        buffer_[head & MASK] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 批量写入，返回实际写入数量
+    size_t write(const T *data, size_t len) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t space = N - (head - tail_.load(std::memory_order_acquire));
+        if (len > space) len = space;
+
+        size_t offset = head & MASK;
+        size_t first = N - offset < len ? N - offset : len;
+        copy(&buffer_[offset], data, first);
+        copy(&buffer_[0], data + first, len - first);
+
+        head_.store(head + len, std::memory_order_release);
+        return len;
+    }
+
+    // 当前可直接写入的连续空闲区段（不回绕）
+    Span writeSpan() {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t space = N - (head - tail_.load(std::memory_order_acquire));
+        size_t offset = head & MASK;
+        size_t len = N - offset < space ? N - offset : space;
+        return {&buffer_[offset], len};
+    }
+
+    // 提交通过 writeSpan 写入的 len 个元素
+    void commitWrite(size_t len) {
+        head_.store(head_.load(std::memory_order_relaxed) + len,
+                    std::memory_order_release);
+    }
+
+    // ---------- 消费者端 ----------
+
+    bool pop(T &value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (head_.load(std::memory_order_acquire) == tail) {
+            return false;
+        }
+        value = buffer_[tail & MASK];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 批量读取，返回实际读取数量
+    size_t read(T *data, size_t len) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t avail = head_.load(std::memory_order_acquire) - tail;
+        if (len > avail) len = avail;
+
+        size_t offset = tail & MASK;
+        size_t first = N - offset < len ? N - offset : len;
+        copy(data, &buffer_[offset], first);
+        copy(data + first, &buffer_[0], len - first);
+
+        tail_.store(tail + len, std::memory_order_release);
+        return len;
+    }
+
+    // 当前可直接读取的连续数据区段（不回绕）
+    Span readSpan() {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t avail = head_.load(std::memory_order_acquire) - tail;
+        size_t offset = tail & MASK;
+        size_t len = N - offset < avail ? N - offset : avail;
+        return {&buffer_[offset], len};
+    }
+
+    // 释放通过 readSpan 读取的 len 个元素
+    void commitRead(size_t len) {
+        tail_.store(tail_.load(std::memory_order_relaxed) + len,
+                    std::memory_order_release);
+    }
+
+    // 丢弃全部数据（仅消费者端调用）
+    void clear() {
+        tail_.store(head_.load(std::memory_order_acquire),
+                    std::memory_order_release);
+    }
+
+   private:
+    static constexpr size_t MASK = N - 1;
+
+    static void copy(T *dst, const T *src, size_t len) {
+        if (len == 0) return;
+        memcpy(dst, src, len * sizeof(T));
+    }
+
+    alignas(SPSC_RING_ALIGN) std::atomic<size_t> head_{0};    // 生产者写
+    alignas(SPSC_RING_ALIGN) std::atomic<size_t> tail_{0};    // 消费者写
+    alignas(SPSC_RING_ALIGN) T buffer_[N];
+};
+
+#endif
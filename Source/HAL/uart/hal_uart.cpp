@@ -167,7 +167,8 @@ UasrtInfo uart7_info = {.baudrate = 921600,
 
 // 全局信号量
 void handle_usart_interrupt(UasrtInfo* config) {
-    if (config->use_dma) {
+    // 循环DMA接收由 Uart::irq_handler 处理
+    if (config->use_dma && !config->dma_rx_circular) {
         if (RESET != usart_interrupt_flag_get(config->usart_periph,
                                               USART_INT_FLAG_IDLE)) {
             /* clear IDLE flag */
@@ -191,33 +192,48 @@ void handle_usart_interrupt(UasrtInfo* config) {
     }
 }
 
+// traceISR_ENTER/EXIT 在启用调度跟踪时记录中断进出
 extern "C" {
 void USART0_IRQHandler(void) {
+    traceISR_ENTER();
     handle_usart_interrupt(&usart0_info);
     Uart::dev[Uart::_UART0]->irq_handler();
+    traceISR_EXIT();
 }
 void USART1_IRQHandler(void) {
+    traceISR_ENTER();
     handle_usart_interrupt(&usart1_info);
     Uart::dev[Uart::_UART1]->irq_handler();
+    traceISR_EXIT();
 }
 void USART2_IRQHandler(void) {
+    traceISR_ENTER();
     handle_usart_interrupt(&usart2_info);
     Uart::dev[Uart::_UART2]->irq_handler();
+    traceISR_EXIT();
 }
 void UART3_IRQHandler(void) {
+    traceISR_ENTER();
     handle_usart_interrupt(&uart3_info);
     Uart::dev[Uart::_UART3]->irq_handler();
+    traceISR_EXIT();
 }
 void USART5_IRQHandler(void) {
+    traceISR_ENTER();
     handle_usart_interrupt(&usart5_info);
     Uart::dev[Uart::_UART5]->irq_handler();
+    traceISR_EXIT();
 }
 void UART6_IRQHandler(void) {
+    traceISR_ENTER();
     handle_usart_interrupt(&uart6_info);
     Uart::dev[Uart::_UART6]->irq_handler();
+    traceISR_EXIT();
 }
 void UART7_IRQHandler(void) {
+    traceISR_ENTER();
     handle_usart_interrupt(&uart7_info);
     Uart::dev[Uart::_UART7]->irq_handler();
+    traceISR_EXIT();
 }
 }
@@ -7,8 +7,9 @@
 #include <string>
 #include <vector>
 
-#include "QueueCPP.h"
+#include "hal_dma.hpp"
 #include "hal_gpio.hpp"
+#include "hal_ring_buffer.hpp"
 
 extern "C" {
 #include "FreeRTOS.h"
@@ -20,7 +21,14 @@ extern "C" {
 }
 
 #define ARRAYNUM(arr_name) (uint32_t)(sizeof(arr_name) / sizeof(*(arr_name)))
-#define DMA_RX_BUFFER_SIZE 1024
+#define DMA_RX_BUFFER_SIZE 1024    // 循环DMA模式下需为2的幂
+#define UART_RX_RING_SIZE 1024    // 非DMA模式接收环形缓冲大小（2的幂）
+#define UART_TX_QUEUE_DEPTH 8     // 异步发送描述符队列深度（2的幂）
+// 发送完成、接收通知使用的任务通知索引；索引 0 留给日志任务、SpiBus 等
+#define UART_NOTIFY_INDEX 2
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES < 4
+#error "hal_uart needs a dedicated task notification index"
+#endif
 
 typedef struct {
     uint32_t baudrate;                     // 波特率
@@ -42,6 +50,7 @@ typedef struct {
     uint16_t rx_count;
     SemaphoreHandle_t dmaRxDoneSema;
     bool use_dma;
+    bool dma_rx_circular;    // 循环DMA接收（由 Uart 处理 IDLE，不再重新装载）
 } UasrtInfo;
 
 class UartConfig {
@@ -64,10 +73,11 @@ class UartConfig {
     uint8_t nvic_irq_sub_priority;         // NVIC中断子优先级
     uint16_t *rx_count;                    // 接收计数
     bool use_dma;                          // 是否使用DMA
-    uint16_t rxQueueSize;                  // 接收队列大小
+    uint16_t rxQueueSize;                  // 接收通知阈值（字节，非DMA模式）
+    bool dma_rx_circular;                  // 是否使用循环DMA接收
 
     UartConfig(UasrtInfo &info, bool enable_dma = true,
-               uint16_t _rxQueueSize = 1)
+               uint16_t _rxQueueSize = 1, bool circular_rx = false)
         : baudrate(info.baudrate),
           gpio_port(info.gpio_port),
           tx_pin(info.tx_pin),
@@ -86,8 +96,10 @@ class UartConfig {
           nvic_irq_sub_priority(info.nvic_irq_sub_priority),
           rx_count(&info.rx_count),    // 传递 rx_count 指针
           use_dma(enable_dma),
-          rxQueueSize(_rxQueueSize) {
+          rxQueueSize(_rxQueueSize),
+          dma_rx_circular(enable_dma && circular_rx) {
         info.use_dma = enable_dma;
+        info.dma_rx_circular = dma_rx_circular;
     }
 };
 
@@ -110,6 +122,12 @@ void UART6_IRQHandler(void);
 void UART7_IRQHandler(void);
 }
 
+// 分散发送段，类似 POSIX iovec
+struct UartIoVec {
+    const uint8_t *data;
+    uint16_t len;
+};
+
 class Uart {
    public:
     friend void USART0_IRQHandler(void);
@@ -120,7 +138,9 @@ class Uart {
     friend void UART6_IRQHandler(void);
     friend void UART7_IRQHandler(void);
 
-    Uart(UartConfig &config) : config(config), rxQueue(config.rxQueueSize) {
+    Uart(UartConfig &config)
+        : config(config),
+          rxNotifyThreshold(config.rxQueueSize ? config.rxQueueSize : 1) {
         initBSP();
         initGpio();
         initUsart();
@@ -131,13 +151,12 @@ class Uart {
         }
     }
 
-    void data_send(const uint8_t *data, uint16_t len) {
-        for (uint16_t i = 0; i < len; i++) {
-            usart_data_transmit(config.usart_periph, data[i]);
-            while (RESET ==
-                   usart_flag_get(config.usart_periph, USART_FLAG_TBE));
-        }
-    }
+    // 异步发送完成回调，DMA模式下在DMA中断中调用，此后缓冲区可复用
+    typedef void (*TxDoneCallback)(void *arg);
+    // 发送开始/总线发送完成（TC）钩子，用于 RS485 方向控制
+    typedef void (*TxHook)(void *arg);
+
+    void data_send(const uint8_t *data, uint16_t len) { send(data, len); }
 
     void data_send(const std::string &str) {
         data_send((const uint8_t *)str.c_str(), str.size());
@@ -147,48 +166,256 @@ class Uart {
         data_send(data.data(), data.size());
     }
 
+    // 阻塞发送：DMA模式下排队后挂起等待传输完成，不占用CPU
     void send(const uint8_t *data, uint16_t len) {
-        if (config.use_dma) {
-            dma_channel_disable(config.dma_periph, config.dma_tx_channel);
-            dma_flag_clear(config.dma_periph, config.dma_tx_channel,
-                           DMA_FLAG_FTF);
-            dma_memory_address_config(config.dma_periph, config.dma_tx_channel,
-                                      DMA_MEMORY_0, (uintptr_t)data);
-            dma_transfer_number_config(config.dma_periph, config.dma_tx_channel,
-                                       len);
-            dma_channel_enable(config.dma_periph, config.dma_tx_channel);
-            while (RESET ==
-                   usart_flag_get(config.usart_periph, USART_FLAG_TBE));
-        } else {
-            for (uint16_t i = 0; i < len; i++) {
-                usart_data_transmit(config.usart_periph, *(data + i));
-                while (RESET ==
-                       usart_flag_get(config.usart_periph, USART_FLAG_TBE));
+        UartIoVec iov = {data, len};
+        writev(&iov, 1);
+    }
+
+    /**
+     * @brief 阻塞分散发送：多个不连续的段作为一次完整发送，无需拼接
+     * @return 段数超过 UART_TX_QUEUE_DEPTH 时返回 false
+     */
+    bool writev(const UartIoVec *iov, size_t count) {
+        if (!config.use_dma) {
+            return writevAsync(iov, count);
+        }
+        if (count > UART_TX_QUEUE_DEPTH) {
+            return false;
+        }
+        // 全是空段时不入队，完成回调会在任务上下文中直接调用
+        size_t total = 0;
+        for (size_t i = 0; i < count; i++) {
+            total += iov[i].len;
+        }
+        if (total == 0) {
+            return true;
+        }
+
+        // 等待队列空间的发送者共用 txNotifyTask，逐个等待
+        xSemaphoreTake(txWaitMutex, portMAX_DELAY);
+        waitTxPendingLocked(UART_TX_QUEUE_DEPTH - count, portMAX_DELAY);
+        TxWaiter waiter = {xTaskGetCurrentTaskHandle(), false};
+        bool ok = writevAsync(iov, count, &Uart::txWaiterDone, &waiter);
+        xSemaphoreGive(txWaitMutex);
+
+        // 只等待自己的最后一段完成，不等队列排空，其他异步发送者无法饿死本调用
+        while (ok && !waiter.done) {
+            ulTaskNotifyTakeIndexed(UART_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
+        }
+        return ok;
+    }
+
+    /**
+     * @brief 异步发送，立即返回
+     * DMA模式下将缓冲区加入发送队列，前一段传输完成中断中自动启动下一段；
+     * 缓冲区在 cb 被调用（或 txPending() 减少）之前必须保持有效。
+     * 非DMA模式下退化为轮询发送，返回前调用 cb。
+     * @return 发送队列已满时返回 false
+     */
+    bool sendAsync(const uint8_t *data, uint16_t len,
+                   TxDoneCallback cb = nullptr, void *arg = nullptr) {
+        UartIoVec iov = {data, len};
+        return writevAsync(&iov, 1, cb, arg);
+    }
+
+    /**
+     * @brief 异步分散发送，各段依次由DMA链式发送，中间不插入其他发送
+     * cb 在最后一段传输完成后调用一次
+     * @return 发送队列空间不足时返回 false（不会只发送部分段）
+     */
+    bool writevAsync(const UartIoVec *iov, size_t count,
+                     TxDoneCallback cb = nullptr, void *arg = nullptr) {
+        if (!config.use_dma) {
+            pollWrite(iov, count);
+            if (cb != nullptr) {
+                cb(arg);
+            }
+            return true;
+        }
+
+        // 跳过空段，DMA不接受零长度传输
+        size_t last = count;
+        size_t segments = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (iov[i].len != 0) {
+                last = i;
+                segments++;
             }
         }
+        if (segments == 0) {
+            if (cb != nullptr) {
+                cb(arg);
+            }
+            return true;
+        }
+
+        bool ok = false;
+        // 多个任务可能同时发送，生产端用临界区串行化；DMA中断为唯一消费者
+        taskENTER_CRITICAL();
+        if (txQueue.free() >= segments) {
+            bool idle = txQueue.empty();
+            for (size_t i = 0; i <= last; i++) {
+                if (iov[i].len == 0) {
+                    continue;
+                }
+                TxDesc desc = {iov[i].data, iov[i].len,
+                               i == last ? cb : nullptr,
+                               i == last ? arg : nullptr};
+                txQueue.push(desc);
+            }
+            if (idle) {
+                beginTxBurst();
+                startTx(txQueue.readSpan().data[0]);
+            }
+            ok = true;
+        }
+        taskEXIT_CRITICAL();
+        return ok;
+    }
+
+    /**
+     * @brief 设置发送方向钩子
+     * on_start 在总线由空闲转为发送前调用（任务上下文，临界区内）；
+     * on_idle 在最后一个字节移出移位寄存器（TC）后调用（中断上下文）
+     */
+    void setTxHooks(TxHook on_start, TxHook on_idle, void *arg) {
+        taskENTER_CRITICAL();
+        txStartHook = on_start;
+        txIdleHook = on_idle;
+        txHookArg = arg;
+        taskEXIT_CRITICAL();
+    }
+
+    // 尚未完成的异步发送数量（含正在传输的一段）
+    size_t txPending() const { return txQueue.size(); }
+
+    /**
+     * @brief 挂起当前任务，直到未完成的异步发送不超过 maxPending 段
+     * 多个等待任务（含阻塞发送）由互斥量串行化，依次等待
+     */
+    bool waitTxPending(size_t maxPending, TickType_t time = portMAX_DELAY) {
+        if (txQueue.size() <= maxPending) {
+            return true;
+        }
+        if (xSemaphoreTake(txWaitMutex, time) != pdTRUE) {
+            return false;
+        }
+        bool ok = waitTxPendingLocked(maxPending, time);
+        xSemaphoreGive(txWaitMutex);
+        return ok;
     }
 
     bool recv_1byte(uint8_t &data, TickType_t time = portMAX_DELAY) {
-        if (!config.use_dma) {
-            return rxQueue.pop(data, time);
+        if (!config.use_dma || config.dma_rx_circular) {
+            if (read(&data, 1) == 1) {
+                return true;
+            }
+            return waitForData(time) && read(&data, 1) == 1;
         }
         return false;
     }
 
+    /**
+     * @brief 设置接收通知（非DMA模式及循环DMA模式）
+     * 非DMA模式：缓冲数据达到 threshold 字节或总线空闲时通知；
+     * 循环DMA模式：半满、全满、总线空闲事件时通知。
+     * 消费者用 ulTaskNotifyTakeIndexed(UART_NOTIFY_INDEX, ...) 等待后调用
+     * read() 或 rxSpan() 取出
+     */
+    void setRxNotify(TaskHandle_t task, uint16_t threshold = 1) {
+        rxNotifyThreshold = threshold ? threshold : 1;
+        rxNotifyTask = task;
+    }
+
+    // 等待接收数据（当前任务作为通知对象），有数据返回 true
+    bool waitForData(TickType_t time = portMAX_DELAY) {
+        if (available() != 0) {
+            return true;
+        }
+        if (time == 0) {
+            return false;
+        }
+        rxNotifyTask = xTaskGetCurrentTaskHandle();
+        // 发送完成也使用同一通知索引，唤醒后重新检查，直到有数据或超时
+        TimeOut_t timeOut;
+        vTaskSetTimeOutState(&timeOut);
+        while (available() == 0 &&
+               xTaskCheckForTimeOut(&timeOut, &time) == pdFALSE) {
+            ulTaskNotifyTakeIndexed(UART_NOTIFY_INDEX, pdTRUE, time);
+        }
+        return available() != 0;
+    }
+
+    using RxSpan = SpscRing<uint8_t, UART_RX_RING_SIZE>::Span;
+
+    // 可读取的字节数（非DMA模式及循环DMA模式）
+    size_t available() {
+        if (config.dma_rx_circular) {
+            return dmaRxAvailable();
+        }
+        return rxRing.size();
+    }
+
+    /**
+     * @brief 零拷贝读取：返回接收缓冲中一段连续数据（不回绕）
+     * 处理完成后调用 rxConsume() 释放；数据跨越缓冲末尾时需调用两次
+     */
+    RxSpan rxSpan() {
+        if (config.dma_rx_circular) {
+            size_t avail = dmaRxAvailable();
+            size_t offset = dmaRxTail & (DMA_RX_BUFFER_SIZE - 1);
+            size_t len = DMA_RX_BUFFER_SIZE - offset;
+            return {&dmaRxBuffer[offset], avail < len ? avail : len};
+        }
+        return rxRing.readSpan();
+    }
+
+    // 释放 rxSpan() 返回的前 len 个字节
+    void rxConsume(size_t len) {
+        if (config.dma_rx_circular) {
+            dmaRxTail += len;
+        } else {
+            rxRing.commitRead(len);
+        }
+    }
+
+    // 批量读取到调用者缓冲区，返回读取字节数
+    size_t read(uint8_t *buf, size_t len) {
+        if (!config.dma_rx_circular) {
+            return rxRing.read(buf, len);
+        }
+        size_t total = 0;
+        while (total < len) {
+            RxSpan span = rxSpan();
+            if (span.len == 0) {
+                break;
+            }
+            size_t n = len - total < span.len ? len - total : span.len;
+            memcpy(buf + total, span.data, n);
+            rxConsume(n);
+            total += n;
+        }
+        return total;
+    }
+
+    // 接收缓冲溢出丢弃的字节数
+    uint32_t rxOverflowCount() const { return rxOverflows; }
+
     std::vector<uint8_t> getReceivedData() {
         std::vector<uint8_t> buffer;
         // Resize the buffer to ensure it has enough space
-        if (config.use_dma) {
+        if (config.dma_rx_circular) {
+            buffer.resize(available());
+            buffer.resize(read(buffer.data(), buffer.size()));
+        } else if (config.use_dma) {
             buffer.resize(*config.rx_count);
             memcpy(buffer.data(), dmaRxBuffer, *config.rx_count);
             // clear
             *config.rx_count = 0;
         } else {
-            uint8_t data;
-            buffer.reserve(rxQueue.waiting());
-            while (rxQueue.pop(data, 0)) {
-                buffer.push_back(data);
-            }
+            buffer.resize(rxRing.size());
+            buffer.resize(rxRing.read(buffer.data(), buffer.size()));
         }
 
         return buffer;
@@ -212,16 +439,239 @@ class Uart {
     };
     static Uart *dev[_UART_NUM];
     static bool is_bsp_init;
-    Queue<uint8_t> rxQueue;
-    long waswoken = pdFALSE;
+
+    // 异步发送描述符
+    struct TxDesc {
+        const uint8_t *data;
+        uint16_t len;
+        TxDoneCallback cb;
+        void *arg;
+    };
+    // 队首为正在传输的描述符，传输完成中断中出队
+    SpscRing<TxDesc, UART_TX_QUEUE_DEPTH> txQueue;
+    volatile TaskHandle_t txNotifyTask = nullptr;
+    // 持有者独占 txNotifyTask
+    SemaphoreHandle_t txWaitMutex = xSemaphoreCreateMutex();
+    TxHook txStartHook = nullptr;
+    TxHook txIdleHook = nullptr;
+    void *txHookArg = nullptr;
+
+    // 调用者持有 txWaitMutex
+    bool waitTxPendingLocked(size_t maxPending, TickType_t time) {
+        if (txQueue.size() <= maxPending) {
+            return true;
+        }
+        txNotifyTask = xTaskGetCurrentTaskHandle();
+        // 接收通知也使用同一通知索引，唤醒后重新检查，直到满足或超时
+        TimeOut_t timeOut;
+        vTaskSetTimeOutState(&timeOut);
+        while (txQueue.size() > maxPending &&
+               xTaskCheckForTimeOut(&timeOut, &time) == pdFALSE) {
+            ulTaskNotifyTakeIndexed(UART_NOTIFY_INDEX, pdTRUE, time);
+        }
+        txNotifyTask = nullptr;
+        return txQueue.size() <= maxPending;
+    }
+
+    // 轮询发送（非DMA模式），结束后等待 TC 再调用空闲钩子
+    void pollWrite(const UartIoVec *iov, size_t count) {
+        if (txStartHook != nullptr) {
+            txStartHook(txHookArg);
+        }
+        for (size_t n = 0; n < count; n++) {
+            for (uint16_t i = 0; i < iov[n].len; i++) {
+                usart_data_transmit(config.usart_periph, iov[n].data[i]);
+                while (RESET ==
+                       usart_flag_get(config.usart_periph, USART_FLAG_TBE));
+            }
+        }
+        if (txIdleHook != nullptr) {
+            while (RESET == usart_flag_get(config.usart_periph, USART_FLAG_TC));
+            txIdleHook(txHookArg);
+        }
+    }
+
+    // 总线由空闲转为发送：调用开始钩子，并清除上一次的 TC
+    void beginTxBurst() {
+        if (txStartHook != nullptr) {
+            txStartHook(txHookArg);
+        }
+        usart_interrupt_disable(config.usart_periph, USART_INT_TC);
+    }
+    SpscRing<uint8_t, UART_RX_RING_SIZE> rxRing;    // 中断写、任务读，无锁
+    volatile TaskHandle_t rxNotifyTask = nullptr;
+    uint16_t rxNotifyThreshold;
+    volatile uint32_t rxOverflows = 0;
+
+    // 循环DMA接收：自由递增的写/读计数，写计数由中断根据DMA剩余数量推进
+    volatile uint32_t dmaRxHead = 0;
+    volatile uint32_t dmaRxTail = 0;
+    uint32_t dmaRxLastPos = 0;
+
+    static_assert((DMA_RX_BUFFER_SIZE & (DMA_RX_BUFFER_SIZE - 1)) == 0,
+                  "DMA_RX_BUFFER_SIZE must be power of two");
+
+    size_t dmaRxAvailable() {
+        uint32_t avail = dmaRxHead - dmaRxTail;
+        if (avail > DMA_RX_BUFFER_SIZE) {
+            // 消费者太慢，DMA 已覆盖未读数据，丢弃最旧部分
+            rxOverflows = rxOverflows + (avail - DMA_RX_BUFFER_SIZE);
+            dmaRxTail = dmaRxHead - DMA_RX_BUFFER_SIZE;
+            avail = DMA_RX_BUFFER_SIZE;
+        }
+        return avail;
+    }
+
+    // 由 HT/TC/IDLE 中断调用，根据 DMA 当前写位置推进写计数
+    void dmaRxUpdate() {
+        uint32_t pos = (DMA_RX_BUFFER_SIZE -
+                        dma_transfer_number_get(config.dma_periph,
+                                                config.dma_rx_channel)) &
+                       (DMA_RX_BUFFER_SIZE - 1);
+        uint32_t delta = (pos - dmaRxLastPos) & (DMA_RX_BUFFER_SIZE - 1);
+        if (delta == 0) {
+            return;
+        }
+        dmaRxLastPos = pos;
+        dmaRxHead = dmaRxHead + delta;
+
+        TaskHandle_t task = rxNotifyTask;
+        if (task != nullptr) {
+            BaseType_t woken = pdFALSE;
+            vTaskNotifyGiveIndexedFromISR(task, UART_NOTIFY_INDEX, &woken);
+            portYIELD_FROM_ISR(woken);
+        }
+    }
+
+    static void dmaRxIrq(uint32_t dma_periph, dma_channel_enum channel,
+                         void *arg) {
+        Uart *self = static_cast<Uart *>(arg);
+        if (SET == dma_interrupt_flag_get(dma_periph, channel,
+                                          DMA_INT_FLAG_HTF)) {
+            dma_interrupt_flag_clear(dma_periph, channel, DMA_INT_FLAG_HTF);
+        }
+        if (SET == dma_interrupt_flag_get(dma_periph, channel,
+                                          DMA_INT_FLAG_FTF)) {
+            dma_interrupt_flag_clear(dma_periph, channel, DMA_INT_FLAG_FTF);
+        }
+        self->dmaRxUpdate();
+    }
+
+    // 阻塞发送的完成标志，位于 writev() 栈上
+    struct TxWaiter {
+        TaskHandle_t task;
+        volatile bool done;
+    };
+
+    // writev() 最后一段的完成回调（DMA中断）
+    static void txWaiterDone(void *arg) {
+        TxWaiter *waiter = static_cast<TxWaiter *>(arg);
+        // 置位后等待者可能立即返回并释放栈上的 waiter，先取出任务句柄
+        TaskHandle_t task = waiter->task;
+        waiter->done = true;
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveIndexedFromISR(task, UART_NOTIFY_INDEX, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+
+    // 启动一段DMA发送，调用前通道必须空闲
+    void startTx(const TxDesc &desc) {
+        dma_channel_disable(config.dma_periph, config.dma_tx_channel);
+        dma_interrupt_flag_clear(config.dma_periph, config.dma_tx_channel,
+                                 DMA_INT_FLAG_FTF);
+        dma_memory_address_config(config.dma_periph, config.dma_tx_channel,
+                                  DMA_MEMORY_0, (uintptr_t)desc.data);
+        dma_transfer_number_config(config.dma_periph, config.dma_tx_channel,
+                                   desc.len);
+        // 每段都清除 TC：段间移位寄存器短暂变空会置位 TC，若残留到最后一段，
+        // TC 中断会在最后字节移出前触发，提前释放 RS485 方向
+        usart_flag_clear(config.usart_periph, USART_FLAG_TC);
+        dma_channel_enable(config.dma_periph, config.dma_tx_channel);
+    }
+
+    // 传输完成：出队当前描述符，链接下一段，并通知完成
+    void txComplete() {
+        SpscRing<TxDesc, UART_TX_QUEUE_DEPTH>::Span head = txQueue.readSpan();
+        if (head.len == 0) {
+            return;
+        }
+        TxDesc done = head.data[0];
+        txQueue.commitRead(1);
+
+        head = txQueue.readSpan();
+        if (head.len != 0) {
+            startTx(head.data[0]);
+        } else if (txIdleHook != nullptr) {
+            // DMA完成时最后一个字节仍在移位，等 TC 中断再释放总线
+            usart_interrupt_enable(config.usart_periph, USART_INT_TC);
+        }
+
+        if (done.cb != nullptr) {
+            done.cb(done.arg);
+        }
+        TaskHandle_t task = txNotifyTask;
+        if (task != nullptr) {
+            BaseType_t woken = pdFALSE;
+            vTaskNotifyGiveIndexedFromISR(task, UART_NOTIFY_INDEX, &woken);
+            portYIELD_FROM_ISR(woken);
+        }
+    }
+
+    static void dmaTxIrq(uint32_t dma_periph, dma_channel_enum channel,
+                         void *arg) {
+        if (SET == dma_interrupt_flag_get(dma_periph, channel,
+                                          DMA_INT_FLAG_FTF)) {
+            dma_interrupt_flag_clear(dma_periph, channel, DMA_INT_FLAG_FTF);
+            static_cast<Uart *>(arg)->txComplete();
+        }
+    }
 
     void irq_handler() {
+        if (RESET != usart_interrupt_flag_get(config.usart_periph,
+                                              USART_INT_FLAG_TC)) {
+            usart_interrupt_disable(config.usart_periph, USART_INT_TC);
+            usart_interrupt_flag_clear(config.usart_periph, USART_INT_FLAG_TC);
+            if (txQueue.empty() && txIdleHook != nullptr) {
+                txIdleHook(txHookArg);
+            }
+        }
+        if (config.dma_rx_circular) {
+            if (RESET != usart_interrupt_flag_get(config.usart_periph,
+                                                  USART_INT_FLAG_IDLE)) {
+                /* clear IDLE flag */
+                usart_data_receive(config.usart_periph);
+                dmaRxUpdate();
+            }
+            return;
+        }
         if (!config.use_dma) {
+            bool notify = false;
+
             if (RESET != usart_interrupt_flag_get(config.usart_periph,
                                                   USART_INT_FLAG_RBNE)) {
+                uint8_t data = usart_data_receive(config.usart_periph);
+                size_t before = rxRing.size();
+                if (rxRing.push(data)) {
+                    // 只在跨过阈值时通知一次
+                    notify = before + 1 == rxNotifyThreshold;
+                } else {
+                    rxOverflows = rxOverflows + 1;
+                }
+            }
+
+            if (RESET != usart_interrupt_flag_get(config.usart_periph,
+                                                  USART_INT_FLAG_IDLE)) {
+                /* clear IDLE flag */
+                usart_data_receive(config.usart_periph);
+                notify = !rxRing.empty();
+            }
+
+            TaskHandle_t task = rxNotifyTask;
+            if (notify && task != nullptr) {
+                BaseType_t woken = pdFALSE;
+                vTaskNotifyGiveIndexedFromISR(task, UART_NOTIFY_INDEX, &woken);
+                portYIELD_FROM_ISR(woken);
             }
-            rxQueue.add_ISR(usart_data_receive(config.usart_periph), waswoken);
-            portYIELD_FROM_ISR(waswoken);
         }
     }
 
@@ -299,7 +749,8 @@ class Uart {
         if (config.use_dma) {
             usart_interrupt_enable(config.usart_periph, USART_INT_IDLE);
         } else {
-            // usart_interrupt_enable(config.usart_periph, USART_INT_IDLE);
+            // 总线空闲时唤醒消费者处理不足阈值的尾部数据
+            usart_interrupt_enable(config.usart_periph, USART_INT_IDLE);
             nvic_irq_enable(config.nvic_irq, config.nvic_irq_pre_priority,
                             config.nvic_irq_sub_priority);
             usart_interrupt_enable(config.usart_periph, USART_INT_RBNE);
@@ -324,6 +775,14 @@ class Uart {
         dma_channel_subperipheral_select(
             config.dma_periph, config.dma_tx_channel, config.dma_sub_per);
         dma_channel_disable(config.dma_periph, config.dma_tx_channel);
+
+        // 传输完成中断用于链接发送队列中的下一段
+        dma_interrupt_flag_clear(config.dma_periph, config.dma_tx_channel,
+                                 DMA_INT_FLAG_FTF);
+        dma_interrupt_enable(config.dma_periph, config.dma_tx_channel,
+                             DMA_INT_FTF);
+        hal_dma_register(config.dma_periph, config.dma_tx_channel,
+                         &Uart::dmaTxIrq, this, config.nvic_irq_pre_priority);
     }
 
     void initDmaRx() {
@@ -342,30 +801,67 @@ class Uart {
         dmaInitStruct.priority = DMA_PRIORITY_ULTRA_HIGH;
         dma_single_data_mode_init(config.dma_periph, config.dma_rx_channel,
                                   &dmaInitStruct);
-        dma_circulation_disable(config.dma_periph, config.dma_rx_channel);
         dma_channel_subperipheral_select(
             config.dma_periph, config.dma_rx_channel, config.dma_sub_per);
+
+        if (config.dma_rx_circular) {
+            // 循环接收：DMA 不停止，半满/全满/空闲时更新写位置
+            dma_circulation_enable(config.dma_periph, config.dma_rx_channel);
+            dma_interrupt_flag_clear(config.dma_periph, config.dma_rx_channel,
+                                     DMA_INT_FLAG_HTF | DMA_INT_FLAG_FTF);
+            dma_interrupt_enable(config.dma_periph, config.dma_rx_channel,
+                                 DMA_INT_HTF | DMA_INT_FTF);
+            // 与串口中断同一抢占优先级，避免两者互相嵌套
+            hal_dma_register(config.dma_periph, config.dma_rx_channel,
+                             &Uart::dmaRxIrq, this,
+                             config.nvic_irq_pre_priority);
+        } else {
+            dma_circulation_disable(config.dma_periph, config.dma_rx_channel);
+        }
         dma_channel_enable(config.dma_periph, config.dma_rx_channel);
     }
 };
 
 class Rs485 {
    public:
+    // 方向控制由 Uart 发送钩子完成：开始发送前使能驱动，TC 后释放
     Rs485(Uart &uart, GPIO::Port port, GPIO::Pin pin)
-        : uart(uart), ctrl(port, pin, GPIO::Mode::OUTPUT) {}
+        : uart(uart), ctrl(port, pin, GPIO::Mode::OUTPUT) {
+        ctrl.bit_reset();
+        uart.setTxHooks(&Rs485::driverEnable, &Rs485::driverRelease, this);
+    }
+    ~Rs485() { uart.setTxHooks(nullptr, nullptr, nullptr); }
     Uart &uart;
 
+    // 不在这里释放驱动：异步发送可能仍在进行，由 TC 钩子释放
     std::vector<uint8_t> getReceivedData() {
-        ctrl.bit_reset();
         return uart.getReceivedData();
     }
 
-    void data_send(std::vector<uint8_t> &data) {
-        ctrl.bit_set();
-        uart.data_send(data);
+    void data_send(std::vector<uint8_t> &data) { uart.data_send(data); }
+
+    void data_send(const uint8_t *data, uint16_t len) {
+        uart.data_send(data, len);
+    }
+
+    // 分散发送，所有段发送期间保持驱动使能
+    bool writev(const UartIoVec *iov, size_t count) {
+        return uart.writev(iov, count);
+    }
+
+    bool writevAsync(const UartIoVec *iov, size_t count,
+                     Uart::TxDoneCallback cb = nullptr, void *arg = nullptr) {
+        return uart.writevAsync(iov, count, cb, arg);
     }
 
    private:
     GPIO ctrl;
+
+    static void driverEnable(void *arg) {
+        static_cast<Rs485 *>(arg)->ctrl.bit_set();
+    }
+    static void driverRelease(void *arg) {
+        static_cast<Rs485 *>(arg)->ctrl.bit_reset();
+    }
 };
 #endif
@@ -1,5 +1,6 @@
 #include "FreeRTOS.h"
 #include "task.h"
+#include "CrashLog.h"
 #include <stdio.h>
 // #include "bsp_log.h"
 // #define IDLE_TASK_STACK_SIZE 32
@@ -86,8 +87,9 @@ void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName) {
     // 打印错误信息（使用你系统的输出接口）
     printf("Stack overflow detected in task: %s\n", pcTaskName);
 
-    // 无限循环等待开发者处理（如：进入 debug）
-    for (;;);
+    // 保存故障记录后复位或停住等待开发者处理（如：进入 debug）
+    crash_log_stack_overflow(pcTaskName);
+    crash_log_halt();
 }
 
 // void vApplicationMallocFailedHook(void)
@@ -36,6 +36,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdio.h>
 
+#include "CrashLog.h"
 #include "gd32f4xx.h"
 
 #ifdef MASTER
@@ -66,16 +67,20 @@ void NMI_Handler(void) {
 */
 extern uint32_t __StackTop;      // 栈顶地址（链接脚本定义）
 extern uint32_t __StackLimit;    // 栈底地址
-void HardFault_Handler(void) {
+__attribute__((naked)) void HardFault_Handler(void) {
     __asm volatile(
         "TST lr, #4 \n"
         "ITE EQ \n"
         "MRSEQ r0, MSP \n"
         "MRSNE r0, PSP \n"
+        "MOV r1, lr \n"
         "B HardFault_Handler_C \n");
 }
 
-void HardFault_Handler_C(uint32_t *fault_stack_address) {
+void HardFault_Handler_C(uint32_t *fault_stack_address, uint32_t exc_return) {
+    /* save the fault record to no-init RAM before anything else */
+    crash_log_fault(CRASH_REASON_HARD_FAULT, fault_stack_address, exc_return);
+
     uint32_t r0 = fault_stack_address[0];
     uint32_t r1 = fault_stack_address[1];
     uint32_t r2 = fault_stack_address[2];
@@ -109,7 +114,7 @@ void HardFault_Handler_C(uint32_t *fault_stack_address) {
                (unsigned long)((uint32_t)&__StackLimit - msp));
     }
 
-    while (1);
+    crash_log_halt();
 }
 /*!
     \brief      this function handles MemManage exception
@@ -169,6 +174,8 @@ void DebugMon_Handler(void) {
 void ENET_IRQHandler(void) {
     portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 
+    traceISR_ENTER();
+
     /* frame received */
     if (SET == enet_interrupt_flag_get(ENET_DMA_INT_FLAG_RS)) {
         /* give the semaphore to wakeup LwIP task */
@@ -183,5 +190,6 @@ void ENET_IRQHandler(void) {
     if (pdFALSE != xHigherPriorityTaskWoken) {
         portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
     }
+    traceISR_EXIT();
 }
 #endif
\ No newline at end of file
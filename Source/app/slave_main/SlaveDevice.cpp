@@ -16,7 +16,7 @@ SlaveDevice::SlaveDevice() {
 void SlaveDevice::run() {
     if (systemLedTask) {
         systemLedTask->give();
-        Log::d(TAG, "SystemLedTask initialized and started");
+        LOGD(TAG, "SystemLedTask initialized and started");
     }
 
     while (1) {
@@ -33,7 +33,7 @@ SlaveDevice::SystemLedTask::SystemLedTask(SlaveDevice& parent)
 
 void SlaveDevice::SystemLedTask::task() {
     if (!systemLed) {
-        Log::e(TAG, "Failed to create system LED");
+        LOGE(TAG, "Failed to create system LED");
         return;
     }
 
@@ -20,16 +20,16 @@ static void Slave_Task(void *pvParameters) {
 
     LogManager::quickInit(LogManager::UART_TYPE_UART3, true,
                           Logger::Level::TRACE);
-    Log::d(TAG, "LogTask initialized");
+    LOGD(TAG, "LogTask initialized");
 
     if (!hal_hptimer_init()) {
-        Log::e("SlaveDevice", "Failed to initialize high precision timer");
+        LOGE("SlaveDevice", "Failed to initialize high precision timer");
         // return false;
     }
 
     // // 创建任务管理器，每15秒打印一次运行时统计
     // TaskManager taskManager(15000);
-    // Log::d(TAG, "TaskManager initialized");
+    // LOGD(TAG, "TaskManager initialized");
 
     SlaveDevice slaveDevice;
     slaveDevice.run();
@@ -21,6 +21,10 @@ enum class GpioMode : uint8_t {
     INPUT_PULLDOWN = 3 // 输入下拉模式
 };
 
+// GPIO端口数量（PA~PG）与每端口引脚数，物理引脚编号 = 端口 * 16 + 位号
+static constexpr uint8_t GPIO_PORT_COUNT = 7;
+static constexpr uint8_t GPIO_PINS_PER_PORT = 16;
+
 // GPIO引脚配置结构
 struct GpioConfig {
     uint8_t pin;         // 引脚编号
@@ -54,6 +58,16 @@ class IGpio {
 
     // 去初始化GPIO引脚
     virtual bool deinit(uint8_t pin) = 0;
+
+    // 端口快照：连续读取前 portCount 个端口的输入寄存器
+    // snapshot[i] 为端口 i 的 16 位输入状态（bit n 对应物理引脚 i * 16 + n）
+    virtual bool readPortSnapshot(uint16_t *snapshot, uint8_t portCount) = 0;
+
+    // 端口批量配置：将端口 port 中 pinMask 置位的引脚一次性配置为 mode
+    // 输出模式会先写入 initState 再切换模式，避免输出毛刺
+    // 可在任务和中断（优先级不高于 configMAX_SYSCALL_INTERRUPT_PRIORITY）中调用
+    virtual bool configurePort(uint8_t port, uint16_t pinMask, GpioMode mode,
+                               GpioState initState = GpioState::LOW) = 0;
 };
 
 } // namespace Interface
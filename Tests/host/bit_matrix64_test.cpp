@@ -0,0 +1,140 @@
+// BitMatrix64::pack() 与原 getDataVector() 逐位编码的一致性测试
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "BitMatrix64.h"
+
+using Adapter::BitMatrix64;
+using Adapter::ContinuityState;
+
+using LegacyMatrix = std::vector<std::vector<ContinuityState>>;
+
+// 原 ContinuityCollector::getDataVector() 的实现（逐位拼接，大端位序）
+static std::vector<uint8_t> legacyDataVector(const LegacyMatrix &matrix,
+                                             size_t num) {
+    std::vector<uint8_t> compressedData;
+    compressedData.reserve((matrix.size() * num + 7) / 8);
+
+    uint8_t currentByte = 0;
+    uint8_t bitPosition = 7;
+    for (const auto &row : matrix) {
+        for (size_t pin = 0; pin < num && pin < row.size(); pin++) {
+            uint8_t bitValue = (row[pin] == ContinuityState::CONNECTED) ? 1 : 0;
+            currentByte |= (bitValue << bitPosition);
+            if (bitPosition == 0) {
+                compressedData.push_back(currentByte);
+                currentByte = 0;
+                bitPosition = 7;
+            } else {
+                bitPosition--;
+            }
+        }
+    }
+    if (bitPosition != 7) {
+        compressedData.push_back(currentByte);
+    }
+    return compressedData;
+}
+
+// 生成随机矩阵，同时写入两种存储
+static void fillRandom(std::mt19937 &rng, uint8_t rows, uint8_t cols,
+                       int densityPercent, BitMatrix64 &bits,
+                       LegacyMatrix &legacy) {
+    std::uniform_int_distribution<int> percent(0, 99);
+    bits.reset(rows, cols);
+    legacy.assign(rows, std::vector<ContinuityState>(
+                            cols, ContinuityState::DISCONNECTED));
+    for (uint8_t r = 0; r < rows; r++) {
+        for (uint8_t p = 0; p < cols; p++) {
+            if (percent(rng) < densityPercent) {
+                bits.set(r, p, ContinuityState::CONNECTED);
+                legacy[r][p] = ContinuityState::CONNECTED;
+            }
+        }
+    }
+}
+
+static void testAllSizes() {
+    std::mt19937 rng(12345);
+    const int densities[] = {0, 3, 50, 97, 100};
+    BitMatrix64 bits;
+    LegacyMatrix legacy;
+
+    for (int rows = 0; rows <= BitMatrix64::MAX_ROWS; rows++) {
+        for (int cols = 0; cols <= BitMatrix64::MAX_COLS; cols++) {
+            for (int density : densities) {
+                fillRandom(rng, rows, cols, density, bits, legacy);
+                std::vector<uint8_t> expect = legacyDataVector(legacy, cols);
+                std::vector<uint8_t> actual = bits.pack();
+                assert(actual == expect);
+                assert(bits.packedSize() == expect.size());
+
+                // 往返：解码后逐位一致
+                BitMatrix64 decoded;
+                decoded.reset(rows, cols);
+                assert(decoded.unpack(actual.data(), actual.size()));
+                for (uint8_t r = 0; r < rows; r++) {
+                    assert(decoded.rowWord(r) == bits.rowWord(r));
+                }
+            }
+        }
+    }
+}
+
+static void testViews() {
+    std::mt19937 rng(777);
+    BitMatrix64 bits;
+    LegacyMatrix legacy;
+    fillRandom(rng, 40, 37, 50, bits, legacy);
+
+    for (uint8_t r = 0; r < 40; r++) {
+        BitMatrix64::RowView row = bits.row(r);
+        assert(row.size() == 37);
+        for (uint8_t p = 0; p < 37; p++) {
+            assert(row[p] == legacy[r][p]);
+        }
+    }
+    for (uint8_t p = 0; p < 37; p++) {
+        BitMatrix64::ColumnView col = bits.column(p);
+        assert(col.size() == 40);
+        for (uint8_t r = 0; r < 40; r++) {
+            assert(col[r] == legacy[r][p]);
+        }
+    }
+    // 越界访问返回空视图或断开
+    assert(bits.row(40).empty());
+    assert(bits.column(37).empty());
+    assert(bits.get(0, 37) == ContinuityState::DISCONNECTED);
+}
+
+static void testBufferTooSmall() {
+    BitMatrix64 bits;
+    bits.reset(3, 5);    // 15 位，2 字节
+    uint8_t out[2] = {};
+    assert(bits.pack(out, 1) == 0);
+    assert(bits.pack(nullptr, 2) == 0);
+    assert(bits.pack(out, 2) == 2);
+}
+
+static void testSetRowMasksUnusedColumns() {
+    BitMatrix64 bits;
+    bits.reset(2, 10);
+    bits.setRow(0, ~0ULL);
+    assert(bits.rowWord(0) == (~0ULL << 54));
+    std::vector<uint8_t> packed = bits.pack();
+    // 10 个 1 后跟 10 个 0
+    assert(packed.size() == 3);
+    assert(packed[0] == 0xFF && packed[1] == 0xC0 && packed[2] == 0x00);
+}
+
+int main() {
+    testAllSizes();
+    testViews();
+    testBufferTooSmall();
+    testSetRowMasksUnusedColumns();
+    std::printf("bit_matrix64_test: OK\n");
+    return 0;
+}
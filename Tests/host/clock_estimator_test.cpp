@@ -0,0 +1,184 @@
+// ClockEstimator 合成时钟测试：已知频偏和偏差的主时钟，带随机往返延迟
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+#include "ClockEstimator.h"
+
+namespace {
+
+/**
+ * 以真实时间 t（us）为自变量：
+ *   local(t)  = t
+ *   master(t) = t + offset + t * skew
+ * 每次交换：本地 t1 发出，上行延迟后主机 t2 收到，处理后 t3 回复，
+ * 下行延迟后本地 t4 收到。
+ */
+struct SkewedClocks {
+    double offsetUs;
+    double skew;    // 主时钟相对本地时钟的频率偏差
+
+    double master(double t) const { return t + offsetUs + t * skew; }
+};
+
+struct Link {
+    std::mt19937 rng;
+    double baseUs;           // 单程最小延迟
+    double jitterUs;         // 单程均匀抖动
+    int queuePercent;        // 单向排队的概率
+    double queueUs;          // 排队附加延迟上限
+
+    double oneWay() {
+        std::uniform_real_distribution<double> jitter(0, jitterUs);
+        std::uniform_real_distribution<double> queue(0, queueUs);
+        std::uniform_int_distribution<int> percent(0, 99);
+        double d = baseUs + jitter(rng);
+        if (percent(rng) < queuePercent) d += queue(rng);
+        return d;
+    }
+};
+
+struct Stats {
+    double maxErrorUs = 0;    // 外推误差最大值
+    double maxRatePpb = 0;    // 锁定后频率估计误差最大值
+};
+
+// 运行 count 次交换，每次交换前检查映射外推到当前时刻的误差
+Stats run(ClockEstimator &est, const SkewedClocks &clocks, Link &link,
+          double startUs, double intervalUs, int count, int settle) {
+    Stats stats;
+    double t = startUs;
+    for (int i = 0; i < count; i++) {
+        if (i >= settle) {
+            assert(est.isLocked());
+            // 上一次交换到现在已外推 intervalUs
+            double expect = clocks.master(t);
+            double got = static_cast<double>(
+                est.mapping().toMaster(static_cast<uint64_t>(t)));
+            double err = std::fabs(got - expect);
+            if (err > stats.maxErrorUs) stats.maxErrorUs = err;
+            double ratePpb = std::fabs(est.ratePpb() - clocks.skew * 1e9);
+            if (ratePpb > stats.maxRatePpb) stats.maxRatePpb = ratePpb;
+        }
+
+        double up = link.oneWay();
+        double down = link.oneWay();
+        uint64_t t1 = static_cast<uint64_t>(t);
+        uint64_t t2 = static_cast<uint64_t>(clocks.master(t + up));
+        uint64_t t3 = static_cast<uint64_t>(clocks.master(t + up + 20));
+        uint64_t t4 = static_cast<uint64_t>(t + up + 20 + down);
+        est.addExchange(t1, t2, t3, t4);
+        t += intervalUs;
+    }
+    return stats;
+}
+
+void testSkewTracking() {
+    const double skews[] = {-480e-6, -37e-6, 0, 12.5e-6, 250e-6};
+    for (double skew : skews) {
+        ClockEstimator est;
+        SkewedClocks clocks = {123456789.0, skew};
+        Link link = {std::mt19937(1), 150, 8, 10, 400};
+        Stats stats = run(est, clocks, link, 1e6, 500e3, 400, 8);
+        std::printf("skew %+8.1f ppm: max error %6.2f us, rate error %7.1f ppb\n",
+                    skew * 1e6, stats.maxErrorUs, stats.maxRatePpb);
+        assert(stats.maxErrorUs < 10);
+        assert(stats.maxRatePpb < 2000);
+    }
+}
+
+void testQueuedLink() {
+    // 单程抖动 20us，30% 的交换在单方向排队：外推 0.5s 的误差约 20us
+    ClockEstimator est;
+    SkewedClocks clocks = {1e6, 40e-6};
+    Link link = {std::mt19937(9), 150, 20, 30, 400};
+    Stats stats = run(est, clocks, link, 1e6, 500e3, 2000, 8);
+    std::printf("queued link:     max error %6.2f us, rate error %7.1f ppb\n",
+                stats.maxErrorUs, stats.maxRatePpb);
+    assert(stats.maxErrorUs < 30);
+    assert(stats.maxRatePpb < 5000);
+}
+
+void testSymmetricLinkIsTight() {
+    // 无排队、小抖动时应逼近定点截断误差
+    ClockEstimator est;
+    SkewedClocks clocks = {-5000000.0, 41e-6};
+    Link link = {std::mt19937(2), 80, 1, 0, 0};
+    Stats stats = run(est, clocks, link, 5e6, 250e3, 200, 8);
+    assert(stats.maxErrorUs < 3);
+    assert(stats.maxRatePpb < 2000);
+}
+
+void testRateClamp() {
+    // 超出晶振容差的频偏被限制在 maxRatePpm
+    ClockEstimator::Config cfg;
+    cfg.maxRatePpm = 100;
+    ClockEstimator est(cfg);
+    SkewedClocks clocks = {0, 300e-6};
+    Link link = {std::mt19937(3), 100, 0, 0, 0};
+    run(est, clocks, link, 1e6, 100e3, 16, 16);
+    assert(est.ratePpb() == 100000);
+}
+
+void testToLocalInvertsToMaster() {
+    ClockMapping m;
+    m.localRef = 1000000000ULL;
+    m.offset = -987654321;
+    m.rateQ32 = static_cast<int32_t>(std::llround(500e-6 * 4294967296.0));
+
+    // 一小时范围内往返误差不超过定点截断
+    for (int64_t dx = -3600000000LL; dx <= 3600000000LL; dx += 60000000LL) {
+        uint64_t local = m.localRef + dx;
+        uint64_t back = m.toLocal(m.toMaster(local));
+        int64_t err = static_cast<int64_t>(back - local);
+        assert(err >= -2 && err <= 2);
+    }
+}
+
+void testStepAndReject() {
+    ClockEstimator est;
+    SkewedClocks clocks = {1000.0, 20e-6};
+    Link link = {std::mt19937(4), 100, 2, 0, 0};
+    run(est, clocks, link, 1e6, 500e3, 10, 10);
+    assert(est.isLocked());
+
+    // 时间戳顺序错误
+    assert(est.addExchange(100, 50, 40, 200) ==
+           ClockEstimator::Result::INVALID);
+
+    // 往返延迟远大于最小值的样本被丢弃
+    double t = 20e6;
+    uint64_t t1 = static_cast<uint64_t>(t);
+    uint64_t t2 = static_cast<uint64_t>(clocks.master(t + 5000));
+    uint64_t t4 = static_cast<uint64_t>(t + 5100);
+    assert(est.addExchange(t1, t2, t2, t4) ==
+           ClockEstimator::Result::REJECTED_DELAY);
+    assert(est.isLocked());
+
+    // 主机时钟跳变：重置窗口，映射直接对齐新样本
+    clocks.offsetUs += 50000;
+    t1 = static_cast<uint64_t>(t);
+    t2 = static_cast<uint64_t>(clocks.master(t + 100));
+    t4 = static_cast<uint64_t>(t + 200);
+    assert(est.addExchange(t1, t2, t2, t4) == ClockEstimator::Result::STEPPED);
+    assert(!est.isLocked());
+    double err = std::fabs(
+        static_cast<double>(est.mapping().toMaster(t1 + 100)) -
+        clocks.master(t + 100));
+    assert(err < 3);
+}
+
+}    // namespace
+
+int main() {
+    testSkewTracking();
+    testQueuedLink();
+    testSymmetricLinkIsTight();
+    testRateClamp();
+    testToLocalInvertsToMaster();
+    testStepAndReject();
+    std::printf("clock_estimator_test: OK\n");
+    return 0;
+}
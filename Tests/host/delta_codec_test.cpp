@@ -0,0 +1,169 @@
+// DeltaCodec 编解码往返测试：KEY/DELTA、退回 KEY、尺寸与基准序号不符
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "DeltaCodec.h"
+
+using Adapter::BitMatrix64;
+using Adapter::DeltaCodec;
+
+using FrameType = DeltaCodec::FrameType;
+
+static bool sameMatrix(const BitMatrix64 &a, const BitMatrix64 &b) {
+    if (a.rows() != b.rows() || a.cols() != b.cols()) return false;
+    for (uint8_t r = 0; r < a.rows(); r++) {
+        if (a.rowWord(r) != b.rowWord(r)) return false;
+    }
+    return true;
+}
+
+static BitMatrix64 randomMatrix(uint8_t rows, uint8_t cols, uint32_t seed) {
+    std::mt19937 rng(seed);
+    BitMatrix64 m;
+    m.reset(rows, cols);
+    for (uint8_t r = 0; r < rows; r++) {
+        for (uint8_t c = 0; c < cols; c++) {
+            if (rng() & 1) m.flip(r, c);
+        }
+    }
+    return m;
+}
+
+static std::vector<uint8_t> encode(const BitMatrix64 *prev,
+                                   uint32_t prevSequence,
+                                   const BitMatrix64 &cur, uint32_t sequence) {
+    std::vector<uint8_t> out(DeltaCodec::maxEncodedSize(cur));
+    size_t n = DeltaCodec::encode(prev, prevSequence, cur, sequence, out.data(),
+                                  out.size());
+    assert(n != 0);
+    out.resize(n);
+    return out;
+}
+
+static void testKeyRoundTrip() {
+    BitMatrix64 cur = randomMatrix(12, 40, 1);
+    std::vector<uint8_t> data = encode(nullptr, 0, cur, 300);
+    assert(data[0] == static_cast<uint8_t>(FrameType::KEY));
+    assert(data.size() <= DeltaCodec::maxEncodedSize(cur));
+
+    // KEY 帧不依赖解码端已有内容和序号
+    BitMatrix64 frame;
+    uint32_t seq = 12345;
+    FrameType type = FrameType::DELTA;
+    assert(DeltaCodec::decode(data.data(), data.size(), frame, seq, &type));
+    assert(type == FrameType::KEY && seq == 300);
+    assert(sameMatrix(frame, cur));
+
+    // 缓冲区不足
+    uint8_t small[4];
+    assert(DeltaCodec::encode(nullptr, 0, cur, 300, small, sizeof(small)) == 0);
+}
+
+static void testDeltaRoundTrip() {
+    BitMatrix64 prev = randomMatrix(64, 64, 2);
+    BitMatrix64 cur = prev;
+    cur.flip(0, 0);
+    cur.flip(0, 63);
+    cur.flip(31, 17);
+    cur.flip(63, 63);
+
+    std::vector<uint8_t> data = encode(&prev, 41, cur, 42);
+    assert(data[0] == static_cast<uint8_t>(FrameType::DELTA));
+    assert(data.size() < cur.packedSize());
+
+    BitMatrix64 frame = prev;
+    uint32_t seq = 41;
+    FrameType type = FrameType::KEY;
+    assert(DeltaCodec::decode(data.data(), data.size(), frame, seq, &type));
+    assert(type == FrameType::DELTA && seq == 42);
+    assert(sameMatrix(frame, cur));
+
+    // 与上一帧相同：只有帧头
+    data = encode(&cur, 42, cur, 43);
+    assert(data[0] == static_cast<uint8_t>(FrameType::DELTA));
+    assert(data.size() <= 14);
+    assert(DeltaCodec::decode(data.data(), data.size(), frame, seq));
+    assert(seq == 43 && sameMatrix(frame, cur));
+
+    // 连续多帧链式解码
+    BitMatrix64 sender = cur;
+    for (uint32_t s = 44; s < 60; s++) {
+        BitMatrix64 next = sender;
+        next.flip(static_cast<uint8_t>(s % 64), static_cast<uint8_t>(s * 7 % 64));
+        data = encode(&sender, s - 1, next, s);
+        assert(DeltaCodec::decode(data.data(), data.size(), frame, seq));
+        assert(seq == s && sameMatrix(frame, next));
+        sender = next;
+    }
+}
+
+static void testFallbackToKey() {
+    // 差分比完整帧大时退回 KEY 帧
+    BitMatrix64 prev = randomMatrix(16, 16, 3);
+    BitMatrix64 cur = randomMatrix(16, 16, 4);
+    std::vector<uint8_t> data = encode(&prev, 7, cur, 8);
+    assert(data[0] == static_cast<uint8_t>(FrameType::KEY));
+    assert(data.size() <= DeltaCodec::maxEncodedSize(cur));
+
+    BitMatrix64 frame = prev;
+    uint32_t seq = 7;
+    assert(DeltaCodec::decode(data.data(), data.size(), frame, seq));
+    assert(seq == 8 && sameMatrix(frame, cur));
+
+    // 基准帧尺寸不同也输出 KEY 帧
+    BitMatrix64 other = randomMatrix(16, 15, 5);
+    data = encode(&other, 7, cur, 9);
+    assert(data[0] == static_cast<uint8_t>(FrameType::KEY));
+}
+
+static void testSizeMismatch() {
+    BitMatrix64 prev = randomMatrix(8, 8, 6);
+    BitMatrix64 cur = prev;
+    cur.flip(3, 3);
+    std::vector<uint8_t> data = encode(&prev, 1, cur, 2);
+    assert(data[0] == static_cast<uint8_t>(FrameType::DELTA));
+
+    // 解码端持有的帧尺寸不同：拒绝，帧和序号不变
+    BitMatrix64 frame = randomMatrix(8, 9, 7);
+    BitMatrix64 before = frame;
+    uint32_t seq = 1;
+    assert(!DeltaCodec::decode(data.data(), data.size(), frame, seq));
+    assert(seq == 1 && sameMatrix(frame, before));
+}
+
+static void testBaseSequenceMismatch() {
+    BitMatrix64 f1 = randomMatrix(10, 20, 8);
+    BitMatrix64 f2 = f1;
+    f2.flip(1, 2);
+    BitMatrix64 f3 = f2;
+    f3.flip(4, 5);
+
+    // 解码端只收到 f1，f2 丢失，随后收到相对 f2 的 DELTA：拒绝
+    std::vector<uint8_t> data = encode(&f2, 2, f3, 3);
+    BitMatrix64 frame = f1;
+    uint32_t seq = 1;
+    assert(!DeltaCodec::decode(data.data(), data.size(), frame, seq));
+    assert(seq == 1 && sameMatrix(frame, f1));
+
+    // 截断的数据同样拒绝且不改动帧
+    data = encode(&f1, 1, f3, 3);
+    for (size_t len = 0; len < data.size(); len++) {
+        assert(!DeltaCodec::decode(data.data(), len, frame, seq));
+        assert(seq == 1 && sameMatrix(frame, f1));
+    }
+    assert(DeltaCodec::decode(data.data(), data.size(), frame, seq));
+    assert(seq == 3 && sameMatrix(frame, f3));
+}
+
+int main() {
+    testKeyRoundTrip();
+    testDeltaRoundTrip();
+    testFallbackToKey();
+    testSizeMismatch();
+    testBaseSequenceMismatch();
+    std::printf("delta_codec_test: OK\n");
+    return 0;
+}
@@ -0,0 +1,200 @@
+// LogBinary 编码 → FileLogSink 写文件 → 读回解码，检查帧内容完整
+#include <cassert>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "FileLogSink.h"
+#include "LogBinary.h"
+
+namespace {
+
+const char *const PATH = "file_log_sink_test.bin";
+
+size_t encodeText(uint8_t *out, size_t capacity, uint8_t level,
+                  const char *tag, uint64_t ts, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    size_t n = LogBinaryEncoder::encode(out, capacity, level, tag, format, ts,
+                                        args);
+    va_end(args);
+    return n;
+}
+
+// 上位机解码器（Scripts/log_decoder.py）的最小子集：主机上字符串都内联
+struct Reader {
+    const uint8_t *pos;
+    const uint8_t *end;
+
+    uint8_t byte() {
+        assert(pos < end);
+        return *pos++;
+    }
+
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int shift = 0;; shift += 7) {
+            uint8_t b = byte();
+            v |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0) return v;
+        }
+    }
+
+    int64_t zigzag() {
+        uint64_t v = varint();
+        return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+    }
+
+    std::string string() {
+        size_t len = static_cast<size_t>(varint());
+        assert(static_cast<size_t>(end - pos) >= len);
+        std::string s(reinterpret_cast<const char *>(pos), len);
+        pos += len;
+        return s;
+    }
+
+    double f64() {
+        double v;
+        assert(end - pos >= 8);
+        memcpy(&v, pos, sizeof(v));
+        pos += sizeof(v);
+        return v;
+    }
+};
+
+// 拆分文件中的帧，校验同步字节、长度与 CRC，返回各帧负载
+std::vector<std::vector<uint8_t>> splitFrames(const std::vector<uint8_t> &file) {
+    std::vector<std::vector<uint8_t>> frames;
+    size_t i = 0;
+    while (i < file.size()) {
+        assert(file[i] == LogBinaryEncoder::SYNC);
+        assert(i + 2 <= file.size());
+        size_t len = file[i + 1];
+        assert(i + LogBinaryEncoder::OVERHEAD + len <= file.size());
+        assert(LogBinaryEncoder::crc8(&file[i + 1], len + 1) ==
+               file[i + 2 + len]);
+        frames.emplace_back(file.begin() + i + 2, file.begin() + i + 2 + len);
+        i += LogBinaryEncoder::OVERHEAD + len;
+    }
+    return frames;
+}
+
+std::vector<uint8_t> readFile() {
+    FILE *f = fopen(PATH, "rb");
+    assert(f != nullptr);
+    std::vector<uint8_t> data;
+    uint8_t buf[256];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) != 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(f);
+    return data;
+}
+
+void testRoundTrip() {
+    uint8_t frame[260];
+    {
+        FileLogSink sink(PATH);
+        assert(sink.isOpen());
+
+        size_t n = encodeText(frame, sizeof(frame), 3, "Collector",
+                              1234567890123ULL, "cycle %d pin %u: %s %.2f",
+                              -42, 4000000000U, "open", 2.5);
+        assert(n != 0);
+        sink.write(frame, n);
+
+        const uint8_t blob[] = {0xDE, 0xAD, 0xBE, 0xEF};
+        n = LogBinaryEncoder::encodeBlob(frame, sizeof(frame), 2, 77, blob,
+                                         sizeof(blob));
+        assert(n != 0);
+        sink.write(frame, n);
+
+        const uint8_t data[] = {1, 2, 3};
+        n = LogBinaryEncoder::encodeData(frame, sizeof(frame), 1,
+                                         LOG_DATA_TELEMETRY, 88, data,
+                                         sizeof(data));
+        assert(n != 0);
+        sink.write(frame, n);
+        sink.flush();
+    }
+
+    std::vector<std::vector<uint8_t>> frames = splitFrames(readFile());
+    assert(frames.size() == 3);
+
+    // 文本记录：标签、格式串内联，参数按格式串顺序
+    Reader r = {frames[0].data(), frames[0].data() + frames[0].size()};
+    uint8_t flags = r.byte();
+    assert((flags & LogBinaryEncoder::LEVEL_MASK) == 3);
+    assert(flags & LogBinaryEncoder::FLAG_TAG_INLINE);
+    assert(flags & LogBinaryEncoder::FLAG_FMT_INLINE);
+    assert((flags & LogBinaryEncoder::FLAG_TRUNCATED) == 0);
+    assert(r.string() == "Collector");
+    assert(r.varint() == 1234567890123ULL);
+    assert(r.string() == "cycle %d pin %u: %s %.2f");
+    assert(r.zigzag() == -42);
+    assert(r.varint() == 4000000000U);
+    assert(r.string() == "open");
+    assert(r.f64() == 2.5);
+    assert(r.pos == r.end);
+
+    // 数据块记录
+    r = {frames[1].data(), frames[1].data() + frames[1].size()};
+    flags = r.byte();
+    assert(flags == (2 | LogBinaryEncoder::FLAG_BLOB));
+    assert(r.varint() == 77);
+    assert(r.string() == std::string("\xDE\xAD\xBE\xEF", 4));
+    assert(r.pos == r.end);
+
+    // 结构化数据记录：数据为负载剩余部分
+    r = {frames[2].data(), frames[2].data() + frames[2].size()};
+    assert(r.byte() == (1 | LogBinaryEncoder::FLAG_DATA));
+    assert(r.byte() == LOG_DATA_TELEMETRY);
+    assert(r.varint() == 88);
+    assert(r.end - r.pos == 3 && r.pos[0] == 1 && r.pos[2] == 3);
+}
+
+void testAppendAndTruncation() {
+    uint8_t frame[64];
+    {
+        FileLogSink sink(PATH, true);
+        // 长字符串参数被截断，帧仍然完整可解码
+        std::string longText(200, 'x');
+        size_t n = encodeText(frame, sizeof(frame), 4, "T", 5, "%s",
+                              longText.c_str());
+        assert(n != 0 && n <= sizeof(frame));
+        sink.write(frame, n);
+    }
+
+    std::vector<std::vector<uint8_t>> frames = splitFrames(readFile());
+    assert(frames.size() == 4);
+    Reader r = {frames[3].data(), frames[3].data() + frames[3].size()};
+    uint8_t flags = r.byte();
+    assert(flags & LogBinaryEncoder::FLAG_TRUNCATED);
+    assert(r.string() == "T");
+    assert(r.varint() == 5);
+    assert(r.string() == "%s");
+    std::string text = r.string();
+    assert(!text.empty() && text.size() < 200);
+    assert(text.find_first_not_of('x') == std::string::npos);
+    assert(r.pos == r.end);
+
+    // 无法打开的路径：写入被忽略
+    FileLogSink bad("/nonexistent-dir/log.bin");
+    assert(!bad.isOpen());
+    bad.write(frame, 4);
+    bad.flush();
+}
+
+}    // namespace
+
+int main() {
+    testRoundTrip();
+    testAppendAndTruncation();
+    std::remove(PATH);
+    std::printf("file_log_sink_test: OK\n");
+    return 0;
+}
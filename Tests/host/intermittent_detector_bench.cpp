@@ -0,0 +1,94 @@
+// IntermittentDetector 主机基准：合成帧流，测量每帧更新耗时
+//
+// 用法：intermittent_detector_bench [帧数]
+// 每种场景输出每帧变化位数、ns/帧 与每秒可处理帧数；单帧耗时应随变化位数
+// 增长，而不是随矩阵尺寸增长，用于估算在 MCU 上能否跟上扫描速率。
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "IntermittentDetector.h"
+
+using Adapter::BitMatrix64;
+using Adapter::IntermittentDetector;
+
+namespace {
+
+struct Scenario {
+    const char *name;
+    uint8_t rows;
+    uint8_t cols;
+    uint32_t flipsPerFrame;    // 每帧随机翻转的位数
+};
+
+// 预先生成帧流，计时只包含 update()
+std::vector<BitMatrix64> makeStream(const Scenario &sc, size_t length,
+                                    uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> row(0, sc.rows - 1);
+    std::uniform_int_distribution<int> col(0, sc.cols - 1);
+
+    BitMatrix64 frame;
+    frame.reset(sc.rows, sc.cols);
+    // 对角线导通作为基准（每个驱动周期连到自身引脚）
+    for (uint8_t r = 0; r < sc.rows && r < sc.cols; r++) {
+        frame.set(r, r, Adapter::ContinuityState::CONNECTED);
+    }
+
+    std::vector<BitMatrix64> stream(length);
+    for (size_t i = 0; i < length; i++) {
+        for (uint32_t f = 0; f < sc.flipsPerFrame; f++) {
+            frame.flip(static_cast<uint8_t>(row(rng)),
+                       static_cast<uint8_t>(col(rng)));
+        }
+        stream[i] = frame;
+    }
+    return stream;
+}
+
+void runScenario(const Scenario &sc, size_t frames) {
+    // 帧流循环使用，避免生成过大的数据集
+    const size_t streamLen = 1024;
+    std::vector<BitMatrix64> stream = makeStream(sc, streamLen, 42);
+
+    IntermittentDetector det;
+    det.init(sc.rows, sc.cols);
+
+    uint64_t changed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < frames; i++) {
+        changed += det.update(stream[i % streamLen], i * 1000ULL);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    double perFrame = ns / frames;
+    std::printf("%-22s %2ux%-2u %6.1f bits/frame %9.1f ns/frame %12.0f frames/s"
+                "  flaky=%u\n",
+                sc.name, sc.rows, sc.cols,
+                static_cast<double>(changed) / frames, perFrame,
+                1e9 / perFrame, det.flakyCount());
+}
+
+}    // namespace
+
+int main(int argc, char **argv) {
+    size_t frames = 200000;
+    if (argc > 1) frames = std::strtoul(argv[1], nullptr, 10);
+    if (frames == 0) frames = 1;
+
+    const Scenario scenarios[] = {
+        {"static", 64, 64, 0},
+        {"few flaky contacts", 64, 64, 2},
+        {"noisy harness", 64, 64, 32},
+        {"very noisy harness", 64, 64, 256},
+        {"small harness", 16, 16, 2},
+    };
+    for (const Scenario &sc : scenarios) {
+        runScenario(sc, frames);
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+// IntermittentDetector 统计与标记测试
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+
+#include "IntermittentDetector.h"
+
+using Adapter::BitMatrix64;
+using Adapter::ContinuityState;
+using Adapter::IntermittentDetector;
+
+static void setPair(BitMatrix64 &frame, uint8_t cycle, uint8_t pin, bool on) {
+    frame.set(cycle, pin,
+              on ? ContinuityState::CONNECTED : ContinuityState::DISCONNECTED);
+}
+
+static void testStatistics() {
+    IntermittentDetector det;
+    assert(det.init(4, 8, IntermittentDetector::Config(2, 50, 8)));
+
+    BitMatrix64 frame;
+    frame.reset(4, 8);
+    setPair(frame, 1, 3, true);
+
+    // 帧序列（1,3）：1 1 0 0 0 1，时间戳 1ms 递增
+    const bool states[] = {true, true, false, false, false, true};
+    uint32_t changed = 0;
+    for (int i = 0; i < 6; i++) {
+        setPair(frame, 1, 3, states[i]);
+        changed += det.update(frame, (i + 1) * 1000ULL);
+    }
+    assert(det.frameCount() == 6);
+    assert(changed == 2);
+
+    IntermittentDetector::PairReport report;
+    assert(det.getPair(1, 3, report));
+    assert(report.connected);
+    assert(report.flips == 2);
+    assert(report.longestStableRun == 3);
+    assert(report.firstSeenMs == 1);
+    assert(report.lastSeenMs == 6);
+
+    // 从未导通的引脚对
+    assert(det.getPair(0, 0, report));
+    assert(report.flips == 0 && report.firstSeenMs == 0);
+    assert(report.longestStableRun == 6);
+
+    // 尺寸不符的帧被忽略
+    BitMatrix64 wrong;
+    wrong.reset(4, 9);
+    assert(det.update(wrong, 7000) == 0 && det.frameCount() == 6);
+}
+
+static void testFlagAfterMinFrames() {
+    // 翻转发生在 minFrames 之前、之后不再翻转：第 minFrames 帧补判
+    IntermittentDetector det;
+    det.init(2, 2, IntermittentDetector::Config(2, 200, 8));
+
+    BitMatrix64 frame;
+    frame.reset(2, 2);
+    const bool states[] = {false, true, false, true, true, true, true, true};
+    for (int i = 0; i < 8; i++) {
+        setPair(frame, 0, 1, states[i]);
+        det.update(frame, i * 1000ULL);
+        // 未满 minFrames 不标记
+        if (i < 7) assert(!det.isFlaky(0, 1));
+    }
+    // 3 次翻转 / 8 帧 = 375‰ >= 200‰
+    assert(det.isFlaky(0, 1));
+    assert(det.flakyCount() == 1);
+
+    IntermittentDetector::PairReport out[4];
+    assert(det.getFlakyPairs(out, 4) == 1);
+    assert(out[0].cycle == 0 && out[0].pin == 1 && out[0].flaky);
+
+    // 标记保持到 reset
+    for (int i = 0; i < 100; i++) det.update(frame, (8 + i) * 1000ULL);
+    assert(det.isFlaky(0, 1));
+    det.reset();
+    assert(!det.isFlaky(0, 1) && det.flakyCount() == 0);
+}
+
+static void testBelowRateNotFlagged() {
+    IntermittentDetector det;
+    det.init(1, 4, IntermittentDetector::Config(2, 100, 4));
+
+    BitMatrix64 frame;
+    frame.reset(1, 4);
+    // 每 20 帧翻转一次：50‰ < 100‰
+    for (int i = 0; i < 200; i++) {
+        setPair(frame, 0, 2, (i / 20) % 2 != 0);
+        det.update(frame, i * 1000ULL);
+    }
+    assert(!det.isFlaky(0, 2));
+
+    // 之后连续翻转，翻转率超过阈值时标记
+    for (int i = 0; i < 40; i++) {
+        setPair(frame, 0, 2, i % 2 != 0);
+        det.update(frame, (200 + i) * 1000ULL);
+    }
+    assert(det.isFlaky(0, 2));
+}
+
+int main() {
+    testStatistics();
+    testFlagAfterMinFrames();
+    testBelowRateNotFlagged();
+    std::printf("intermittent_detector_test: OK\n");
+    return 0;
+}
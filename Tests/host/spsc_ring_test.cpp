@@ -0,0 +1,166 @@
+// SpscRing 单线程边界测试与双线程压力测试
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+#include "hal_ring_buffer.hpp"
+
+// 伪随机序列，生产者与消费者各自独立生成，用于校验数据内容
+static inline uint8_t patternByte(uint64_t index) {
+    uint64_t x = index * 0x9E3779B97F4A7C15ULL;
+    return static_cast<uint8_t>(x >> 56);
+}
+
+// 简单的线程内随机数（每个线程各有一份，避免共享状态）
+struct XorShift {
+    uint32_t state;
+    uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+};
+
+static void testSingleThread() {
+    SpscRing<uint8_t, 8> ring;
+    assert(ring.empty() && ring.free() == 8);
+
+    uint8_t data[16];
+    for (int i = 0; i < 16; i++) data[i] = static_cast<uint8_t>(i);
+
+    // 写满后拒绝继续写入，满/空不需要预留空位
+    assert(ring.write(data, 16) == 8);
+    assert(ring.full() && !ring.push(0xAA));
+
+    uint8_t out[16] = {};
+    assert(ring.read(out, 5) == 5);
+    for (int i = 0; i < 5; i++) assert(out[i] == i);
+
+    // 回绕写入：连续区段只到缓冲末尾
+    assert(ring.write(data + 8, 5) == 5);
+    SpscRing<uint8_t, 8>::Span span = ring.readSpan();
+    assert(span.len == 3 && span.data[0] == 5);
+    ring.commitRead(span.len);
+    span = ring.readSpan();
+    assert(span.len == 5 && span.data[0] == 8);
+    ring.commitRead(span.len);
+    assert(ring.empty());
+
+    span = ring.writeSpan();
+    assert(span.len == 3);    // head 位于偏移 5
+    span.data[0] = 0x11;
+    ring.commitWrite(1);
+    uint8_t v = 0;
+    assert(ring.pop(v) && v == 0x11 && !ring.pop(v));
+
+    ring.write(data, 4);
+    ring.clear();
+    assert(ring.empty());
+}
+
+// 生产者和消费者交替使用三种接口，覆盖所有回绕组合
+template <size_t N>
+static void stress(uint64_t total) {
+    static SpscRing<uint8_t, N> ring;
+
+    std::thread producer([&] {
+        XorShift rng = {0x12345678};
+        uint8_t chunk[97];
+        uint64_t sent = 0;
+        while (sent < total) {
+            uint32_t mode = rng.next() % 3;
+            size_t want = 1 + rng.next() % sizeof(chunk);
+            if (want > total - sent) want = static_cast<size_t>(total - sent);
+
+            size_t done = 0;
+            if (mode == 0) {
+                done = ring.push(patternByte(sent)) ? 1 : 0;
+            } else if (mode == 1) {
+                for (size_t i = 0; i < want; i++) {
+                    chunk[i] = patternByte(sent + i);
+                }
+                done = ring.write(chunk, want);
+            } else {
+                typename SpscRing<uint8_t, N>::Span span = ring.writeSpan();
+                done = span.len < want ? span.len : want;
+                for (size_t i = 0; i < done; i++) {
+                    span.data[i] = patternByte(sent + i);
+                }
+                ring.commitWrite(done);
+            }
+            sent += done;
+            if (done == 0) std::this_thread::yield();
+        }
+    });
+
+    XorShift rng = {0x9ABCDEF0};
+    uint8_t chunk[131];
+    uint64_t received = 0;
+    while (received < total) {
+        uint32_t mode = rng.next() % 3;
+        size_t done = 0;
+        if (mode == 0) {
+            uint8_t value;
+            if (ring.pop(value)) {
+                assert(value == patternByte(received));
+                done = 1;
+            }
+        } else if (mode == 1) {
+            size_t want = 1 + rng.next() % sizeof(chunk);
+            done = ring.read(chunk, want);
+            for (size_t i = 0; i < done; i++) {
+                assert(chunk[i] == patternByte(received + i));
+            }
+        } else {
+            typename SpscRing<uint8_t, N>::Span span = ring.readSpan();
+            for (size_t i = 0; i < span.len; i++) {
+                assert(span.data[i] == patternByte(received + i));
+            }
+            done = span.len;
+            ring.commitRead(done);
+        }
+        assert(ring.size() <= N);
+        received += done;
+        if (done == 0) std::this_thread::yield();
+    }
+
+    producer.join();
+    assert(ring.empty());
+}
+
+// 非字节元素：逐个传递递增序号
+static void stressWords(uint32_t total) {
+    static SpscRing<uint32_t, 64> ring;
+
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < total;) {
+            if (ring.push(i)) {
+                i++;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expect = 0;
+    uint32_t buf[40];
+    while (expect < total) {
+        size_t n = ring.read(buf, sizeof(buf) / sizeof(buf[0]));
+        for (size_t i = 0; i < n; i++) {
+            assert(buf[i] == expect++);
+        }
+        if (n == 0) std::this_thread::yield();
+    }
+    producer.join();
+}
+
+int main() {
+    testSingleThread();
+    stress<16>(4000000);
+    stress<1024>(32000000);
+    stressWords(4000000);
+    std::printf("spsc_ring_test: OK\n");
+    return 0;
+}
@@ -0,0 +1,120 @@
+// TimedScanEngine 仿真测试：VirtualGpio + SimulatedScanTimer，检查周期时序
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+
+#include "TimedScanEngine.h"
+#include "VirtualGpio.h"
+
+using Adapter::IScanSignal;
+using Adapter::IScanTimer;
+using Adapter::SimulatedScanSignal;
+using Adapter::SimulatedScanTimer;
+using Adapter::TimedScanEngine;
+using Adapter::VirtualGpio;
+
+namespace {
+
+struct Bench {
+    VirtualGpio gpio;
+    SimulatedScanTimer *timer;
+    SimulatedScanSignal *signal;
+    std::unique_ptr<TimedScanEngine> engine;
+
+    Bench() {
+        std::unique_ptr<SimulatedScanTimer> t =
+            std::make_unique<SimulatedScanTimer>();
+        std::unique_ptr<SimulatedScanSignal> s =
+            std::make_unique<SimulatedScanSignal>(t.get());
+        timer = t.get();
+        signal = s.get();
+        engine = std::make_unique<TimedScanEngine>(&gpio, std::move(t),
+                                                   std::move(s));
+    }
+};
+
+void testCycleTiming() {
+    Bench b;
+    // 起点不在 0，检查采样时刻相对启动时间计算
+    b.timer->advanceUs(1234);
+
+    // 端口 0 依次驱动引脚 0..4，第 2 周期空闲，第 4 周期在端口 1
+    const TimedScanEngine::ScanStep steps[] = {
+        {0, 0x0001}, {0, 0x0002}, {0, 0}, {0, 0x0008}, {1, 0x0010}};
+    const uint8_t cycles = 5;
+    const uint32_t periodUs = 500;
+    const uint32_t settleUs = 120;
+
+    uint32_t startUs = b.timer->nowUs();
+    assert(b.engine->start(steps, cycles, 2, periodUs, settleUs));
+    assert(b.engine->isRunning());
+    // 第一个周期在启动时已驱动
+    assert(b.gpio.read(0) == GpioState::HIGH);
+
+    assert(b.engine->waitForCompletion(100));
+    assert(b.engine->isComplete() && !b.engine->isRunning());
+    assert(b.engine->capturedCycles() == cycles);
+    assert(b.signal->notifyCount() == 1);
+    assert(b.timer->compareCount() == cycles);
+    assert(!b.timer->isRunning());
+
+    for (uint8_t c = 0; c < cycles; c++) {
+        // 第 c 周期在启动后 c*period + settle 采样
+        assert(b.engine->captureTimeUs(c) - startUs ==
+               c * periodUs + settleUs);
+        const TimedScanEngine::ScanStep &s = steps[c];
+        if (s.mask != 0) {
+            assert((b.engine->capture(c)[s.port] & s.mask) == s.mask);
+        }
+    }
+    // 最后一个驱动引脚在完成时释放为输入（输入引脚不可写）
+    assert(!b.gpio.write(16 + 4, GpioState::HIGH));
+}
+
+void testTimeoutAndStop() {
+    Bench b;
+    TimedScanEngine::ScanStep steps[8];
+    for (uint8_t c = 0; c < 8; c++) {
+        steps[c] = {0, static_cast<uint16_t>(1U << c)};
+    }
+    // 8 个周期共 8ms，只等 3ms：超时返回，已采样 3 个周期
+    assert(b.engine->start(steps, 8, 1, 1000, 200));
+    assert(!b.engine->waitForCompletion(3));
+    assert(b.engine->isRunning());
+    assert(b.engine->capturedCycles() == 3);
+    assert(b.timer->nowUs() == 3000);
+
+    // 停止后等待立即返回，不推进时间
+    b.engine->stop();
+    assert(!b.engine->waitForCompletion(100));
+    assert(b.timer->nowUs() == 3000);
+    assert(b.signal->notifyCount() == 0);
+
+    // 停止后可以重新启动
+    assert(b.engine->start(steps, 2, 1, 1000, 200));
+    assert(b.engine->waitForCompletion(10));
+    assert(b.engine->captureTimeUs(1) == 3000 + 1000 + 200);
+}
+
+void testRejectsBadArguments() {
+    Bench b;
+    TimedScanEngine::ScanStep step = {0, 1};
+    assert(!b.engine->start(nullptr, 1, 1, 1000, 200));
+    assert(!b.engine->start(&step, 0, 1, 1000, 200));
+    assert(!b.engine->start(&step, 1, 0, 1000, 200));
+    // 稳定时间不小于周期：定时器拒绝启动，驱动引脚被释放
+    assert(!b.engine->start(&step, 1, 1, 200, 200));
+    assert(!b.engine->isRunning());
+    assert(!b.gpio.write(0, GpioState::HIGH));
+}
+
+}    // namespace
+
+int main() {
+    testCycleTiming();
+    testTimeoutAndStop();
+    testRejectsBadArguments();
+    std::printf("timed_scan_engine_test: OK\n");
+    return 0;
+}